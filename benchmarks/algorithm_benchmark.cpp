@@ -0,0 +1,66 @@
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/algorithm.hpp>
+#include <ufo/math/thread_pool.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NUM_POINTS = 10'000'000;
+
+std::vector<ufo::Vec3f> randomPoints(std::size_t n)
+{
+	std::mt19937                          gen(1337);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	std::vector<ufo::Vec3f> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(dist(gen), dist(gen), dist(gen));
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[Algorithm] Reductions over 10M points")
+{
+	auto const       points = randomPoints(NUM_POINTS);
+	ufo::ThreadPool& pool   = ufo::ThreadPool::global();
+
+	BENCHMARK("Centroid sequential")
+	{
+		return ufo::centroid(points.begin(), points.end());
+	};
+
+	BENCHMARK("Centroid OpenMP")
+	{
+		return ufo::centroid(ufo::execution::omp::par, points.begin(), points.end());
+	};
+
+	BENCHMARK("Centroid ThreadPool")
+	{
+		return ufo::centroid(pool.policy(), points.begin(), points.end());
+	};
+
+	BENCHMARK("Minmax sequential") { return ufo::minmax(points.begin(), points.end()); };
+
+	BENCHMARK("Minmax ThreadPool")
+	{
+		return ufo::minmax(pool.policy(), points.begin(), points.end());
+	};
+
+	BENCHMARK("CountIf ThreadPool")
+	{
+		return ufo::countIf(pool.policy(), points.begin(), points.end(),
+		                    [](ufo::Vec3f const& p) { return 0.0f < p.z; });
+	};
+}
@@ -0,0 +1,67 @@
+// UFO
+#include <ufo/math/array_file.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NUM_POINTS = 10'000'000;
+
+std::vector<ufo::Vec3f> randomPoints(std::size_t n, unsigned seed)
+{
+	std::mt19937                          gen(seed);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	std::vector<ufo::Vec3f> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(dist(gen), dist(gen), dist(gen));
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[ArrayFile] Load 10M points")
+{
+	auto const path = std::filesystem::temp_directory_path() / "ufomath_benchmark.ufoa";
+	ufo::writeArray(path, randomPoints(NUM_POINTS, 1));
+
+	// What an ad-hoc dump loader does
+	BENCHMARK("Read into a vector")
+	{
+		std::ifstream           file(path, std::ios::binary);
+		std::vector<ufo::Vec3f> points(NUM_POINTS);
+		file.seekg(ufo::ArrayHeader::ALIGNMENT);
+		file.read(reinterpret_cast<char*>(points.data()),
+		          static_cast<std::streamsize>(points.size() * sizeof(ufo::Vec3f)));
+		return points.back();
+	};
+
+	BENCHMARK("Map")
+	{
+		ufo::MappedArray const a(path);
+		return a.span<ufo::Vec3f>().size();
+	};
+
+	BENCHMARK("Map and touch every point")
+	{
+		ufo::MappedArray const a(path);
+		ufo::Vec3f             sum{};
+		for (auto const& p : a.span<ufo::Vec3f>()) {
+			sum += p;
+		}
+		return sum;
+	};
+
+	std::filesystem::remove(path);
+}
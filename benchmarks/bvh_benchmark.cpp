@@ -0,0 +1,116 @@
+// UFO
+#include <ufo/math/bvh.hpp>
+#include <ufo/math/numbers.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Height field of (2 * 708 * 708 ~ 1M) triangles over a 100 m x 100 m area
+std::vector<ufo::Trianglef> terrain(std::size_t side)
+{
+	auto height = [](float x, float y) {
+		return 2.0f * std::sin(0.1f * x) * std::cos(0.13f * y) + 0.3f * std::sin(x * y * 0.01f);
+	};
+
+	float const step = 100.0f / static_cast<float>(side);
+
+	std::vector<ufo::Trianglef> tris;
+	tris.reserve(2 * side * side);
+	for (std::size_t i{}; side > i; ++i) {
+		for (std::size_t j{}; side > j; ++j) {
+			float      x0 = static_cast<float>(i) * step - 50.0f;
+			float      y0 = static_cast<float>(j) * step - 50.0f;
+			float      x1 = x0 + step;
+			float      y1 = y0 + step;
+			ufo::Vec3f a(x0, y0, height(x0, y0));
+			ufo::Vec3f b(x1, y0, height(x1, y0));
+			ufo::Vec3f c(x1, y1, height(x1, y1));
+			ufo::Vec3f d(x0, y1, height(x0, y1));
+			tris.emplace_back(a, b, c);
+			tris.emplace_back(a, c, d);
+		}
+	}
+	return tris;
+}
+
+// Rotating LiDAR at 2 m height: 64 beams by 2048 azimuth steps, ordered beam by beam
+std::vector<ufo::Rayf> scan()
+{
+	std::vector<ufo::Rayf> rays;
+	for (std::size_t b{}; 64 > b; ++b) {
+		float elevation = ufo::radians(-25.0f + 27.0f * static_cast<float>(b) / 63.0f);
+		for (std::size_t a{}; 2048 > a; ++a) {
+			float azimuth = 2.0f * ufo::numbers::pi_v<float> * static_cast<float>(a) / 2048.0f;
+			rays.emplace_back(ufo::Vec3f(0, 0, 5),
+			                  ufo::Vec3f(std::cos(elevation) * std::cos(azimuth),
+			                             std::cos(elevation) * std::sin(azimuth),
+			                             std::sin(elevation)));
+		}
+	}
+	return rays;
+}
+}  // namespace
+
+TEST_CASE("[BVH] 1M triangles")
+{
+	auto const tris = terrain(708);
+	auto const rays = scan();
+
+	BENCHMARK("Build") { return ufo::BVH<ufo::Trianglef>(tris.begin(), tris.end()); };
+
+	BENCHMARK("Build par")
+	{
+		return ufo::BVH<ufo::Trianglef>(ufo::execution::par, tris.begin(), tris.end());
+	};
+
+	ufo::BVH<ufo::Trianglef> bvh(ufo::execution::par, tris.begin(), tris.end());
+	std::vector<ufo::RayHit<float>> hits(rays.size());
+
+	BENCHMARK("Single rays")
+	{
+		for (std::size_t i{}; rays.size() > i; ++i) {
+			hits[i] = bvh.intersect(rays[i]);
+		}
+		return hits.back().distance;
+	};
+
+	BENCHMARK("Packets")
+	{
+		return ufo::intersect(bvh, rays.begin(), rays.end(), hits.begin());
+	};
+
+	BENCHMARK("Packets par")
+	{
+		return ufo::intersect(ufo::execution::par, bvh, rays.begin(), rays.end(),
+		                      hits.begin());
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	ufo::intersect(bvh, rays.begin(), rays.end(), hits.begin());
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	std::cout << tris.size() << " triangles, " << bvh.nodes().size() << " nodes, "
+	          << static_cast<double>(rays.size()) / elapsed.count() / 1e6
+	          << " million rays per second (packets, one thread)\n";
+
+	std::vector<ufo::Vec3f> queries;
+	for (std::size_t i{}; 100'000 > i; ++i) {
+		queries.push_back(rays[i % rays.size()](10.0f));
+	}
+	std::vector<ufo::NearestHit<float>> closest(queries.size());
+
+	BENCHMARK("Closest point")
+	{
+		return ufo::nearest(bvh, queries.begin(), queries.end(), closest.begin());
+	};
+}
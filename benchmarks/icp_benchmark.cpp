@@ -0,0 +1,111 @@
+// UFO
+#include <ufo/math/icp.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Street corridor: ground, two facades and rows of poles, with normals
+void street(std::size_t n, unsigned seed, std::vector<ufo::Vec3f>& points,
+            std::vector<ufo::Vec3f>& normals)
+{
+	std::mt19937                          gen(seed);
+	std::uniform_real_distribution<float> along(-40.0f, 40.0f);
+	std::uniform_real_distribution<float> across(-8.0f, 8.0f);
+	std::uniform_real_distribution<float> up(0.0f, 12.0f);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+	for (std::size_t i{}; n > i; ++i) {
+		float const x = along(gen);
+		switch (i % 4) {
+			case 0:
+				points.emplace_back(x, across(gen), 0.0f);
+				normals.emplace_back(0.0f, 0.0f, 1.0f);
+				break;
+			case 1:
+				points.emplace_back(x, 8.0f, up(gen));
+				normals.emplace_back(0.0f, -1.0f, 0.0f);
+				break;
+			case 2:
+				points.emplace_back(x, -8.0f, up(gen));
+				normals.emplace_back(0.0f, 1.0f, 0.0f);
+				break;
+			default: {
+				// Poles of radius 0.2 m every 10 m on both sides
+				float const a = angle(gen);
+				float const c = 10.0f * std::round(x / 10.0f);
+				float const s = 0 == (i / 4) % 2 ? 6.0f : -6.0f;
+				points.emplace_back(c + 0.2f * std::cos(a), s + 0.2f * std::sin(a), up(gen) / 2);
+				normals.emplace_back(std::cos(a), std::sin(a), 0.0f);
+			}
+		}
+	}
+}
+}  // namespace
+
+TEST_CASE("[ICP] 30k point scan against a 300k point map")
+{
+	std::vector<ufo::Vec3f> map, map_normals;
+	street(300'000, 71, map, map_normals);
+	ufo::KDTree<3> tree(ufo::execution::par, map.begin(), map.end());
+
+	// In sweep order, as a spinning LiDAR delivers it
+	std::vector<ufo::Vec3f> scan, scan_normals;
+	street(30'000, 72, scan, scan_normals);
+	std::sort(scan.begin(), scan.end(), [](ufo::Vec3f const& a, ufo::Vec3f const& b) {
+		return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
+	});
+	ufo::Transform3f const motion(ufo::angleAxis(0.02f, ufo::Vec3f(0, 0, 1)),
+	                              ufo::Vec3f(0.3f, 0.05f, 0.02f));
+	for (auto& p : scan) {
+		p = motion(p);
+	}
+
+	ufo::IcpParams<float> params;
+	params.max_correspondence_distance = 1.0f;
+	params.kernel_scale                = 0.1f;
+
+	BENCHMARK("Normal equations")
+	{
+		return ufo::pointToPlaneEquations(ufo::Transform3f(), scan.begin(), scan.end(), tree,
+		                                  map_normals.begin(), params);
+	};
+
+	BENCHMARK("Normal equations par")
+	{
+		return ufo::pointToPlaneEquations(ufo::execution::par, ufo::Transform3f(),
+		                                  scan.begin(), scan.end(), tree, map_normals.begin(),
+		                                  params);
+	};
+
+	BENCHMARK("ICP")
+	{
+		return ufo::icp(scan.begin(), scan.end(), tree, map_normals.begin(),
+		                ufo::Transform3f(), params);
+	};
+
+	BENCHMARK("ICP par")
+	{
+		return ufo::icp(ufo::execution::par, scan.begin(), scan.end(), tree,
+		                map_normals.begin(), ufo::Transform3f(), params);
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	auto res = ufo::icp(ufo::execution::par, scan.begin(), scan.end(), tree,
+	                    map_normals.begin(), ufo::Transform3f(), params);
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	std::cout << res.iterations << " iterations in " << elapsed.count() << " ms, "
+	          << res.correspondences << " correspondences, rmse " << res.rmse
+	          << ", translation " << res.transform.translation << '\n';
+}
@@ -0,0 +1,87 @@
+// UFO
+#include <ufo/math/pipeline.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NUM_POINTS = 1'000'000;
+
+std::vector<ufo::Vec3f> randomPoints(std::size_t n, unsigned seed)
+{
+	std::mt19937                          gen(seed);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	std::vector<ufo::Vec3f> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(dist(gen), dist(gen), dist(gen));
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[Pipeline] Deskew, transform, filter and integrate 1M points")
+{
+	auto const scan = randomPoints(NUM_POINTS, 1);
+
+	ufo::Transform3f const deskew(ufo::Mat3f(1, 0, 0, 0, 1, 0, 0, 0, 1),
+	                              ufo::Vec3f(0.01f, 0.0f, 0.0f));
+	ufo::Transform3f const pose(ufo::Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1),
+	                            ufo::Vec3f(1, 2, 3));
+
+	auto const keep = [](ufo::Vec3f const& p) { return 50.0f > p.z; };
+
+	// Every stage over the whole scan before the next one starts
+	BENCHMARK("Whole scan")
+	{
+		auto points = ufo::transform(deskew, scan);
+		ufo::transformInPlace(pose, points);
+		points.erase(std::remove_if(points.begin(), points.end(),
+		                            [keep](auto const& p) { return !keep(p); }),
+		             points.end());
+		ufo::Vec3f sum{};
+		for (auto const& p : points) {
+			sum += p;
+		}
+		return sum;
+	};
+
+	BENCHMARK("Chunked")
+	{
+		ufo::Vec3f sum{};
+		for (std::span<ufo::Vec3f> chunk : ufo::filterChunks(
+		         ufo::transformChunks(pose, ufo::transformChunks(deskew, ufo::chunks(scan))),
+		         keep)) {
+			for (auto const& p : chunk) {
+				sum += p;
+			}
+		}
+		return sum;
+	};
+
+	BENCHMARK("Chunked, source on its own thread")
+	{
+		ufo::Vec3f sum{};
+		for (std::span<ufo::Vec3f> chunk : ufo::filterChunks(
+		         ufo::transformChunks(
+		             pose, ufo::asyncChunks(ufo::transformChunks(deskew, ufo::chunks(scan)))),
+		         keep)) {
+			for (auto const& p : chunk) {
+				sum += p;
+			}
+		}
+		return sum;
+	};
+}
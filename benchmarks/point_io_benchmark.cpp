@@ -0,0 +1,132 @@
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/chars.hpp>
+#include <ufo/math/point_io.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NUM_POINTS      = 1'000'000;
+constexpr std::size_t NUM_FILE_POINTS = 10'000'000;
+
+std::vector<ufo::Vec3f> randomPoints(std::size_t n, unsigned seed)
+{
+	std::mt19937                          gen(seed);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	std::vector<ufo::Vec3f> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(dist(gen), dist(gen), dist(gen));
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[PointIO] Format and parse 1M points as XYZ")
+{
+	auto const points = randomPoints(NUM_POINTS, 1);
+
+	std::string text;
+	for (auto const& p : points) {
+		text += ufo::toString(p);
+		text += '\n';
+	}
+
+	BENCHMARK("Format with ostream")
+	{
+		std::ostringstream ss;
+		for (auto const& p : points) {
+			ss << p.x << ' ' << p.y << ' ' << p.z << '\n';
+		}
+		return ss.str().size();
+	};
+
+	BENCHMARK("Format with toChars")
+	{
+		std::string out(NUM_POINTS * 40, '\0');
+		char*       first = out.data();
+		for (auto const& p : points) {
+			first    = ufo::toChars(first, out.data() + out.size(), p).ptr;
+			*first++ = '\n';
+		}
+		return first - out.data();
+	};
+
+	BENCHMARK("Parse with istream")
+	{
+		std::istringstream      ss(text);
+		std::vector<ufo::Vec3f> out;
+		ufo::Vec3f              p;
+		while (ss >> p.x >> p.y >> p.z) {
+			out.push_back(p);
+		}
+		return out.size();
+	};
+
+	BENCHMARK("Parse with parseXYZ") { return ufo::parseXYZ(text).size(); };
+}
+
+TEST_CASE("[PointIO] Read 10M points from binary PLY and PCD")
+{
+	auto const points = randomPoints(NUM_FILE_POINTS, 2);
+
+	auto const dir = std::filesystem::temp_directory_path();
+	auto const ply = dir / "ufomath_point_io_benchmark.ply";
+	auto const pcd = dir / "ufomath_point_io_benchmark.pcd";
+	ufo::writePLY(ply, points);
+	ufo::writePCD(pcd, points);
+
+	BENCHMARK("Read PLY point by point with ifstream")
+	{
+		std::ifstream file(ply, std::ios::binary);
+		std::string   line;
+		while (std::getline(file, line) && "end_header" != line) {
+		}
+		std::vector<ufo::Vec3f> out;
+		ufo::Vec3f              p;
+		while (file.read(reinterpret_cast<char*>(&p), sizeof(p))) {
+			out.push_back(p);
+		}
+		return out.size();
+	};
+
+	BENCHMARK("readPLY") { return ufo::readPLY(ply).size(); };
+
+	BENCHMARK("readPLY par") { return ufo::readPLY(ufo::execution::par, ply).size(); };
+
+	BENCHMARK("readPCD") { return ufo::readPCD(pcd).size(); };
+
+	std::vector<ufo::Vec3d> out(NUM_FILE_POINTS);
+	BENCHMARK("PointCloudFile into existing Vec3d buffer")
+	{
+		ufo::PointCloudFile const file(pcd);
+		file.read(std::span(out));
+		return out.size();
+	};
+
+	std::vector<float> x(NUM_FILE_POINTS), y(NUM_FILE_POINTS), z(NUM_FILE_POINTS);
+	BENCHMARK("PointCloudFile into existing SoA buffers")
+	{
+		ufo::PointCloudFile const file(ply);
+		file.read(std::span(x), std::span(y), std::span(z));
+		return x.size();
+	};
+
+	std::filesystem::remove(ply);
+	std::filesystem::remove(pcd);
+}
@@ -0,0 +1,163 @@
+// UFO
+#include <ufo/math/quat_transform.hpp>
+#include <ufo/math/transform3.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NUM_POSES  = 1'000'000;
+constexpr std::size_t NUM_POINTS = 1'000'000;
+
+std::vector<ufo::QuatTransformf> randomPoses(std::size_t n)
+{
+	std::mt19937                          gen(42);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	std::vector<ufo::QuatTransformf> poses;
+	poses.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		ufo::Quatf q(dist(gen), dist(gen), dist(gen), dist(gen));
+		poses.emplace_back(normalize(q), ufo::Vec3f(dist(gen), dist(gen), dist(gen)));
+	}
+	return poses;
+}
+
+std::vector<ufo::Vec3f> randomPoints(std::size_t n)
+{
+	std::mt19937                          gen(1337);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	std::vector<ufo::Vec3f> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(dist(gen), dist(gen), dist(gen));
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[QuatTransform] Storage")
+{
+	auto const qposes = randomPoses(NUM_POSES);
+
+	std::vector<ufo::Transform3f> mposes;
+	mposes.reserve(qposes.size());
+	for (auto const& p : qposes) {
+		mposes.emplace_back(p);
+	}
+
+	std::cout << "Memory for " << NUM_POSES << " poses:\n"
+	          << "  Transform3f:    " << mposes.size() * sizeof(ufo::Transform3f)
+	          << " bytes\n"
+	          << "  QuatTransformf: " << qposes.size() * sizeof(ufo::QuatTransformf)
+	          << " bytes\n";
+
+	BENCHMARK("Transform3f compose chain")
+	{
+		ufo::Transform3f acc;
+		for (auto const& p : mposes) {
+			acc *= p;
+		}
+		return acc;
+	};
+
+	BENCHMARK("QuatTransformf compose chain")
+	{
+		ufo::QuatTransformf acc;
+		for (auto const& p : qposes) {
+			acc *= p;
+		}
+		return acc;
+	};
+
+	BENCHMARK("Transform3f apply each pose to a point")
+	{
+		ufo::Vec3f       acc;
+		ufo::Vec3f const v(1.0f, 2.0f, 3.0f);
+		for (auto const& p : mposes) {
+			acc += p(v);
+		}
+		return acc;
+	};
+
+	BENCHMARK("QuatTransformf apply each pose to a point")
+	{
+		ufo::Vec3f       acc;
+		ufo::Vec3f const v(1.0f, 2.0f, 3.0f);
+		for (auto const& p : qposes) {
+			acc += p(v);
+		}
+		return acc;
+	};
+
+	BENCHMARK("QuatTransformf -> Transform3f conversion")
+	{
+		for (std::size_t i{}; qposes.size() > i; ++i) {
+			mposes[i] = ufo::Transform3f(qposes[i]);
+		}
+		return mposes.back();
+	};
+
+	BENCHMARK("Transform3f -> QuatTransformf conversion")
+	{
+		std::vector<ufo::QuatTransformf> out(mposes.size());
+		for (std::size_t i{}; mposes.size() > i; ++i) {
+			out[i] = ufo::QuatTransformf(mposes[i]);
+		}
+		return out.back();
+	};
+}
+
+TEST_CASE("[QuatTransform] Point transformation")
+{
+	auto const points = randomPoints(NUM_POINTS);
+	auto const qt     = randomPoses(1).front();
+	auto const mt     = ufo::Transform3f(qt);
+
+	std::vector<ufo::Vec3f> out(points.size());
+
+	BENCHMARK("Transform3f per point")
+	{
+		for (std::size_t i{}; points.size() > i; ++i) {
+			out[i] = mt(points[i]);
+		}
+		return out.back();
+	};
+
+	BENCHMARK("QuatTransformf per point")
+	{
+		for (std::size_t i{}; points.size() > i; ++i) {
+			out[i] = qt(points[i]);
+		}
+		return out.back();
+	};
+
+	BENCHMARK("Transform3f batch")
+	{
+		return transform(mt, points.begin(), points.end(), out.begin());
+	};
+
+	BENCHMARK("QuatTransformf batch")
+	{
+		return transform(qt, points.begin(), points.end(), out.begin());
+	};
+
+	BENCHMARK("Transform3f batch par")
+	{
+		return transform(ufo::execution::par, mt, points.begin(), points.end(), out.begin());
+	};
+
+	BENCHMARK("QuatTransformf batch par")
+	{
+		return transform(ufo::execution::par, qt, points.begin(), points.end(), out.begin());
+	};
+}
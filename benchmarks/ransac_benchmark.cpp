@@ -0,0 +1,74 @@
+// UFO
+#include <ufo/math/ransac.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Ground plane with 40% inliers, the rest uniform clutter
+std::vector<ufo::Vec3f> groundScan(std::size_t n)
+{
+	std::mt19937                          gen(42);
+	std::uniform_real_distribution<float> uni(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> height(-1.0f, 10.0f);
+	std::normal_distribution<float>       noise(0.0f, 0.02f);
+
+	std::vector<ufo::Vec3f> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		if (4 > i % 10) {
+			points.emplace_back(uni(gen), uni(gen), noise(gen));
+		} else {
+			points.emplace_back(uni(gen), uni(gen), height(gen));
+		}
+	}
+	return points;
+}
+
+void run(std::size_t n)
+{
+	auto const points = groundScan(n);
+
+	ufo::RansacParams<float> params;
+	params.threshold = 0.05f;
+
+	ufo::RansacParams<float> no_sprt = params;
+	no_sprt.sprt                     = false;
+
+	auto res = ufo::ransacPlane(points.begin(), points.end(), params);
+	std::cout << n << " points: " << res.iterations << " iterations, " << res.inliers
+	          << " inliers\n";
+
+	BENCHMARK("countInliers " + std::to_string(n))
+	{
+		return ufo::countInliers(res.model, points.begin(), points.end(), params.threshold);
+	};
+
+	BENCHMARK("ransacPlane no SPRT " + std::to_string(n))
+	{
+		return ufo::ransacPlane(points.begin(), points.end(), no_sprt);
+	};
+
+	BENCHMARK("ransacPlane " + std::to_string(n))
+	{
+		return ufo::ransacPlane(points.begin(), points.end(), params);
+	};
+
+	BENCHMARK("ransacPlane par " + std::to_string(n))
+	{
+		return ufo::ransacPlane(ufo::execution::par, points.begin(), points.end(), params);
+	};
+}
+}  // namespace
+
+TEST_CASE("[RANSAC] 100k points") { run(100'000); }
+
+TEST_CASE("[RANSAC] 1M points") { run(1'000'000); }
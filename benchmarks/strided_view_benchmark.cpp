@@ -0,0 +1,73 @@
+// UFO
+#include <ufo/math/strided_view.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NUM_POINTS = 1'000'000;
+
+struct Point {
+	ufo::Vec3f    xyz;
+	float         intensity;
+	std::uint16_t ring;
+	double        t;
+};
+
+std::vector<Point> randomPoints(std::size_t n, unsigned seed)
+{
+	std::mt19937                          gen(seed);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	std::vector<Point> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		points.push_back({ufo::Vec3f(dist(gen), dist(gen), dist(gen)), dist(gen), 0, 0.0});
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[StridedView] Transform xyz of 1M point records")
+{
+	auto points = randomPoints(NUM_POINTS, 1);
+
+	ufo::Transform3f const t(ufo::Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1),
+	                         ufo::Vec3f(1, 2, 3));
+
+	BENCHMARK("Copy out, transform, copy back")
+	{
+		std::vector<ufo::Vec3f> xyz(points.size());
+		for (std::size_t i{}; points.size() > i; ++i) {
+			xyz[i] = points[i].xyz;
+		}
+		ufo::transformInPlace(t, xyz);
+		for (std::size_t i{}; points.size() > i; ++i) {
+			points[i].xyz = xyz[i];
+		}
+		return points.back().xyz;
+	};
+
+	BENCHMARK("Strided iterators")
+	{
+		auto view = ufo::stridedView(points, &Point::xyz);
+		ufo::transformInPlace(t, view.begin(), view.end());
+		return points.back().xyz;
+	};
+
+	BENCHMARK("Strided view")
+	{
+		ufo::transformInPlace(t, ufo::stridedView(points, &Point::xyz));
+		return points.back().xyz;
+	};
+}
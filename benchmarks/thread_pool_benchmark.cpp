@@ -0,0 +1,60 @@
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/thread_pool.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<ufo::Vec3f> randomPoints(std::size_t n)
+{
+	std::mt19937                          gen(1337);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	std::vector<ufo::Vec3f> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(dist(gen), dist(gen), dist(gen));
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[ThreadPool] Transform against OpenMP")
+{
+	ufo::Transform3f const t(ufo::Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1), ufo::Vec3f(1, 2, 3));
+	ufo::ThreadPool&       pool = ufo::ThreadPool::global();
+
+	// Small batches are dominated by the cost of starting the parallel loop
+	for (std::size_t n : {1'000, 100'000, 1'000'000}) {
+		auto const              points = randomPoints(n);
+		std::vector<ufo::Vec3f> out(n);
+		std::string const       size = std::to_string(n);
+
+		BENCHMARK("Sequential " + size)
+		{
+			return transform(t, points.begin(), points.end(), out.begin());
+		};
+
+		BENCHMARK("OpenMP " + size)
+		{
+			return transform(ufo::execution::omp::par, t, points.begin(), points.end(),
+			                 out.begin());
+		};
+
+		BENCHMARK("ThreadPool " + size)
+		{
+			return transform(pool.policy(), t, points.begin(), points.end(), out.begin());
+		};
+	}
+}
@@ -0,0 +1,104 @@
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/quat.hpp>
+#include <ufo/math/trajectory.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NUM_POSES = 100'000;
+
+ufo::Trajectory<double> randomTrajectory(std::size_t n, unsigned seed)
+{
+	std::mt19937                           gen(seed);
+	std::normal_distribution<double>       step(0.0, 0.1);
+	std::uniform_real_distribution<double> turn(-0.05, 0.05);
+
+	ufo::Trajectory<double> t;
+	ufo::Transform3d        pose;
+	for (std::size_t i{}; n > i; ++i) {
+		t.stamps.push_back(1e9 + 0.01 * static_cast<double>(i));
+		t.poses.push_back(pose);
+		pose = pose * ufo::Transform3d(ufo::angleAxis(turn(gen), ufo::Vec3d(0, 0, 1)),
+		                               ufo::Vec3d(1.0 + step(gen), step(gen), step(gen)));
+	}
+	return t;
+}
+}  // namespace
+
+TEST_CASE("[Trajectory] Load and evaluate 100k poses")
+{
+	auto const truth = randomTrajectory(NUM_POSES, 1);
+	auto const noisy = randomTrajectory(NUM_POSES, 2);
+
+	auto const dir   = std::filesystem::temp_directory_path();
+	auto const tum   = dir / "ufomath_trajectory_benchmark_tum.txt";
+	auto const kitti = dir / "ufomath_trajectory_benchmark_kitti.txt";
+	ufo::writeTUM(tum, truth);
+	ufo::writeKITTI(kitti, truth);
+
+	BENCHMARK("Read TUM with ifstream")
+	{
+		std::ifstream                 file(tum);
+		std::vector<double>           stamps;
+		std::vector<ufo::Transform3d> poses;
+		double                        s, tx, ty, tz, qx, qy, qz, qw;
+		while (file >> s >> tx >> ty >> tz >> qx >> qy >> qz >> qw) {
+			stamps.push_back(s);
+			poses.emplace_back(ufo::Quat<double>(qw, qx, qy, qz), ufo::Vec3d(tx, ty, tz));
+		}
+		return poses.size();
+	};
+
+	BENCHMARK("readTUM") { return ufo::readTUM(tum).size(); };
+
+	BENCHMARK("readTUM par") { return ufo::readTUM(ufo::execution::par, tum).size(); };
+
+	BENCHMARK("readKITTI") { return ufo::readKITTI(kitti).size(); };
+
+	BENCHMARK("writeTUM")
+	{
+		ufo::writeTUM(tum, truth);
+		return std::filesystem::file_size(tum);
+	};
+
+	auto const& est = noisy.poses;
+	auto const& gt  = truth.poses;
+
+	BENCHMARK("ATE")
+	{
+		return ufo::ate(est.begin(), est.end(), gt.begin()).error.rmse;
+	};
+
+	BENCHMARK("ATE par")
+	{
+		return ufo::ate(ufo::execution::par, est.begin(), est.end(), gt.begin()).error.rmse;
+	};
+
+	BENCHMARK("RPE")
+	{
+		return ufo::rpe(est.begin(), est.end(), gt.begin()).translation.rmse;
+	};
+
+	BENCHMARK("RPE par")
+	{
+		return ufo::rpe(ufo::execution::par, est.begin(), est.end(), gt.begin())
+		    .translation.rmse;
+	};
+
+	std::filesystem::remove(tum);
+	std::filesystem::remove(kitti);
+}
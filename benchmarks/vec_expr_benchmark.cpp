@@ -0,0 +1,67 @@
+// UFO
+#include <ufo/math/vec3.hpp>
+#include <ufo/math/vec_expr.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NUM_POINTS = 1'000'000;
+
+std::vector<ufo::Vec3f> randomPoints(std::size_t n, unsigned seed)
+{
+	std::mt19937                          gen(seed);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	std::vector<ufo::Vec3f> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(dist(gen), dist(gen), dist(gen));
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[VecExpr] Lerp over 1M points")
+{
+	auto const  a = randomPoints(NUM_POINTS, 1);
+	auto const  b = randomPoints(NUM_POINTS, 2);
+	float const t = 0.3f;
+
+	std::vector<ufo::Vec3f> out(NUM_POINTS);
+
+	// One pass per operator, as when every step of a chain produces a new range
+	BENCHMARK("Materialized intermediates")
+	{
+		std::vector<ufo::Vec3f> diff(NUM_POINTS);
+		std::transform(b.begin(), b.end(), a.begin(), diff.begin(),
+		               [](auto const& x, auto const& y) { return x - y; });
+		std::transform(diff.begin(), diff.end(), diff.begin(),
+		               [t](auto const& x) { return x * t; });
+		std::transform(a.begin(), a.end(), diff.begin(), out.begin(),
+		               [](auto const& x, auto const& y) { return x + y; });
+		return out.back();
+	};
+
+	BENCHMARK("Expression")
+	{
+		ufo::evaluate(ufo::lazy(a) + (ufo::lazy(b) - ufo::lazy(a)) * t, out.begin());
+		return out.back();
+	};
+
+	BENCHMARK("Hand-written loop")
+	{
+		for (std::size_t i{}; NUM_POINTS > i; ++i) {
+			out[i] = a[i] + (b[i] - a[i]) * t;
+		}
+		return out.back();
+	};
+}
@@ -0,0 +1,127 @@
+// UFO
+#include <ufo/math/kdtree.hpp>
+#include <ufo/math/voxel_hash.hpp>
+
+// Catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Surface samples of a 200 m x 200 m street scene: ground plus building facades
+std::vector<ufo::Vec3f> scene(std::size_t n, unsigned seed)
+{
+	std::mt19937                          gen(seed);
+	std::uniform_real_distribution<float> uni(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> height(0.0f, 15.0f);
+
+	std::vector<ufo::Vec3f> points;
+	points.reserve(n);
+	for (std::size_t i{}; n > i; ++i) {
+		float const x = uni(gen);
+		float const y = uni(gen);
+		switch (i % 3) {
+			case 0: points.emplace_back(x, y, 0.2f * std::sin(0.1f * x)); break;
+			case 1: points.emplace_back(x, 8.0f + 0.5f * std::sin(0.3f * x), height(gen)); break;
+			default: points.emplace_back(-8.0f + 0.5f * std::cos(0.2f * y), y, height(gen));
+		}
+	}
+	return points;
+}
+
+template <class F>
+double perSecond(std::size_t n, F f)
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return static_cast<double>(n) / elapsed.count() / 1e6;
+}
+}  // namespace
+
+TEST_CASE("[VoxelHash] 1M points against KDTree")
+{
+	auto const points = scene(1'000'000, 51);
+
+	// A new scan close to the map, as in scan to map registration
+	auto                    queries = scene(1'000'000, 52);
+	std::mt19937            gen(53);
+	std::normal_distribution<float> noise(0.0f, 0.05f);
+	for (auto& q : queries) {
+		q += ufo::Vec3f(noise(gen), noise(gen), noise(gen));
+	}
+
+	BENCHMARK("VoxelHash build")
+	{
+		ufo::VoxelHash<float> map(1.0f, 20);
+		return map.insert(points.begin(), points.end());
+	};
+
+	BENCHMARK("KDTree build") { return ufo::KDTree<3>(points.begin(), points.end()); };
+
+	ufo::VoxelHash<float> map(1.0f, 20);
+	map.insert(points.begin(), points.end());
+	ufo::KDTree<3> tree(points.begin(), points.end());
+
+	std::vector<std::pair<ufo::Vec3f, float>> hits(queries.size());
+	std::vector<std::uint32_t>                indices(queries.size());
+	std::vector<float>                        distances(queries.size());
+
+	BENCHMARK("VoxelHash nearest, 27 voxels")
+	{
+		return ufo::nearest(map, queries.begin(), queries.end(), hits.begin());
+	};
+
+	BENCHMARK("VoxelHash nearest, 7 voxels")
+	{
+		return ufo::nearest(map, queries.begin(), queries.end(), hits.begin(),
+		                    ufo::VoxelStencil::FACES);
+	};
+
+	BENCHMARK("VoxelHash nearest, 1 voxel")
+	{
+		return ufo::nearest(map, queries.begin(), queries.end(), hits.begin(),
+		                    ufo::VoxelStencil::VOXEL);
+	};
+
+	BENCHMARK("VoxelHash nearest par")
+	{
+		return ufo::nearest(ufo::execution::par, map, queries.begin(), queries.end(),
+		                    hits.begin());
+	};
+
+	BENCHMARK("KDTree nearest")
+	{
+		ufo::knn(tree, queries.begin(), queries.end(), 1, indices.begin(), distances.begin());
+		return distances.back();
+	};
+
+	double const voxel = perSecond(queries.size(), [&] {
+		ufo::nearest(map, queries.begin(), queries.end(), hits.begin());
+	});
+	double const kd = perSecond(queries.size(), [&] {
+		ufo::knn(tree, queries.begin(), queries.end(), 1, indices.begin(), distances.begin());
+	});
+
+	std::size_t exact{};
+	for (std::size_t i{}; queries.size() > i; ++i) {
+		exact += hits[i].second == distances[i] ? 1 : 0;
+	}
+
+	std::cout << map.size() << " of " << points.size() << " points kept in "
+	          << map.numVoxels() << " voxels\n"
+	          << voxel << " million queries per second (voxel hash, 27 voxels, one thread)\n"
+	          << kd << " million queries per second (k-d tree, exact, one thread)\n"
+	          << 100.0 * static_cast<double>(exact) / static_cast<double>(queries.size())
+	          << "% of the voxel hash answers are exact\n";
+}
@@ -0,0 +1,211 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_AABB_HPP
+#define UFO_MATH_AABB_HPP
+
+// UFO
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <cstddef>
+#include <limits>
+#include <ostream>
+
+namespace ufo
+{
+/*!
+ * @brief Axis-aligned bounding box given by its minimum and maximum corner.
+ *
+ * A default constructed `AABB` is empty (`min > max`), so that `expand` can be used to
+ * grow it from nothing.
+ */
+template <std::size_t Dim, class T = float>
+struct AABB {
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	Vec<Dim, T> min = Vec<Dim, T>(std::numeric_limits<T>::max());
+	Vec<Dim, T> max = Vec<Dim, T>(std::numeric_limits<T>::lowest());
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr AABB() noexcept            = default;
+	constexpr AABB(AABB const&) noexcept = default;
+
+	constexpr AABB(Vec<Dim, T> const& min, Vec<Dim, T> const& max) noexcept
+	    : min(min), max(max)
+	{
+	}
+
+	constexpr explicit AABB(Vec<Dim, T> const& point) noexcept : min(point), max(point) {}
+
+	constexpr AABB& operator=(AABB const&) noexcept = default;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Accessors                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] constexpr Vec<Dim, T> center() const noexcept
+	{
+		return (min + max) * T(0.5);
+	}
+
+	[[nodiscard]] constexpr Vec<Dim, T> halfSize() const noexcept
+	{
+		return (max - min) * T(0.5);
+	}
+
+	[[nodiscard]] constexpr Vec<Dim, T> size() const noexcept { return max - min; }
+
+	[[nodiscard]] constexpr bool empty() const noexcept
+	{
+		for (std::size_t i{}; Dim > i; ++i) {
+			if (min[i] > max[i]) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Modifiers                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr AABB& expand(Vec<Dim, T> const& point) noexcept
+	{
+		min = ufo::min(min, point);
+		max = ufo::max(max, point);
+		return *this;
+	}
+
+	constexpr AABB& expand(AABB const& other) noexcept
+	{
+		min = ufo::min(min, other.min);
+		max = ufo::max(max, other.max);
+		return *this;
+	}
+};
+
+template <class T = float>
+using AABB2 = AABB<2, T>;
+template <class T = float>
+using AABB3 = AABB<3, T>;
+
+using AABB2f = AABB2<float>;
+using AABB2d = AABB2<double>;
+using AABB3f = AABB3<float>;
+using AABB3d = AABB3<double>;
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABB<Dim, T> const& aabb, Vec<Dim, T> const& point)
+{
+	return all(lessThanEqual(aabb.min, point)) && all(lessThanEqual(point, aabb.max));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABB<Dim, T> const& a, AABB<Dim, T> const& b)
+{
+	return all(lessThanEqual(a.min, b.max)) && all(lessThanEqual(b.min, a.max));
+}
+
+/*!
+ * @brief Point in `aabb` closest to `point`.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> closestPoint(AABB<Dim, T> const& aabb,
+                                                 Vec<Dim, T> const&  point)
+{
+	return clamp(point, aabb.min, aabb.max);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(AABB<Dim, T> const& aabb,
+                                          Vec<Dim, T> const&  point)
+{
+	return distanceSquared(closestPoint(aabb, point), point);
+}
+
+/*!
+ * @brief Surface area (3D) or perimeter (2D) of the box.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T area(AABB<Dim, T> const& aabb)
+{
+	Vec<Dim, T> s = aabb.size();
+	if constexpr (2 == Dim) {
+		return T(2) * (s.x + s.y);
+	} else {
+		static_assert(3 == Dim, "area is only implemented for 2D and 3D");
+		return T(2) * (s.x * s.y + s.y * s.z + s.z * s.x);
+	}
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool operator==(AABB<Dim, T> const& lhs,
+                                        AABB<Dim, T> const& rhs) noexcept
+{
+	return lhs.min == rhs.min && lhs.max == rhs.max;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool operator!=(AABB<Dim, T> const& lhs,
+                                        AABB<Dim, T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template <std::size_t Dim, class T>
+std::ostream& operator<<(std::ostream& out, AABB<Dim, T> const& aabb)
+{
+	return out << "Min: " << aabb.min << ", Max: " << aabb.max;
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_AABB_HPP
@@ -0,0 +1,372 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_ALGORITHM_HPP
+#define UFO_MATH_ALGORITHM_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+namespace detail
+{
+// The input is cut into a number of blocks that only depends on its size, and the
+// partial results are combined in block order, so every execution policy gives the same
+// result, bit for bit, as long as the operation is associative
+inline constexpr std::size_t reduce_min_block  = 1024;
+inline constexpr std::size_t reduce_max_blocks = 64;
+
+template <class T>
+struct alignas(64) Padded {
+	T value;
+};
+
+struct Identity {
+	template <class T>
+	[[nodiscard]] constexpr T&& operator()(T&& x) const noexcept
+	{
+		return std::forward<T>(x);
+	}
+};
+
+[[nodiscard]] inline std::size_t reduceBlocks(std::size_t size) noexcept
+{
+	return std::clamp<std::size_t>(size / reduce_min_block, 1, reduce_max_blocks);
+}
+
+/*!
+ * @brief Combines `init` and `transform_op(i)` of every index `i` in [0, `size`) with
+ * `reduce_op`, for reductions over several ranges at once.
+ */
+template <class ForEach, class T, class BinaryOp, class UnaryOp>
+[[nodiscard]] T transformReduceIndices(ForEach for_each, std::size_t size, T init,
+                                       BinaryOp reduce_op, UnaryOp transform_op)
+{
+	if (0 == size) {
+		return init;
+	}
+
+	std::size_t const blocks = reduceBlocks(size);
+
+	// Left fold of a block, starting from its first element
+	auto fold = [&](std::size_t b) {
+		std::size_t const begin = size * b / blocks;
+		std::size_t const end   = size * (b + 1) / blocks;
+		T                 acc   = transform_op(begin);
+		for (std::size_t i = begin + 1; end > i; ++i) {
+			acc = reduce_op(std::move(acc), transform_op(i));
+		}
+		return acc;
+	};
+
+	if (1 == blocks) {
+		return reduce_op(std::move(init), fold(0));
+	}
+
+	std::array<Padded<T>, reduce_max_blocks> partial{};
+	for_each(0, blocks, [&](std::size_t b) { partial[b].value = fold(b); });
+
+	for (std::size_t b{}; blocks > b; ++b) {
+		init = reduce_op(std::move(init), std::move(partial[b].value));
+	}
+	return init;
+}
+
+template <class ForEach, class RandomIt, class T, class BinaryOp, class UnaryOp>
+[[nodiscard]] T transformReduce(ForEach for_each, RandomIt first, RandomIt last, T init,
+                                BinaryOp reduce_op, UnaryOp transform_op)
+{
+	std::size_t const size = std::distance(first, last);
+	return transformReduceIndices(for_each, size, std::move(init), reduce_op,
+	                              [&](std::size_t i) { return transform_op(first[i]); });
+}
+
+template <class ForEach, class RandomIt>
+[[nodiscard]] auto minmax(ForEach for_each, RandomIt first, RandomIt last)
+{
+	assert(first != last);
+
+	using V = typename std::iterator_traits<RandomIt>::value_type;
+	using P = std::pair<V, V>;
+
+	return transformReduce(
+	    for_each, first + 1, last, P(first[0], first[0]),
+	    [](P const& a, P const& b) {
+		    using std::max;
+		    using std::min;
+		    return P(min(a.first, b.first), max(a.second, b.second));
+	    },
+	    [](V const& v) { return P(v, v); });
+}
+
+template <class ForEach, class RandomIt>
+[[nodiscard]] auto centroid(ForEach for_each, RandomIt first, RandomIt last)
+{
+	assert(first != last);
+
+	using V = typename std::iterator_traits<RandomIt>::value_type;
+	using T = typename V::value_type;
+
+	V const sum = transformReduce(for_each, first + 1, last, V(first[0]), std::plus<>{},
+	                              Identity{});
+	return sum / static_cast<T>(std::distance(first, last));
+}
+
+template <class ForEach, class RandomIt, class UnaryPredicate>
+[[nodiscard]] std::size_t countIf(ForEach for_each, RandomIt first, RandomIt last,
+                                  UnaryPredicate pred)
+{
+	return transformReduce(for_each, first, last, std::size_t(0), std::plus<>{},
+	                       [&pred](auto const& x) -> std::size_t {
+		                       return pred(x) ? 1 : 0;
+	                       });
+}
+
+/*!
+ * @brief Stable partition: the predicate is evaluated once per element, each block then
+ * moves its elements to their final place in a buffer, which is moved back.
+ */
+template <class ForEach, class RandomIt, class UnaryPredicate>
+RandomIt partition(ForEach for_each, RandomIt first, RandomIt last, UnaryPredicate pred)
+{
+	using V = typename std::iterator_traits<RandomIt>::value_type;
+
+	std::size_t const size   = std::distance(first, last);
+	std::size_t const blocks = reduceBlocks(size);
+	if (1 == blocks) {
+		return std::stable_partition(first, last, pred);
+	}
+
+	auto begin = [size, blocks](std::size_t b) { return size * b / blocks; };
+
+	std::vector<unsigned char>                          selected(size);
+	std::array<Padded<std::size_t>, reduce_max_blocks> count{};
+	for_each(0, blocks, [&](std::size_t b) {
+		std::size_t c{};
+		for (std::size_t i = begin(b), end = begin(b + 1); end > i; ++i) {
+			selected[i] = pred(first[i]) ? 1 : 0;
+			c += selected[i];
+		}
+		count[b].value = c;
+	});
+
+	std::array<std::size_t, reduce_max_blocks> offset{};
+	std::size_t                                num_selected{};
+	for (std::size_t b{}; blocks > b; ++b) {
+		offset[b] = num_selected;
+		num_selected += count[b].value;
+	}
+
+	std::vector<V> buffer(size);
+	for_each(0, blocks, [&](std::size_t b) {
+		std::size_t t = offset[b];
+		std::size_t f = num_selected + begin(b) - offset[b];
+		for (std::size_t i = begin(b), end = begin(b + 1); end > i; ++i) {
+			buffer[selected[i] ? t++ : f++] = std::move(first[i]);
+		}
+	});
+
+	for_each(0, blocks, [&](std::size_t b) {
+		std::move(buffer.begin() + begin(b), buffer.begin() + begin(b + 1), first + begin(b));
+	});
+
+	return first + num_selected;
+}
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Reduce                                        |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Combines `init` and the elements of [`first`, `last`) with `op`, e.g. the sum of
+ * `Vec`s or, with `std::multiplies<>`, the composition of `Transform`s or `Quat`s.
+ *
+ * `op` has to be associative but does not have to be commutative, the elements are
+ * combined in order. Should be called qualified, `ufo::reduce`, as unqualified calls on
+ * standard iterators are ambiguous with `std::reduce`.
+ */
+template <class RandomIt, class T, class BinaryOp = std::plus<>>
+[[nodiscard]] T reduce(RandomIt first, RandomIt last, T init, BinaryOp op = {})
+{
+	return detail::transformReduce(detail::SequentialForEach{}, first, last,
+	                               std::move(init), op, detail::Identity{});
+}
+
+template <
+    class ExecutionPolicy, class RandomIt, class T, class BinaryOp = std::plus<>,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] T reduce(ExecutionPolicy&& policy, RandomIt first, RandomIt last, T init,
+                       BinaryOp op = {})
+{
+	return detail::transformReduce(detail::PolicyForEach<ExecutionPolicy>{policy}, first,
+	                               last, std::move(init), op, detail::Identity{});
+}
+
+/*!
+ * @brief Combines `init` and `transform_op(x)` of every element `x` of [`first`, `last`)
+ * with `reduce_op`, see `reduce`.
+ */
+template <class RandomIt, class T, class BinaryOp, class UnaryOp>
+[[nodiscard]] T transformReduce(RandomIt first, RandomIt last, T init, BinaryOp reduce_op,
+                                UnaryOp transform_op)
+{
+	return detail::transformReduce(detail::SequentialForEach{}, first, last,
+	                               std::move(init), reduce_op, transform_op);
+}
+
+template <
+    class ExecutionPolicy, class RandomIt, class T, class BinaryOp, class UnaryOp,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] T transformReduce(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                                T init, BinaryOp reduce_op, UnaryOp transform_op)
+{
+	return detail::transformReduce(detail::PolicyForEach<ExecutionPolicy>{policy}, first,
+	                               last, std::move(init), reduce_op, transform_op);
+}
+
+/*!
+ * @brief The smallest and largest element of the non-empty range [`first`, `last`),
+ * component-wise for `Vec`s, so the corners of their bounding box.
+ *
+ * Should be called qualified, `ufo::minmax`, see `reduce`.
+ */
+template <class RandomIt>
+[[nodiscard]] auto minmax(RandomIt first, RandomIt last)
+{
+	return detail::minmax(detail::SequentialForEach{}, first, last);
+}
+
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] auto minmax(ExecutionPolicy&& policy, RandomIt first, RandomIt last)
+{
+	return detail::minmax(detail::PolicyForEach<ExecutionPolicy>{policy}, first, last);
+}
+
+/*!
+ * @brief The mean of the non-empty range [`first`, `last`) of `Vec`s.
+ */
+template <class RandomIt>
+[[nodiscard]] auto centroid(RandomIt first, RandomIt last)
+{
+	return detail::centroid(detail::SequentialForEach{}, first, last);
+}
+
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] auto centroid(ExecutionPolicy&& policy, RandomIt first, RandomIt last)
+{
+	return detail::centroid(detail::PolicyForEach<ExecutionPolicy>{policy}, first, last);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Count                                        |
+|                                                                                     |
+**************************************************************************************/
+
+template <class RandomIt, class UnaryPredicate>
+[[nodiscard]] std::size_t countIf(RandomIt first, RandomIt last, UnaryPredicate pred)
+{
+	return detail::countIf(detail::SequentialForEach{}, first, last, pred);
+}
+
+template <
+    class ExecutionPolicy, class RandomIt, class UnaryPredicate,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] std::size_t countIf(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                                  UnaryPredicate pred)
+{
+	return detail::countIf(detail::PolicyForEach<ExecutionPolicy>{policy}, first, last,
+	                       pred);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Partition                                      |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Moves the elements for which `pred` is true before the others and returns the
+ * beginning of the second group.
+ *
+ * Unlike `std::partition` the relative order within both groups is kept, so the result
+ * does not depend on the execution policy. The policy overload moves the elements
+ * through a buffer of the same size. Should be called qualified, `ufo::partition`, see
+ * `reduce`.
+ */
+template <class RandomIt, class UnaryPredicate>
+RandomIt partition(RandomIt first, RandomIt last, UnaryPredicate pred)
+{
+	return std::stable_partition(first, last, pred);
+}
+
+template <
+    class ExecutionPolicy, class RandomIt, class UnaryPredicate,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt partition(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                   UnaryPredicate pred)
+{
+	return detail::partition(detail::PolicyForEach<ExecutionPolicy>{policy}, first, last,
+	                         pred);
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_ALGORITHM_HPP
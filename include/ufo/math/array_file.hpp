@@ -0,0 +1,525 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_ARRAY_FILE_HPP
+#define UFO_MATH_ARRAY_FILE_HPP
+
+// UFO
+#include <ufo/math/mapped_file.hpp>
+#include <ufo/math/mat.hpp>
+#include <ufo/math/quat.hpp>
+#include <ufo/math/transform.hpp>
+#include <ufo/math/vec.hpp>
+#include <ufo/utility/type_traits.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief What each element of an array file is.
+ */
+enum class ArrayKind : std::uint8_t {
+	SCALAR,
+	VEC,
+	MAT,
+	QUAT,
+	TRANSFORM,
+	QUAT_TRANSFORM,
+};
+
+enum class ScalarType : std::uint8_t {
+	INT8,
+	UINT8,
+	INT16,
+	UINT16,
+	INT32,
+	UINT32,
+	INT64,
+	UINT64,
+	FLOAT,
+	DOUBLE,
+};
+
+/*!
+ * @brief How the scalars of the elements are ordered in an array file.
+ *
+ * `AOS` stores the elements one after the other, exactly as in memory. `SOA` stores one
+ * array per scalar of the element (x of every element, then y of every element, ...),
+ * each starting at a 64 byte boundary.
+ */
+enum class ArrayLayout : std::uint8_t {
+	AOS,
+	SOA,
+};
+
+/*!
+ * @brief The 64 byte header at the start of an array file.
+ *
+ * All fields are little-endian. An element has `rows * cols` scalars: `Vec<Dim>` is
+ * `Dim` by 1, `Mat<Cols, Rows>` is `Rows` by `Cols`, `Quat` is 4 by 1, `Transform<Dim>`
+ * is `Dim` by `Dim + 1` and `QuatTransform` is 7 by 1. The data starts at `offset`,
+ * which is a multiple of 64, and `stride` is the number of bytes between two elements
+ * for `AOS` and between two scalar arrays for `SOA`.
+ */
+struct ArrayHeader {
+	static constexpr std::array<char, 8> MAGIC = {'U', 'F', 'O', 'A', 'R', 'R', 'A', 'Y'};
+	static constexpr std::uint32_t       VERSION   = 1;
+	static constexpr std::uint64_t       ALIGNMENT = 64;
+
+	std::array<char, 8>       magic   = MAGIC;
+	std::uint32_t             version = VERSION;
+	ArrayKind                 kind{};
+	ScalarType                scalar{};
+	ArrayLayout               layout{};
+	std::uint8_t              reserved0{};
+	std::uint32_t             rows{};
+	std::uint32_t             cols{};
+	std::uint64_t             size{};
+	std::uint64_t             offset{};
+	std::uint64_t             stride{};
+	std::array<std::byte, 16> reserved{};
+
+	[[nodiscard]] std::size_t components() const noexcept
+	{
+		return static_cast<std::size_t>(rows) * cols;
+	}
+};
+
+static_assert(64 == sizeof(ArrayHeader));
+static_assert(std::is_trivially_copyable_v<ArrayHeader>);
+
+namespace detail
+{
+template <class T>
+[[nodiscard]] constexpr ScalarType scalarType() noexcept
+{
+	static_assert(std::is_arithmetic_v<T> && !std::is_same_v<bool, T>,
+	              "Array files store integer and floating point scalars");
+
+	if constexpr (std::is_floating_point_v<T>) {
+		static_assert(4 == sizeof(T) || 8 == sizeof(T));
+		return 4 == sizeof(T) ? ScalarType::FLOAT : ScalarType::DOUBLE;
+	} else if constexpr (1 == sizeof(T)) {
+		return std::is_signed_v<T> ? ScalarType::INT8 : ScalarType::UINT8;
+	} else if constexpr (2 == sizeof(T)) {
+		return std::is_signed_v<T> ? ScalarType::INT16 : ScalarType::UINT16;
+	} else if constexpr (4 == sizeof(T)) {
+		return std::is_signed_v<T> ? ScalarType::INT32 : ScalarType::UINT32;
+	} else {
+		return std::is_signed_v<T> ? ScalarType::INT64 : ScalarType::UINT64;
+	}
+}
+
+template <class T, class = void>
+struct ArrayTraits {
+	static_assert(dependent_false_v<T>, "Not a type array files can store");
+};
+
+template <class T>
+struct ArrayTraits<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+	using scalar_type = T;
+
+	static constexpr ArrayKind     kind = ArrayKind::SCALAR;
+	static constexpr std::uint32_t rows = 1;
+	static constexpr std::uint32_t cols = 1;
+};
+
+template <std::size_t Dim, class T>
+struct ArrayTraits<Vec<Dim, T>> {
+	using scalar_type = T;
+
+	static constexpr ArrayKind     kind = ArrayKind::VEC;
+	static constexpr std::uint32_t rows = Dim;
+	static constexpr std::uint32_t cols = 1;
+};
+
+template <std::size_t Cols, std::size_t Rows, class T>
+struct ArrayTraits<Mat<Cols, Rows, T>> {
+	using scalar_type = T;
+
+	static constexpr ArrayKind     kind = ArrayKind::MAT;
+	static constexpr std::uint32_t rows = Rows;
+	static constexpr std::uint32_t cols = Cols;
+};
+
+template <class T>
+struct ArrayTraits<Quat<T>> {
+	using scalar_type = T;
+
+	static constexpr ArrayKind     kind = ArrayKind::QUAT;
+	static constexpr std::uint32_t rows = 4;
+	static constexpr std::uint32_t cols = 1;
+};
+
+template <std::size_t Dim, class T>
+struct ArrayTraits<Transform<Dim, T>> {
+	using scalar_type = T;
+
+	static constexpr ArrayKind     kind = ArrayKind::TRANSFORM;
+	static constexpr std::uint32_t rows = Dim;
+	static constexpr std::uint32_t cols = Dim + 1;
+};
+
+template <class T>
+struct ArrayTraits<QuatTransform<T>> {
+	using scalar_type = T;
+
+	static constexpr ArrayKind     kind = ArrayKind::QUAT_TRANSFORM;
+	static constexpr std::uint32_t rows = 7;
+	static constexpr std::uint32_t cols = 1;
+};
+
+/*!
+ * @brief Checks at compile time that `T` is nothing but its scalars, so its bytes can be
+ * written and mapped as they are.
+ */
+template <class T>
+[[nodiscard]] constexpr bool isArrayStorable() noexcept
+{
+	using Traits = ArrayTraits<T>;
+	return std::is_trivially_copyable_v<T> &&
+	       sizeof(T) == Traits::rows * Traits::cols * sizeof(typename Traits::scalar_type);
+}
+
+template <class T>
+[[nodiscard]] ArrayHeader arrayHeader(std::size_t size, ArrayLayout layout) noexcept
+{
+	using Traits = ArrayTraits<T>;
+	using S      = typename Traits::scalar_type;
+
+	ArrayHeader h;
+	h.kind   = Traits::kind;
+	h.scalar = scalarType<S>();
+	h.layout = layout;
+	h.rows   = Traits::rows;
+	h.cols   = Traits::cols;
+	h.size   = size;
+	h.offset = ArrayHeader::ALIGNMENT;
+	if (ArrayLayout::AOS == layout) {
+		h.stride = sizeof(T);
+	} else {
+		h.stride = (size * sizeof(S) + ArrayHeader::ALIGNMENT - 1) / ArrayHeader::ALIGNMENT *
+		           ArrayHeader::ALIGNMENT;
+	}
+	return h;
+}
+
+[[nodiscard]] inline std::size_t scalarSize(ScalarType scalar) noexcept
+{
+	switch (scalar) {
+		case ScalarType::INT8:
+		case ScalarType::UINT8: return 1;
+		case ScalarType::INT16:
+		case ScalarType::UINT16: return 2;
+		case ScalarType::INT32:
+		case ScalarType::UINT32:
+		case ScalarType::FLOAT: return 4;
+		case ScalarType::INT64:
+		case ScalarType::UINT64:
+		case ScalarType::DOUBLE: return 8;
+	}
+	return 0;
+}
+
+inline void requireLittleEndian()
+{
+	if constexpr (std::endian::little != std::endian::native) {
+		throw std::runtime_error("Array files are only supported on little-endian hosts");
+	}
+}
+}  // namespace detail
+
+/*!
+ * @brief Writes `data` to `path` as an array file, see `ArrayHeader` for the format.
+ *
+ * @throws std::runtime_error If the file cannot be written.
+ */
+template <class T>
+void writeArray(std::filesystem::path const& path, std::span<T const> data,
+                ArrayLayout layout = ArrayLayout::AOS)
+{
+	static_assert(detail::isArrayStorable<T>(), "T has to consist of its scalars only");
+	detail::requireLittleEndian();
+
+	using S = typename detail::ArrayTraits<T>::scalar_type;
+
+	ArrayHeader const h = detail::arrayHeader<T>(data.size(), layout);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Cannot open '" + path.string() + "' for writing");
+	}
+
+	std::array<char, ArrayHeader::ALIGNMENT> header{};
+	std::memcpy(header.data(), &h, sizeof(h));
+	file.write(header.data(), header.size());
+
+	if (ArrayLayout::AOS == layout) {
+		file.write(reinterpret_cast<char const*>(data.data()),
+		           static_cast<std::streamsize>(data.size_bytes()));
+	} else {
+		std::array<char, ArrayHeader::ALIGNMENT> const padding{};
+		std::vector<S> buffer(std::min(data.size(), std::size_t(4096)));
+		for (std::size_t c{}; h.components() > c; ++c) {
+			for (std::size_t first{}; data.size() > first; first += buffer.size()) {
+				std::size_t const n = std::min(buffer.size(), data.size() - first);
+				for (std::size_t i{}; n > i; ++i) {
+					std::memcpy(&buffer[i],
+					            reinterpret_cast<char const*>(&data[first + i]) + c * sizeof(S),
+					            sizeof(S));
+				}
+				file.write(reinterpret_cast<char const*>(buffer.data()),
+				           static_cast<std::streamsize>(n * sizeof(S)));
+			}
+			file.write(padding.data(),
+			           static_cast<std::streamsize>(h.stride - data.size() * sizeof(S)));
+		}
+	}
+
+	if (!file) {
+		throw std::runtime_error("Failed writing '" + path.string() + "'");
+	}
+}
+
+template <class Range>
+void writeArray(std::filesystem::path const& path, Range const& range,
+                ArrayLayout layout = ArrayLayout::AOS)
+{
+	using T = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(range))>>;
+	writeArray(path, std::span<T const>(std::data(range), std::size(range)), layout);
+}
+
+/*!
+ * @brief Read-only view of an array file that is mapped into memory.
+ *
+ * Opening only maps the file and checks the header, the data is read from disk by the
+ * OS when it is first touched. `span` and `component` return spans straight into the
+ * mapping, so they work with every algorithm that takes a range without a copy. They
+ * stay valid as long as the `MappedArray` does.
+ */
+class MappedArray
+{
+ public:
+	/*!
+	 * @throws std::runtime_error If the file cannot be opened or is not a valid array file
+	 * of a supported version.
+	 */
+	explicit MappedArray(std::filesystem::path const& path)
+	{
+		detail::requireLittleEndian();
+		file_ = MappedFile(path);
+		validate(path);
+	}
+
+	[[nodiscard]] ArrayHeader const& header() const noexcept { return header_; }
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return static_cast<std::size_t>(header_.size);
+	}
+
+	/*!
+	 * @brief Whether the file stores `T`s, in either layout.
+	 */
+	template <class T>
+	[[nodiscard]] bool holds() const noexcept
+	{
+		using Traits = detail::ArrayTraits<T>;
+		return Traits::kind == header_.kind &&
+		       detail::scalarType<typename Traits::scalar_type>() == header_.scalar &&
+		       Traits::rows == header_.rows && Traits::cols == header_.cols;
+	}
+
+	/*!
+	 * @brief The elements of an `AOS` file.
+	 *
+	 * @throws std::runtime_error If the file does not hold `T`s in the `AOS` layout.
+	 */
+	template <class T>
+	[[nodiscard]] std::span<T const> span() const
+	{
+		static_assert(detail::isArrayStorable<T>(), "T has to consist of its scalars only");
+		if (!holds<T>() || ArrayLayout::AOS != header_.layout) {
+			throw std::runtime_error("Array file does not hold the requested type as AOS");
+		}
+		return {static_cast<T const*>(data(0)), size()};
+	}
+
+	/*!
+	 * @brief Scalar `c` of every element of an `SOA` file, for example the y coordinates
+	 * for `c = 1` in a file of `Vec3f`s.
+	 *
+	 * @throws std::runtime_error If the file is not `SOA`, has other scalars than `S`, or
+	 * `c` is out of range.
+	 */
+	template <class S>
+	[[nodiscard]] std::span<S const> component(std::size_t c) const
+	{
+		if (ArrayLayout::SOA != header_.layout ||
+		    detail::scalarType<S>() != header_.scalar || header_.components() <= c) {
+			throw std::runtime_error("Array file does not hold the requested component");
+		}
+		return {static_cast<S const*>(data(c * header_.stride)), size()};
+	}
+
+	/*!
+	 * @brief Copies the elements into a vector, from either layout.
+	 *
+	 * @throws std::runtime_error If the file does not hold `T`s.
+	 */
+	template <class T>
+	[[nodiscard]] std::vector<T> read() const
+	{
+		static_assert(detail::isArrayStorable<T>(), "T has to consist of its scalars only");
+		if (!holds<T>()) {
+			throw std::runtime_error("Array file does not hold the requested type");
+		}
+
+		if (ArrayLayout::AOS == header_.layout) {
+			auto const s = span<T>();
+			return std::vector<T>(s.begin(), s.end());
+		}
+
+		using S = typename detail::ArrayTraits<T>::scalar_type;
+		std::vector<T> v(size());
+		for (std::size_t c{}; header_.components() > c; ++c) {
+			auto const s = component<S>(c);
+			for (std::size_t i{}; s.size() > i; ++i) {
+				std::memcpy(reinterpret_cast<char*>(&v[i]) + c * sizeof(S), &s[i], sizeof(S));
+			}
+		}
+		return v;
+	}
+
+ private:
+	/*!
+	 * @brief The address `offset` bytes into the data.
+	 */
+	[[nodiscard]] void const* data(std::uint64_t offset) const noexcept
+	{
+		return file_.data() + header_.offset + offset;
+	}
+
+	void validate(std::filesystem::path const& path)
+	{
+		auto const fail = [&path](char const* what) {
+			throw std::runtime_error("'" + path.string() + "' is not a valid array file: " +
+			                         what);
+		};
+
+		if (sizeof(ArrayHeader) > file_.size()) {
+			fail("too small");
+		}
+		std::memcpy(&header_, file_.data(), sizeof(ArrayHeader));
+
+		if (ArrayHeader::MAGIC != header_.magic) {
+			fail("wrong magic");
+		}
+		if (0 == header_.version || ArrayHeader::VERSION < header_.version) {
+			fail("unsupported version");
+		}
+		if (ArrayKind::QUAT_TRANSFORM < header_.kind ||
+		    ScalarType::DOUBLE < header_.scalar || ArrayLayout::SOA < header_.layout) {
+			fail("unknown element type");
+		}
+		if (0 != header_.offset % ArrayHeader::ALIGNMENT) {
+			fail("misaligned data");
+		}
+
+		if (file_.size() < header_.offset) {
+			fail("truncated");
+		}
+
+		// Sizes are checked by division, a crafted header must not overflow a product
+		std::uint64_t const scalar     = detail::scalarSize(header_.scalar);
+		std::uint64_t const components = header_.components();
+		std::uint64_t const available  = file_.size() - header_.offset;
+		if (0 == components) {
+			fail("no components");
+		}
+		if (ArrayLayout::AOS == header_.layout) {
+			if (0 == header_.stride || 0 != header_.stride % scalar ||
+			    components != header_.stride / scalar) {
+				fail("wrong stride");
+			}
+			if (header_.size > available / header_.stride) {
+				fail("truncated");
+			}
+		} else {
+			if (header_.size > header_.stride / scalar) {
+				fail("wrong stride");
+			}
+			// Every array but the last takes `stride` bytes, the last `size * scalar`
+			if (0 != header_.stride) {
+				if (components - 1 > available / header_.stride) {
+					fail("truncated");
+				}
+				std::uint64_t const last = available - (components - 1) * header_.stride;
+				if (header_.size > last / scalar) {
+					fail("truncated");
+				}
+			}
+		}
+	}
+
+ private:
+	MappedFile  file_;
+	ArrayHeader header_{};
+};
+}  // namespace ufo
+
+#endif  // UFO_MATH_ARRAY_FILE_HPP
@@ -0,0 +1,899 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_BVH_HPP
+#define UFO_MATH_BVH_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/aabb.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/packet.hpp>
+#include <ufo/math/ray.hpp>
+#include <ufo/math/triangle.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Result of a closest point query.
+ *
+ * `distance` is infinite if nothing was found within the search radius.
+ */
+template <class T = float>
+struct NearestHit {
+	Vec3<T>     point{};
+	T           distance = std::numeric_limits<T>::infinity();
+	std::size_t index    = std::numeric_limits<std::size_t>::max();
+
+	[[nodiscard]] constexpr explicit operator bool() const noexcept
+	{
+		return std::numeric_limits<T>::infinity() != distance;
+	}
+};
+
+namespace detail
+{
+template <class T>
+[[nodiscard]] constexpr AABB<3, T> bvhBounds(Vec3<T> const& p) noexcept
+{
+	return AABB<3, T>(p);
+}
+
+template <class T>
+[[nodiscard]] constexpr AABB<3, T> bvhBounds(AABB<3, T> const& a) noexcept
+{
+	return a;
+}
+
+template <class T>
+[[nodiscard]] constexpr AABB<3, T> bvhBounds(Triangle<T> const& t) noexcept
+{
+	return bounds(t);
+}
+
+template <class T>
+[[nodiscard]] constexpr Vec3<T> bvhClosestPoint(Vec3<T> const& p, Vec3<T> const&) noexcept
+{
+	return p;
+}
+
+template <class T>
+[[nodiscard]] constexpr Vec3<T> bvhClosestPoint(AABB<3, T> const& a, Vec3<T> const& q)
+{
+	return closestPoint(a, q);
+}
+
+template <class T>
+[[nodiscard]] constexpr Vec3<T> bvhClosestPoint(Triangle<T> const& t, Vec3<T> const& q)
+{
+	return closestPoint(t, q);
+}
+}  // namespace detail
+
+/*!
+ * @brief Bounding volume hierarchy over points (`Vec3`), boxes (`AABB<3, T>`) or
+ * triangles (`Triangle`).
+ *
+ * Built top-down with the surface area heuristic evaluated over 16 bins per axis. The
+ * nodes are stored depth-first in one array, with the left child directly after its
+ * parent, and the primitives are copied in leaf order so that a leaf reads one contiguous
+ * range of memory.
+ *
+ * Supports closest hit ray queries (boxes and triangles), one ray at a time or in packets,
+ * and closest point queries. Reported indices refer to the order of the primitives the
+ * hierarchy was built from.
+ */
+template <class Primitive>
+class BVH
+{
+ public:
+	using primitive_type = Primitive;
+	using value_type     = typename Primitive::value_type;
+	using size_type      = std::size_t;
+
+	/*!
+	 * @brief 32 bytes for `float`, two nodes per cache line.
+	 */
+	struct Node {
+		Vec3<value_type> min;
+		Vec3<value_type> max;
+		// Leaf: index of the first primitive, inner node: index of the right child
+		std::uint32_t offset;
+		// Number of primitives, zero for inner nodes
+		std::uint16_t count;
+		// Axis the node was split along
+		std::uint16_t axis;
+
+		[[nodiscard]] constexpr bool isLeaf() const noexcept { return 0 != count; }
+	};
+
+	static constexpr std::size_t num_bins      = 16;
+	static constexpr std::size_t max_leaf_size = 16;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	BVH() = default;
+
+	template <class InputIt>
+	BVH(InputIt first, InputIt last) : primitives_(first, last)
+	{
+		build(detail::SequentialForEach{});
+	}
+
+	/*!
+	 * @brief Builds the hierarchy in parallel, the result is identical to the sequential
+	 * build.
+	 */
+	template <
+	    class ExecutionPolicy, class RandomIt,
+	    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+	BVH(ExecutionPolicy&& policy, RandomIt first, RandomIt last) : primitives_(first, last)
+	{
+		build(detail::PolicyForEach<ExecutionPolicy>{policy});
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Accessors                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] std::vector<Node> const& nodes() const noexcept { return nodes_; }
+
+	/*!
+	 * @brief The primitives in leaf order.
+	 */
+	[[nodiscard]] std::vector<Primitive> const& primitives() const noexcept
+	{
+		return primitives_;
+	}
+
+	/*!
+	 * @brief For each primitive in leaf order, its index in the input.
+	 */
+	[[nodiscard]] std::vector<std::uint32_t> const& indices() const noexcept
+	{
+		return indices_;
+	}
+
+	[[nodiscard]] size_type size() const noexcept { return primitives_.size(); }
+
+	[[nodiscard]] bool empty() const noexcept { return primitives_.empty(); }
+
+	[[nodiscard]] AABB<3, value_type> bounds() const noexcept
+	{
+		return empty() ? AABB<3, value_type>()
+		               : AABB<3, value_type>(nodes_[0].min, nodes_[0].max);
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                     Ray queries                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	/*!
+	 * @brief Closest primitive hit by `ray` with distance in (`t_min`, `t_max`).
+	 */
+	[[nodiscard]] RayHit<value_type> intersect(
+	    Ray<value_type> const& ray, value_type t_min = value_type(0),
+	    value_type t_max = std::numeric_limits<value_type>::infinity()) const
+	{
+		using T = value_type;
+
+		RayHit<T> hit;
+		if (empty()) {
+			return hit;
+		}
+
+		Vec3<T> const inv = T(1) / ray.direction;
+		T             best = t_max;
+
+		std::array<std::uint32_t, max_depth + 1> stack;
+		std::size_t                              top{};
+		stack[top++] = 0;
+
+		while (0 != top) {
+			Node const& node = nodes_[stack[--top]];
+
+			if (!slab(node, ray.origin, inv, t_min, best)) {
+				continue;
+			}
+
+			if (node.isLeaf()) {
+				std::size_t const end = std::size_t(node.offset) + node.count;
+				for (std::size_t i = node.offset; end != i; ++i) {
+					RayHit<T> h = ufo::intersect(ray, primitives_[i], t_min, best);
+					if (best > h.distance) {
+						best      = h.distance;
+						hit       = h;
+						hit.index = indices_[i];
+					}
+				}
+			} else {
+				std::uint32_t const self  = static_cast<std::uint32_t>(&node - nodes_.data());
+				std::uint32_t       near  = self + 1;
+				std::uint32_t       far   = node.offset;
+				if (T(0) > ray.direction[node.axis]) {
+					std::swap(near, far);
+				}
+				stack[top++] = far;
+				stack[top++] = near;
+			}
+		}
+
+		return hit;
+	}
+
+	/*!
+	 * @brief Closest hits for the `N` rays of `rays`, updating the lanes of `hits` where a
+	 * closer hit is found.
+	 *
+	 * A node is visited if any of the lanes hit it, so this pays off for coherent rays (for
+	 * example neighbouring beams of a sensor).
+	 */
+	template <std::size_t N>
+	void intersect(RayPacket<value_type, N> const& rays, RayHitPacket<value_type, N>& hits,
+	               value_type t_min = value_type(0)) const
+	{
+		using T = value_type;
+
+		if (empty()) {
+			return;
+		}
+
+		RayPacket<T, N> inv;
+		for (std::size_t i{}; N > i; ++i) {
+			inv.dx[i] = T(1) / rays.dx[i];
+			inv.dy[i] = T(1) / rays.dy[i];
+			inv.dz[i] = T(1) / rays.dz[i];
+		}
+
+		std::array<std::uint32_t, max_depth + 1> stack;
+		std::size_t                              top{};
+		stack[top++] = 0;
+
+		while (0 != top) {
+			Node const& node = nodes_[stack[--top]];
+
+			if (!slab(node, rays, inv, hits, t_min)) {
+				continue;
+			}
+
+			if (node.isLeaf()) {
+				std::size_t const end = std::size_t(node.offset) + node.count;
+				for (std::size_t i = node.offset; end != i; ++i) {
+					if constexpr (std::is_same_v<Triangle<T>, Primitive>) {
+						ufo::intersect(rays, primitives_[i], hits, indices_[i], t_min);
+					} else {
+						for (std::size_t j{}; N > j; ++j) {
+							RayHit<T> h =
+							    ufo::intersect(rays.get(j), primitives_[i], t_min, hits.distance[j]);
+							if (hits.distance[j] > h.distance) {
+								hits.distance[j] = h.distance;
+								hits.u[j]        = h.u;
+								hits.v[j]        = h.v;
+								hits.index[j]    = indices_[i];
+							}
+						}
+					}
+				}
+			} else {
+				std::uint32_t const self = static_cast<std::uint32_t>(&node - nodes_.data());
+				std::uint32_t       near = self + 1;
+				std::uint32_t       far  = node.offset;
+				T const d = 0 == node.axis ? rays.dx[0] : (1 == node.axis ? rays.dy[0] : rays.dz[0]);
+				if (T(0) > d) {
+					std::swap(near, far);
+				}
+				stack[top++] = far;
+				stack[top++] = near;
+			}
+		}
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Point queries                                    |
+	|                                                                                     |
+	**************************************************************************************/
+
+	/*!
+	 * @brief Point on the primitives closest to `query`, searching within `max_distance`.
+	 */
+	[[nodiscard]] NearestHit<value_type> nearest(
+	    Vec3<value_type> const& query,
+	    value_type max_distance = std::numeric_limits<value_type>::infinity()) const
+	{
+		using T = value_type;
+
+		NearestHit<T> res;
+		if (empty()) {
+			return res;
+		}
+
+		T best = std::numeric_limits<T>::infinity() == max_distance
+		             ? max_distance
+		             : max_distance * max_distance;
+
+		bool found = false;
+
+		std::array<std::uint32_t, max_depth + 1> stack;
+		std::size_t                              top{};
+		if (best >= distanceSquared(nodes_[0], query)) {
+			stack[top++] = 0;
+		}
+
+		while (0 != top) {
+			std::uint32_t const i    = stack[--top];
+			Node const&         node = nodes_[i];
+
+			if (node.isLeaf()) {
+				std::size_t const end = std::size_t(node.offset) + node.count;
+				for (std::size_t j = node.offset; end != j; ++j) {
+					Vec3<T> p  = detail::bvhClosestPoint(primitives_[j], query);
+					T       d2 = ufo::distanceSquared(p, query);
+					if (best > d2 || (!found && best == d2)) {
+						best      = d2;
+						res.point = p;
+						res.index = indices_[j];
+						found     = true;
+					}
+				}
+				continue;
+			}
+
+			std::uint32_t near = i + 1;
+			std::uint32_t far  = node.offset;
+			T             dn   = distanceSquared(nodes_[near], query);
+			T             df   = distanceSquared(nodes_[far], query);
+			if (df < dn) {
+				std::swap(near, far);
+				std::swap(dn, df);
+			}
+			if (best >= df) {
+				stack[top++] = far;
+			}
+			if (best >= dn) {
+				stack[top++] = near;
+			}
+		}
+
+		if (found) {
+			res.distance = std::sqrt(best);
+		}
+		return res;
+	}
+
+ private:
+	// The build falls back to median splits below this depth, which bounds the depth for
+	// up to 2^32 primitives and thereby the size of the traversal stacks
+	static constexpr std::size_t max_depth        = 96;
+	static constexpr std::size_t sah_depth        = max_depth - 33;
+	static constexpr std::size_t parallel_binning = std::size_t(1) << 15;
+	static constexpr std::size_t chunk_size       = std::size_t(1) << 14;
+
+	struct BuildNode {
+		AABB<3, value_type> bounds;
+		std::uint32_t       begin;
+		std::uint32_t       end;
+		std::uint32_t       left{};
+		std::uint32_t       right{};
+		std::uint16_t       axis{};
+		std::uint16_t       depth{};
+	};
+
+	struct Bins {
+		std::array<std::array<AABB<3, value_type>, num_bins>, 3> bounds{};
+		std::array<std::array<std::uint32_t, num_bins>, 3>        count{};
+
+		void merge(Bins const& other) noexcept
+		{
+			for (std::size_t a{}; 3 > a; ++a) {
+				for (std::size_t b{}; num_bins > b; ++b) {
+					bounds[a][b].expand(other.bounds[a][b]);
+					count[a][b] += other.count[a][b];
+				}
+			}
+		}
+	};
+
+	struct Split {
+		bool                leaf = true;
+		std::uint16_t       axis{};
+		std::uint32_t       mid{};
+		AABB<3, value_type> left;
+		AABB<3, value_type> right;
+	};
+
+	[[nodiscard]] static value_type distanceSquared(Node const&             node,
+	                                                Vec3<value_type> const& q) noexcept
+	{
+		return ufo::distanceSquared(clamp(q, node.min, node.max), q);
+	}
+
+	[[nodiscard]] static bool slab(Node const& node, Vec3<value_type> const& o,
+	                               Vec3<value_type> const& inv, value_type t_min,
+	                               value_type t_max) noexcept
+	{
+		for (std::size_t i{}; 3 > i; ++i) {
+			value_type t0 = (node.min[i] - o[i]) * inv[i];
+			value_type t1 = (node.max[i] - o[i]) * inv[i];
+			t_min         = std::max(t_min, std::min(t0, t1));
+			t_max         = std::min(t_max, std::max(t0, t1));
+		}
+		return t_min <= t_max;
+	}
+
+	template <std::size_t N>
+	[[nodiscard]] static bool slab(Node const& node, RayPacket<value_type, N> const& rays,
+	                               RayPacket<value_type, N> const&    inv,
+	                               RayHitPacket<value_type, N> const& hits,
+	                               value_type                         t_min) noexcept
+	{
+		using T = value_type;
+
+		// Branch-free over the lanes, the bitwise or keeps the reduction vectorized
+		unsigned any{};
+		for (std::size_t i{}; N > i; ++i) {
+			T x0 = (node.min.x - rays.ox[i]) * inv.dx[i];
+			T x1 = (node.max.x - rays.ox[i]) * inv.dx[i];
+			T y0 = (node.min.y - rays.oy[i]) * inv.dy[i];
+			T y1 = (node.max.y - rays.oy[i]) * inv.dy[i];
+			T z0 = (node.min.z - rays.oz[i]) * inv.dz[i];
+			T z1 = (node.max.z - rays.oz[i]) * inv.dz[i];
+
+			T lo = std::max(std::max(t_min, std::min(x0, x1)),
+			                std::max(std::min(y0, y1), std::min(z0, z1)));
+			T hi = std::min(std::min(hits.distance[i], std::max(x0, x1)),
+			                std::min(std::max(y0, y1), std::max(z0, z1)));
+			any |= static_cast<unsigned>(lo <= hi);
+		}
+		return 0 != any;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                        Build                                        |
+	|                                                                                     |
+	**************************************************************************************/
+
+	template <class ForEach>
+	void build(ForEach for_each)
+	{
+		using T = value_type;
+
+		std::size_t const n = primitives_.size();
+		assert(std::numeric_limits<std::uint32_t>::max() > n);
+		if (0 == n) {
+			return;
+		}
+
+		std::vector<AABB<3, T>> boxes(n);
+		std::vector<Vec3<T>>    centers(n);
+		indices_.resize(n);
+		std::size_t const chunks = (n + chunk_size - 1) / chunk_size;
+		for_each(0, chunks, [&](std::size_t c) {
+			std::size_t const end = std::min(n, (c + 1) * chunk_size);
+			for (std::size_t i = c * chunk_size; end != i; ++i) {
+				boxes[i]    = detail::bvhBounds(primitives_[i]);
+				centers[i]  = boxes[i].center();
+				indices_[i] = static_cast<std::uint32_t>(i);
+			}
+		});
+
+		std::vector<BuildNode> tree;
+		tree.push_back({bounds(boxes, 0, n), 0, static_cast<std::uint32_t>(n)});
+
+		// Breadth first, one level at a time. Large nodes are handled one by one with the
+		// binning spread over the threads, the rest of the level is split in parallel with
+		// one node per task.
+		std::vector<std::uint32_t> level{0};
+		std::vector<Split>         splits;
+		while (!level.empty()) {
+			splits.assign(level.size(), Split{});
+
+			for (std::size_t i{}; level.size() > i; ++i) {
+				BuildNode const& node = tree[level[i]];
+				if (parallel_binning <= node.end - node.begin) {
+					splits[i] = split(for_each, node, boxes, centers);
+				}
+			}
+
+			for_each(0, level.size(), [&](std::size_t i) {
+				BuildNode const& node = tree[level[i]];
+				if (parallel_binning > node.end - node.begin) {
+					splits[i] = split(detail::SequentialForEach{}, node, boxes, centers);
+				}
+			});
+
+			std::vector<std::uint32_t> next;
+			for (std::size_t i{}; level.size() > i; ++i) {
+				Split const& s = splits[i];
+				if (s.leaf) {
+					continue;
+				}
+
+				std::uint32_t const self  = level[i];
+				std::uint32_t const left  = static_cast<std::uint32_t>(tree.size());
+				std::uint32_t const right = left + 1;
+				auto const          depth = static_cast<std::uint16_t>(tree[self].depth + 1);
+
+				tree[self].left  = left;
+				tree[self].right = right;
+				tree[self].axis  = s.axis;
+				tree.push_back({s.left, tree[self].begin, s.mid, 0, 0, 0, depth});
+				tree.push_back({s.right, s.mid, tree[self].end, 0, 0, 0, depth});
+				next.push_back(left);
+				next.push_back(right);
+			}
+			level = std::move(next);
+		}
+
+		nodes_.clear();
+		nodes_.reserve(tree.size());
+		flatten(tree, 0);
+
+		std::vector<Primitive> ordered(n);
+		for_each(0, chunks, [&](std::size_t c) {
+			std::size_t const end = std::min(n, (c + 1) * chunk_size);
+			for (std::size_t i = c * chunk_size; end != i; ++i) {
+				ordered[i] = primitives_[indices_[i]];
+			}
+		});
+		primitives_ = std::move(ordered);
+	}
+
+	[[nodiscard]] static AABB<3, value_type> bounds(std::vector<AABB<3, value_type>> const& boxes,
+	                                                std::size_t first, std::size_t last)
+	{
+		AABB<3, value_type> res;
+		for (; last != first; ++first) {
+			res.expand(boxes[first]);
+		}
+		return res;
+	}
+
+	[[nodiscard]] static std::size_t bin(value_type c, value_type lo, value_type scale) noexcept
+	{
+		auto b = static_cast<std::size_t>(std::max(value_type(0), (c - lo) * scale));
+		return std::min(num_bins - 1, b);
+	}
+
+	template <class ForEach>
+	[[nodiscard]] Split split(ForEach for_each, BuildNode const& node,
+	                          std::vector<AABB<3, value_type>> const& boxes,
+	                          std::vector<Vec3<value_type>> const&    centers)
+	{
+		using T = value_type;
+
+		Split res;
+
+		std::size_t const begin = node.begin;
+		std::size_t const end   = node.end;
+		std::size_t const count = end - begin;
+		if (1 >= count) {
+			return res;
+		}
+
+		std::size_t const chunks = (count + chunk_size - 1) / chunk_size;
+
+		// Bounds of the centroids, which decide the binning
+		auto centroidBounds = [&](std::size_t c) {
+			AABB<3, T>        res;
+			std::size_t const last = std::min(end, begin + (c + 1) * chunk_size);
+			for (std::size_t i = begin + c * chunk_size; last != i; ++i) {
+				res.expand(centers[indices_[i]]);
+			}
+			return res;
+		};
+
+		AABB<3, T> centroid_bounds;
+		if (1 == chunks) {
+			centroid_bounds = centroidBounds(0);
+		} else {
+			std::vector<AABB<3, T>> cb(chunks);
+			for_each(0, chunks, [&](std::size_t c) { cb[c] = centroidBounds(c); });
+			for (auto const& b : cb) {
+				centroid_bounds.expand(b);
+			}
+		}
+
+		Vec3<T> const extent = centroid_bounds.size();
+		Vec3<T>       scale;
+		for (std::size_t a{}; 3 > a; ++a) {
+			scale[a] = T(0) < extent[a] ? static_cast<T>(num_bins) / extent[a] : T(0);
+		}
+
+		if (sah_depth <= node.depth || T(0) == max(extent)) {
+			if (max_leaf_size >= count) {
+				return res;
+			}
+			// Median split on the widest axis, also handles coincident centroids
+			std::uint16_t axis = 0;
+			for (std::uint16_t a = 1; 3 > a; ++a) {
+				axis = extent[a] > extent[axis] ? a : axis;
+			}
+			std::size_t const mid = begin + count / 2;
+			std::nth_element(indices_.begin() + static_cast<std::ptrdiff_t>(begin),
+			                 indices_.begin() + static_cast<std::ptrdiff_t>(mid),
+			                 indices_.begin() + static_cast<std::ptrdiff_t>(end),
+			                 [&](std::uint32_t x, std::uint32_t y) {
+				                 return centers[x][axis] < centers[y][axis] ||
+				                        (centers[x][axis] == centers[y][axis] && x < y);
+			                 });
+			res.leaf  = false;
+			res.axis  = axis;
+			res.mid   = static_cast<std::uint32_t>(mid);
+			res.left  = bounds(boxes, indices_, begin, mid);
+			res.right = bounds(boxes, indices_, mid, end);
+			return res;
+		}
+
+		auto binChunk = [&](std::size_t c, Bins& bins) {
+			std::size_t const last = std::min(end, begin + (c + 1) * chunk_size);
+			for (std::size_t i = begin + c * chunk_size; last != i; ++i) {
+				std::uint32_t const p = indices_[i];
+				for (std::size_t a{}; 3 > a; ++a) {
+					std::size_t b = bin(centers[p][a], centroid_bounds.min[a], scale[a]);
+					bins.bounds[a][b].expand(boxes[p]);
+					++bins.count[a][b];
+				}
+			}
+		};
+
+		Bins bins;
+		if (1 == chunks) {
+			binChunk(0, bins);
+		} else {
+			std::vector<Bins> chunk_bins(chunks);
+			for_each(0, chunks, [&](std::size_t c) { binChunk(c, chunk_bins[c]); });
+			for (auto const& b : chunk_bins) {
+				bins.merge(b);
+			}
+		}
+
+		// Sweep the bins, cost = area(L) * |L| + area(R) * |R|
+		T             best_cost = std::numeric_limits<T>::infinity();
+		std::size_t   best_bin{};
+		std::uint16_t best_axis{};
+		for (std::uint16_t a{}; 3 > a; ++a) {
+			if (T(0) == scale[a]) {
+				continue;
+			}
+
+			std::array<T, num_bins> right_cost{};
+			AABB<3, T>              rb;
+			std::size_t             rc{};
+			for (std::size_t b = num_bins - 1; 0 < b; --b) {
+				rb.expand(bins.bounds[a][b]);
+				rc += bins.count[a][b];
+				right_cost[b] = 0 == rc ? T(0) : area(rb) * static_cast<T>(rc);
+			}
+
+			AABB<3, T>  lb;
+			std::size_t lc{};
+			for (std::size_t b{}; num_bins - 1 > b; ++b) {
+				lb.expand(bins.bounds[a][b]);
+				lc += bins.count[a][b];
+				if (0 == lc || count == lc) {
+					continue;
+				}
+				T cost = area(lb) * static_cast<T>(lc) + right_cost[b + 1];
+				if (best_cost > cost) {
+					best_cost = cost;
+					best_bin  = b;
+					best_axis = a;
+				}
+			}
+		}
+
+		// Traversal is taken to cost as much as one primitive test
+		T const node_area = area(node.bounds);
+		T const leaf_cost = node_area * static_cast<T>(count);
+		if (max_leaf_size >= count &&
+		    (std::numeric_limits<T>::infinity() == best_cost ||
+		     leaf_cost <= node_area + best_cost)) {
+			return res;
+		}
+
+		if (std::numeric_limits<T>::infinity() == best_cost) {
+			// Every axis puts all centroids in one bin, split at the median instead
+			BuildNode deeper = node;
+			deeper.depth     = static_cast<std::uint16_t>(sah_depth);
+			return split(detail::SequentialForEach{}, deeper, boxes, centers);
+		}
+
+		T const    lo = centroid_bounds.min[best_axis];
+		T const    sc = scale[best_axis];
+		auto const it = std::partition(indices_.begin() + static_cast<std::ptrdiff_t>(begin),
+		                               indices_.begin() + static_cast<std::ptrdiff_t>(end),
+		                               [&](std::uint32_t p) {
+			                               return best_bin >= bin(centers[p][best_axis], lo, sc);
+		                               });
+
+		res.leaf = false;
+		res.axis = best_axis;
+		res.mid  = static_cast<std::uint32_t>(it - indices_.begin());
+		for (std::size_t b{}; num_bins > b; ++b) {
+			(best_bin >= b ? res.left : res.right).expand(bins.bounds[best_axis][b]);
+		}
+		return res;
+	}
+
+	[[nodiscard]] static AABB<3, value_type> bounds(
+	    std::vector<AABB<3, value_type>> const& boxes,
+	    std::vector<std::uint32_t> const& indices, std::size_t first, std::size_t last)
+	{
+		AABB<3, value_type> res;
+		for (; last != first; ++first) {
+			res.expand(boxes[indices[first]]);
+		}
+		return res;
+	}
+
+	std::uint32_t flatten(std::vector<BuildNode> const& tree, std::uint32_t i)
+	{
+		BuildNode const&    b    = tree[i];
+		std::uint32_t const self = static_cast<std::uint32_t>(nodes_.size());
+		nodes_.push_back({b.bounds.min, b.bounds.max, b.begin,
+		                  static_cast<std::uint16_t>(b.end - b.begin), b.axis});
+
+		if (0 != b.left) {
+			nodes_[self].count = 0;
+			flatten(tree, b.left);
+			nodes_[self].offset = flatten(tree, b.right);
+		}
+		return self;
+	}
+
+ private:
+	std::vector<Node>          nodes_;
+	std::vector<Primitive>     primitives_;
+	std::vector<std::uint32_t> indices_;
+};
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Batch                                        |
+|                                                                                     |
+**************************************************************************************/
+
+namespace detail
+{
+template <class Primitive, class RandomIt1, class RandomIt2>
+void intersectBlock(BVH<Primitive> const& bvh, RandomIt1 first, std::size_t count,
+                    RandomIt2 d_first)
+{
+	using T                 = typename Primitive::value_type;
+	constexpr std::size_t N = packet_size_v<T>;
+
+	RayPacket<T, N> rays{};
+	for (std::size_t i{}; count > i; ++i) {
+		rays.set(i, first[i]);
+	}
+	// Unused lanes get a ray that misses everything
+	for (std::size_t i = count; N > i; ++i) {
+		rays.set(i, Ray<T>(Vec3<T>(std::numeric_limits<T>::infinity()), Vec3<T>(T(1))));
+	}
+
+	RayHitPacket<T, N> hits;
+	bvh.intersect(rays, hits);
+
+	for (std::size_t i{}; count > i; ++i) {
+		d_first[i] = hits.get(i);
+	}
+}
+}  // namespace detail
+
+/*!
+ * @brief Closest hits for the rays in [`first`, `last`), traced in packets.
+ *
+ * Rays next to each other in the input share a packet, so order them coherently (e.g.,
+ * scan line by scan line) for the best performance.
+ */
+template <class Primitive, class RandomIt1, class RandomIt2>
+RandomIt2 intersect(BVH<Primitive> const& bvh, RandomIt1 first, RandomIt1 last,
+                    RandomIt2 d_first)
+{
+	constexpr std::size_t N = packet_size_v<typename Primitive::value_type>;
+
+	std::size_t const size = std::distance(first, last);
+	for (std::size_t i{}; size > i; i += N) {
+		detail::intersectBlock(bvh, first + i, std::min(N, size - i), d_first + i);
+	}
+	return d_first + size;
+}
+
+template <
+    class ExecutionPolicy, class Primitive, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 intersect(ExecutionPolicy&& policy, BVH<Primitive> const& bvh, RandomIt1 first,
+                    RandomIt1 last, RandomIt2 d_first)
+{
+	constexpr std::size_t N = packet_size_v<typename Primitive::value_type>;
+
+	std::size_t const size   = std::distance(first, last);
+	std::size_t const blocks = (size + N - 1) / N;
+	detail::forEach(std::forward<ExecutionPolicy>(policy), 0, blocks, [&](std::size_t b) {
+		std::size_t const i = b * N;
+		detail::intersectBlock(bvh, first + i, std::min(N, size - i), d_first + i);
+	});
+	return d_first + size;
+}
+
+template <class Primitive, class InputIt, class OutputIt>
+OutputIt nearest(BVH<Primitive> const& bvh, InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [&bvh](auto const& q) { return bvh.nearest(q); });
+}
+
+template <
+    class ExecutionPolicy, class Primitive, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 nearest(ExecutionPolicy&& policy, BVH<Primitive> const& bvh, RandomIt1 first,
+                  RandomIt1 last, RandomIt2 d_first)
+{
+	return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                         [&bvh](auto const& q) { return bvh.nearest(q); });
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_BVH_HPP
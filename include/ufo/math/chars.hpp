@@ -0,0 +1,261 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_CHARS_HPP
+#define UFO_MATH_CHARS_HPP
+
+// UFO
+#include <ufo/math/mat.hpp>
+#include <ufo/math/quat.hpp>
+#include <ufo/math/transform.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+namespace ufo
+{
+namespace detail
+{
+[[nodiscard]] constexpr bool isSeparator(char c) noexcept
+{
+	return ' ' == c || '\t' == c || ',' == c;
+}
+
+[[nodiscard]] constexpr char const* skipSeparators(char const* first,
+                                                   char const* last) noexcept
+{
+	for (; last != first && isSeparator(*first); ++first) {
+	}
+	return first;
+}
+
+/*!
+ * @brief Writes `get(0)`, ..., `get(n - 1)` separated by single spaces.
+ */
+template <class Get>
+std::to_chars_result toCharsSequence(char* first, char* last, std::size_t n, Get get)
+{
+	for (std::size_t i{}; n > i; ++i) {
+		if (0 != i) {
+			if (last == first) {
+				return {last, std::errc::value_too_large};
+			}
+			*first++ = ' ';
+		}
+		auto const res = std::to_chars(first, last, get(i));
+		if (std::errc() != res.ec) {
+			return res;
+		}
+		first = res.ptr;
+	}
+	return {first, std::errc()};
+}
+
+/*!
+ * @brief Reads `n` numbers into `get(0)`, ..., `get(n - 1)`, each preceded by any
+ * number of spaces, tabs and commas.
+ */
+template <class Get>
+std::from_chars_result fromCharsSequence(char const* first, char const* last,
+                                         std::size_t n, Get get)
+{
+	for (std::size_t i{}; n > i; ++i) {
+		auto const res = std::from_chars(skipSeparators(first, last), last, get(i));
+		if (std::errc() != res.ec) {
+			return res;
+		}
+		first = res.ptr;
+	}
+	return {first, std::errc()};
+}
+
+/*!
+ * @brief Reads into a copy of `value` and only assigns it on success.
+ */
+template <class T, class Get>
+std::from_chars_result fromCharsInto(char const* first, char const* last, T& value,
+                                     std::size_t n, Get get)
+{
+	T    tmp = value;
+	auto res = fromCharsSequence(first, last, n, [&tmp, &get](std::size_t i) -> auto& {
+		return get(tmp, i);
+	});
+	if (std::errc() == res.ec) {
+		value = tmp;
+	}
+	return res;
+}
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                      To chars                                       |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Writes the components of `v` to [`first`, `last`) separated by spaces, using
+ * `std::to_chars`, so floating point values are written in the shortest form that reads
+ * back exactly. Like `std::to_chars` nothing is null terminated.
+ */
+template <std::size_t Dim, class T>
+std::to_chars_result toChars(char* first, char* last, Vec<Dim, T> const& v)
+{
+	return detail::toCharsSequence(first, last, Dim, [&v](std::size_t i) { return v[i]; });
+}
+
+/*!
+ * @brief Writes the elements of `m` row by row, in the order they are read.
+ */
+template <std::size_t Cols, std::size_t Rows, class T>
+std::to_chars_result toChars(char* first, char* last, Mat<Cols, Rows, T> const& m)
+{
+	return detail::toCharsSequence(first, last, Cols * Rows,
+	                               [&m](std::size_t i) { return m[i % Cols][i / Cols]; });
+}
+
+/*!
+ * @brief Writes `w x y z`.
+ */
+template <class T>
+std::to_chars_result toChars(char* first, char* last, Quat<T> const& q)
+{
+	return detail::toCharsSequence(first, last, 4, [&q](std::size_t i) {
+		return 0 == i ? q.w : (1 == i ? q.x : (2 == i ? q.y : q.z));
+	});
+}
+
+/*!
+ * @brief Writes the `Dim` by `Dim + 1` matrix `[rotation | translation]` row by row,
+ * which for `Transform3` is a line of a KITTI pose file.
+ */
+template <std::size_t Dim, class T>
+std::to_chars_result toChars(char* first, char* last, Transform<Dim, T> const& t)
+{
+	return detail::toCharsSequence(first, last, Dim * (Dim + 1), [&t](std::size_t i) {
+		std::size_t const row = i / (Dim + 1);
+		std::size_t const col = i % (Dim + 1);
+		return Dim == col ? t.translation[row] : t.rotation[col][row];
+	});
+}
+
+/*!
+ * @brief `toChars` into a string.
+ */
+template <class T>
+[[nodiscard]] std::string toString(T const& value)
+{
+	std::string s(256, '\0');
+	for (;;) {
+		auto const res = toChars(s.data(), s.data() + s.size(), value);
+		if (std::errc() == res.ec) {
+			s.resize(static_cast<std::size_t>(res.ptr - s.data()));
+			return s;
+		}
+		s.resize(2 * s.size());
+	}
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                     From chars                                      |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Reads the components of `v` from [`first`, `last`) with `std::from_chars`.
+ *
+ * Components may be preceded by any number of spaces, tabs and commas, so this reads
+ * what `toChars` writes as well as CSV fields. On error `v` is not modified and the
+ * result is that of the `std::from_chars` call that failed.
+ */
+template <std::size_t Dim, class T>
+std::from_chars_result fromChars(char const* first, char const* last, Vec<Dim, T>& v)
+{
+	return detail::fromCharsInto(first, last, v, Dim,
+	                             [](auto& x, std::size_t i) -> T& { return x[i]; });
+}
+
+/*!
+ * @brief Reads the elements of `m` row by row.
+ */
+template <std::size_t Cols, std::size_t Rows, class T>
+std::from_chars_result fromChars(char const* first, char const* last,
+                                 Mat<Cols, Rows, T>& m)
+{
+	return detail::fromCharsInto(
+	    first, last, m, Cols * Rows,
+	    [](auto& x, std::size_t i) -> T& { return x[i % Cols][i / Cols]; });
+}
+
+/*!
+ * @brief Reads `w x y z`.
+ */
+template <class T>
+std::from_chars_result fromChars(char const* first, char const* last, Quat<T>& q)
+{
+	return detail::fromCharsInto(first, last, q, 4, [](auto& x, std::size_t i) -> T& {
+		return 0 == i ? x.w : (1 == i ? x.x : (2 == i ? x.y : x.z));
+	});
+}
+
+/*!
+ * @brief Reads the `Dim` by `Dim + 1` matrix `[rotation | translation]` row by row, such
+ * as a line of a KITTI pose file or a projection matrix of a KITTI calibration file.
+ */
+template <std::size_t Dim, class T>
+std::from_chars_result fromChars(char const* first, char const* last,
+                                 Transform<Dim, T>& t)
+{
+	return detail::fromCharsInto(
+	    first, last, t, Dim * (Dim + 1), [](auto& x, std::size_t i) -> T& {
+		    std::size_t const row = i / (Dim + 1);
+		    std::size_t const col = i % (Dim + 1);
+		    return Dim == col ? x.translation[row] : x.rotation[col][row];
+	    });
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_CHARS_HPP
@@ -0,0 +1,242 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_COMPRESSED_QUAT_HPP
+#define UFO_MATH_COMPRESSED_QUAT_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/numbers.hpp>
+#include <ufo/math/quat.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief Unit quaternion compressed with the "smallest three" method into `Bits` bits.
+ *
+ * The index of the component with the largest magnitude is stored in 2 bits, and the
+ * other three components, which lie in [-1/sqrt(2), 1/sqrt(2)], are stored with
+ * `(Bits - 2) / 3` bits each. The largest component is reconstructed from the unit norm.
+ * The quaternion is negated if the largest component is negative, so the dropped
+ * component is always positive and its sign need not be stored.
+ *
+ * This rule deliberately replaces the sign handling of `slerp`, which negates one of two
+ * quaternions when their dot product is negative. A single quaternion has nothing to
+ * compare against, so it needs a canonical sign of its own, and making the largest
+ * component positive is the choice that saves the sign bit. Both `q` and `-q` are the
+ * same rotation, so `decompress` may return `-q` for `q`, and `slerp` between
+ * decompressed quaternions still takes the short path.
+ *
+ * | Type               | Bits per component | Max component error | Max angle error |
+ * | ------------------ | ------------------ | ------------------- | --------------- |
+ * | `CompressedQuat32` | 10                 | 1.8e-3              | 0.24 deg        |
+ * | `CompressedQuat48` | 15                 | 5.5e-5              | 0.0075 deg      |
+ * | `CompressedQuat64` | 20                 | 1.7e-6              | 0.00023 deg     |
+ *
+ * Errors measured in double precision over 10^6 random rotations. The stored components
+ * are off by at most half a step (sqrt(2) / (2^bits - 1) / 2), the reconstructed largest
+ * component accounts for the rest.
+ *
+ * @tparam Bits Total number of bits (32, 48, or 64)
+ */
+template <std::size_t Bits>
+struct CompressedQuat {
+	static_assert(32 == Bits || 48 == Bits || 64 == Bits,
+	              "Bits has to be 32, 48, or 64");
+
+	static constexpr std::size_t const   component_bits = (Bits - 2) / 3;
+	static constexpr std::uint64_t const max_level =
+	    (std::uint64_t(1) << component_bits) - 1u;
+
+	std::array<std::uint8_t, Bits / 8> data{};
+
+	constexpr CompressedQuat() noexcept = default;
+
+	constexpr explicit CompressedQuat(std::uint64_t value) noexcept
+	{
+		for (std::size_t i{}; data.size() > i; ++i) {
+			data[i] = static_cast<std::uint8_t>(value >> (8 * i));
+		}
+	}
+
+	[[nodiscard]] constexpr std::uint64_t value() const noexcept
+	{
+		std::uint64_t v{};
+		for (std::size_t i{}; data.size() > i; ++i) {
+			v |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+		}
+		return v;
+	}
+
+	/*!
+	 * @brief Index (in w, x, y, z order) of the component that was dropped.
+	 */
+	[[nodiscard]] constexpr std::size_t largest() const noexcept
+	{
+		return static_cast<std::size_t>(value() >> (3 * component_bits));
+	}
+};
+
+using CompressedQuat32 = CompressedQuat<32>;
+using CompressedQuat48 = CompressedQuat<48>;
+using CompressedQuat64 = CompressedQuat<64>;
+
+static_assert(4 == sizeof(CompressedQuat32));
+static_assert(6 == sizeof(CompressedQuat48));
+static_assert(8 == sizeof(CompressedQuat64));
+
+template <std::size_t Bits>
+[[nodiscard]] constexpr bool operator==(CompressedQuat<Bits> const& lhs,
+                                        CompressedQuat<Bits> const& rhs) noexcept
+{
+	return lhs.data == rhs.data;
+}
+
+template <std::size_t Bits>
+[[nodiscard]] constexpr bool operator!=(CompressedQuat<Bits> const& lhs,
+                                        CompressedQuat<Bits> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template <std::size_t Bits, class T>
+[[nodiscard]] CompressedQuat<Bits> compress(Quat<T> const& q) noexcept
+{
+	using C = CompressedQuat<Bits>;
+
+	constexpr T const range = numbers::sqrt2_v<T> * T(0.5);
+	constexpr T const scale = static_cast<T>(C::max_level) / (T(2) * range);
+
+	T const c[4] = {q.w, q.x, q.y, q.z};
+
+	// Branchless arg max of the magnitudes
+	std::size_t const a = std::abs(c[0]) < std::abs(c[2]) ? 2 : 0;
+	std::size_t const b = std::abs(c[1]) < std::abs(c[3]) ? 3 : 1;
+	std::size_t const i = std::abs(c[a]) < std::abs(c[b]) ? b : a;
+
+	// Make the largest component positive so it can be dropped
+	T const sign = T(0) > c[i] ? T(-1) : T(1);
+
+	std::uint64_t v = i;
+	for (std::size_t j{1}; 4 > j; ++j) {
+		T const x = std::clamp(sign * c[(i + j) & 3u] + range, T(0), T(2) * range);
+		v         = (v << C::component_bits) |
+		    static_cast<std::uint64_t>(x * scale + T(0.5));
+	}
+	return C(v);
+}
+
+template <class T, std::size_t Bits>
+[[nodiscard]] Quat<T> decompress(CompressedQuat<Bits> const& cq) noexcept
+{
+	using C = CompressedQuat<Bits>;
+
+	constexpr T const range = numbers::sqrt2_v<T> * T(0.5);
+	constexpr T const scale = (T(2) * range) / static_cast<T>(C::max_level);
+
+	std::uint64_t const v = cq.value();
+	std::size_t const   i = static_cast<std::size_t>(v >> (3 * C::component_bits));
+
+	T c[4];
+	T sum{};
+	for (std::size_t j{1}; 4 > j; ++j) {
+		std::uint64_t const q = (v >> ((3 - j) * C::component_bits)) & C::max_level;
+		T const             x = static_cast<T>(q) * scale - range;
+		c[(i + j) & 3u]       = x;
+		sum += x * x;
+	}
+	c[i] = std::sqrt(std::max(T(0), T(1) - sum));
+
+	return Quat<T>(c[0], c[1], c[2], c[3]);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Batch                                        |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Bits, class InputIt, class OutputIt>
+OutputIt compress(InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [](auto const& q) { return compress<Bits>(q); });
+}
+
+template <
+    std::size_t Bits, class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 compress(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                   RandomIt2 d_first)
+{
+	return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                         [](auto const& q) { return compress<Bits>(q); });
+}
+
+template <class T, class InputIt, class OutputIt>
+OutputIt decompress(InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [](auto const& c) { return decompress<T>(c); });
+}
+
+template <
+    class T, class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 decompress(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                     RandomIt2 d_first)
+{
+	return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                         [](auto const& c) { return decompress<T>(c); });
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_COMPRESSED_QUAT_HPP
@@ -56,6 +56,8 @@ template <class T = float>
 using Mat3x3 = Mat<3, 3, T>;
 template <class T = float>
 using Mat4x4 = Mat<4, 4, T>;
+template <class T = float>
+using Mat6x6 = Mat<6, 6, T>;
 
 template <class T = float>
 using Mat2 = Mat2x2<T>;
@@ -63,6 +65,8 @@ template <class T = float>
 using Mat3 = Mat3x3<T>;
 template <class T = float>
 using Mat4 = Mat4x4<T>;
+template <class T = float>
+using Mat6 = Mat6x6<T>;
 
 using Mat2x2f = Mat2x2<float>;
 using Mat2x2d = Mat2x2<double>;
@@ -76,6 +80,8 @@ using Mat4x4f = Mat4x4<float>;
 using Mat4x4d = Mat4x4<double>;
 using Mat4x4i = Mat4x4<int>;
 using Mat4x4u = Mat4x4<unsigned>;
+using Mat6x6f = Mat6x6<float>;
+using Mat6x6d = Mat6x6<double>;
 
 using Mat2f = Mat2x2f;
 using Mat2d = Mat2x2d;
@@ -89,6 +95,8 @@ using Mat4f = Mat4x4f;
 using Mat4d = Mat4x4d;
 using Mat4i = Mat4x4i;
 using Mat4u = Mat4x4u;
+using Mat6f = Mat6x6f;
+using Mat6d = Mat6x6d;
 }  // namespace ufo
 
 #endif  // UFO_MATH_DETAIL_MAT_HPP
\ No newline at end of file
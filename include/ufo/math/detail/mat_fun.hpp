@@ -52,38 +52,46 @@
 #include <cmath>
 #include <cstddef>
 #include <iomanip>
+#include <iterator>
+#include <limits>
 #include <ostream>
 #include <sstream>
+#include <string>
+#include <utility>
 
 namespace ufo
 {
 template <std::size_t Cols, std::size_t Rows, class T>
 std::ostream& operator<<(std::ostream& out, Mat<Cols, Rows, T> m)
 {
-	auto length = [&out](T value) {
-		std::ostringstream ss;
-		ss.copyfmt(out);
-		ss << value;
-		return ss.str().size();
-	};
-
-	std::array<std::size_t, Cols> column_length{};
+	// Every element is formatted once, with the format of `out`, into one stream
+	std::ostringstream    ss;
+	std::streamsize const width = out.width();
+	ss.copyfmt(out);
+
+	std::array<std::string, Cols * Rows> elements;
+	std::array<std::size_t, Cols>        column_length{};
 	for (std::size_t col{}; Cols > col; ++col) {
 		for (std::size_t row{}; Rows > row; ++row) {
-			column_length[col] = std::max(column_length[col], length(m[col][row]));
+			ss.str(std::string());
+			ss.width(width);
+			ss << m[col][row];
+			std::string& e     = elements[row * Cols + col];
+			e                  = ss.str();
+			column_length[col] = std::max(column_length[col], e.size());
 		}
 	}
 
-	out << std::setw(static_cast<int>(column_length[0])) << m[0][0];
-	for (std::size_t col = 1; Cols > col; ++col) {
-		out << ' ' << std::setw(static_cast<int>(column_length[col])) << m[col][0];
-	}
-
-	for (std::size_t row = 1; Rows > row; ++row) {
-		out << '\n';
-		out << std::setw(static_cast<int>(column_length[0])) << m[0][row];
-		for (std::size_t col = 1; Cols > col; ++col) {
-			out << ' ' << std::setw(static_cast<int>(column_length[col])) << m[col][row];
+	for (std::size_t row{}; Rows > row; ++row) {
+		if (0 != row) {
+			out << '\n';
+		}
+		for (std::size_t col{}; Cols > col; ++col) {
+			if (0 != col) {
+				out << ' ';
+			}
+			out << std::setw(static_cast<int>(column_length[col]))
+			    << elements[row * Cols + col];
 		}
 	}
 
@@ -96,7 +104,7 @@ template <std::size_t Cols, std::size_t Rows, class T>
 	Mat<Rows, Cols, T> t;
 	for (std::size_t row{}; Rows > row; ++row) {
 		for (std::size_t col{}; Cols > col; ++col) {
-			t[col][row] = m[row][col];
+			t[row][col] = m[col][row];
 		}
 	}
 	return t;
@@ -179,7 +187,55 @@ template <std::size_t Cols, std::size_t Rows, class T>
 
 		return Inverse * OneOverDeterminant;
 	} else {
-		// Error
+		static_assert(Cols == Rows, "Cols has to be equal to Rows");
+
+		// Gauss-Jordan elimination with partial pivoting, a(row, col) = a[col][row]
+		Mat<Cols, Rows, T> a = m;
+		Mat<Cols, Rows, T> res;
+
+		// A pivot that vanishes relative to the scale of `m` means `m` is singular, the
+		// result is then NaN everywhere instead of the garbage of dividing by it
+		T scale{};
+		for (std::size_t col{}; Cols > col; ++col) {
+			for (std::size_t row{}; Rows > row; ++row) {
+				scale = std::max(scale, std::abs(m[col][row]));
+			}
+		}
+		T const tol = std::numeric_limits<T>::epsilon() * static_cast<T>(Cols) * scale;
+
+		for (std::size_t col{}; Cols > col; ++col) {
+			std::size_t pivot = col;
+			for (std::size_t row = col + 1; Rows > row; ++row) {
+				pivot = std::abs(a[col][pivot]) < std::abs(a[col][row]) ? row : pivot;
+			}
+			if (!(tol < std::abs(a[col][pivot]))) {
+				return Mat<Cols, Rows, T>(std::numeric_limits<T>::quiet_NaN());
+			}
+			if (pivot != col) {
+				for (std::size_t k{}; Cols > k; ++k) {
+					std::swap(a[k][col], a[k][pivot]);
+					std::swap(res[k][col], res[k][pivot]);
+				}
+			}
+
+			T const d = static_cast<T>(1) / a[col][col];
+			for (std::size_t k{}; Cols > k; ++k) {
+				a[k][col] *= d;
+				res[k][col] *= d;
+			}
+
+			for (std::size_t row{}; Rows > row; ++row) {
+				T const f = a[col][row];
+				if (row == col || T(0) == f) {
+					continue;
+				}
+				for (std::size_t k{}; Cols > k; ++k) {
+					a[k][row] -= f * a[k][col];
+					res[k][row] -= f * res[k][col];
+				}
+			}
+		}
+		return res;
 	}
 }
 
@@ -206,16 +262,202 @@ template <std::size_t Cols, std::size_t Rows, class T>
 		       m[2][0] * m[0][1] * m[1][2] * m[3][3] - m[0][0] * m[2][1] * m[1][2] * m[3][3] -
 		       m[1][0] * m[0][1] * m[2][2] * m[3][3] + m[0][0] * m[1][1] * m[2][2] * m[3][3];
 	} else {
-		static_assert(
-		    Cols != Rows,
-		    "Cols has to be equal to Rows (only implemented for 2x2, 3x3, and 4x4)");
+		static_assert(Cols == Rows, "Cols has to be equal to Rows");
+
+		// LU decomposition with partial pivoting, a(row, col) = a[col][row]
+		Mat<Cols, Rows, T> a   = m;
+		T                  det = static_cast<T>(1);
+		for (std::size_t col{}; Cols > col; ++col) {
+			std::size_t pivot = col;
+			for (std::size_t row = col + 1; Rows > row; ++row) {
+				pivot = std::abs(a[col][pivot]) < std::abs(a[col][row]) ? row : pivot;
+			}
+			if (T(0) == a[col][pivot]) {
+				return T(0);
+			}
+			if (pivot != col) {
+				for (std::size_t k = col; Cols > k; ++k) {
+					std::swap(a[k][col], a[k][pivot]);
+				}
+				det = -det;
+			}
+
+			det *= a[col][col];
+			for (std::size_t row = col + 1; Rows > row; ++row) {
+				T const f = a[col][row] / a[col][col];
+				for (std::size_t k = col + 1; Cols > k; ++k) {
+					a[k][row] -= f * a[k][col];
+				}
+			}
+		}
+		return det;
+	}
+}
+
+namespace detail
+{
+/*!
+ * @brief Smallest pivot magnitude `cholesky` and `ldlt` accept for `m`, relative to the
+ * largest diagonal element so that the test does not depend on the scale of `m`.
+ */
+template <std::size_t N, class T>
+[[nodiscard]] T pivotTolerance(Mat<N, N, T> const& m)
+{
+	T scale{};
+	for (std::size_t i{}; N > i; ++i) {
+		scale = std::max(scale, std::abs(m[i][i]));
+	}
+	return std::numeric_limits<T>::epsilon() * static_cast<T>(N) * scale;
+}
+}  // namespace detail
+
+/*!
+ * @brief In-place Cholesky factorization `m = L * transpose(L)` of a symmetric positive
+ * definite matrix.
+ *
+ * Only the lower triangle of `m` is read. On success `m` holds `L`, with the strict upper
+ * triangle set to zero.
+ *
+ * @return `false` if `m` is not positive definite, `m` is then partially overwritten.
+ */
+template <std::size_t N, class T>
+[[nodiscard]] bool cholesky(Mat<N, N, T>& m)
+{
+	// m(row, col) = m[col][row]
+	T const tol = detail::pivotTolerance(m);
+	for (std::size_t j{}; N > j; ++j) {
+		T d = m[j][j];
+		for (std::size_t k{}; j > k; ++k) {
+			d -= m[k][j] * m[k][j];
+		}
+		if (!(tol < d)) {
+			return false;
+		}
+		d       = std::sqrt(d);
+		m[j][j] = d;
+		for (std::size_t i = j + 1; N > i; ++i) {
+			T s = m[j][i];
+			for (std::size_t k{}; j > k; ++k) {
+				s -= m[k][i] * m[k][j];
+			}
+			m[j][i] = s / d;
+			m[i][j] = T(0);
+		}
+	}
+	return true;
+}
+
+/*!
+ * @brief In-place factorization `m = L * D * transpose(L)` of a symmetric matrix, with
+ * `L` unit lower triangular and `D` diagonal.
+ *
+ * Unlike `cholesky` this needs no square roots and also handles indefinite matrices, as
+ * long as no pivot vanishes. Only the lower triangle of `m` is read. On success the
+ * strict lower triangle of `m` holds `L`, the diagonal holds `D`, and the strict upper
+ * triangle is set to zero.
+ *
+ * @return `false` if a pivot is (numerically) zero, `m` is then partially overwritten.
+ */
+template <std::size_t N, class T>
+[[nodiscard]] bool ldlt(Mat<N, N, T>& m)
+{
+	// m(row, col) = m[col][row]
+	T const tol = detail::pivotTolerance(m);
+	for (std::size_t j{}; N > j; ++j) {
+		T d = m[j][j];
+		for (std::size_t k{}; j > k; ++k) {
+			d -= m[k][j] * m[k][j] * m[k][k];
+		}
+		if (!(tol < std::abs(d))) {
+			return false;
+		}
+		m[j][j] = d;
+		for (std::size_t i = j + 1; N > i; ++i) {
+			T s = m[j][i];
+			for (std::size_t k{}; j > k; ++k) {
+				s -= m[k][i] * m[k][j] * m[k][k];
+			}
+			m[j][i] = s / d;
+			m[i][j] = T(0);
+		}
+	}
+	return true;
+}
+
+/*!
+ * @brief Solves `L * transpose(L) * x = b` in place, with `l` as produced by `cholesky`.
+ */
+template <std::size_t N, class T>
+void choleskySolve(Mat<N, N, T> const& l, Vec<N, T>& b)
+{
+	for (std::size_t i{}; N > i; ++i) {
+		T s = b[i];
+		for (std::size_t k{}; i > k; ++k) {
+			s -= l[k][i] * b[k];
+		}
+		b[i] = s / l[i][i];
+	}
+	for (std::size_t i = N; 0 < i--;) {
+		T s = b[i];
+		for (std::size_t k = i + 1; N > k; ++k) {
+			s -= l[i][k] * b[k];
+		}
+		b[i] = s / l[i][i];
+	}
+}
+
+/*!
+ * @brief Solves `L * D * transpose(L) * x = b` in place, with `ld` as produced by
+ * `ldlt`.
+ */
+template <std::size_t N, class T>
+void ldltSolve(Mat<N, N, T> const& ld, Vec<N, T>& b)
+{
+	for (std::size_t i{}; N > i; ++i) {
+		T s = b[i];
+		for (std::size_t k{}; i > k; ++k) {
+			s -= ld[k][i] * b[k];
+		}
+		b[i] = s;
+	}
+	for (std::size_t i{}; N > i; ++i) {
+		b[i] /= ld[i][i];
+	}
+	for (std::size_t i = N; 0 < i--;) {
+		T s = b[i];
+		for (std::size_t k = i + 1; N > k; ++k) {
+			s -= ld[i][k] * b[k];
+		}
+		b[i] = s;
+	}
+}
+
+/*!
+ * @brief Symmetric rank-1 update `m += alpha * v * transpose(v)`.
+ */
+template <std::size_t N, class T>
+void rankUpdate(Mat<N, N, T>& m, Vec<N, T> const& v, T alpha = T(1))
+{
+	for (std::size_t col{}; N > col; ++col) {
+		m[col] += v * (alpha * v[col]);
+	}
+}
+
+/*!
+ * @brief Symmetric rank-k update `m += alpha * a * transpose(a)`, where `a` is N by K.
+ */
+template <std::size_t N, std::size_t K, class T>
+void rankUpdate(Mat<N, N, T>& m, Mat<K, N, T> const& a, T alpha = T(1))
+{
+	for (std::size_t k{}; K > k; ++k) {
+		rankUpdate(m, a[k], alpha);
 	}
 }
 
 template <class T>
 [[nodiscard]] Mat<4, 4, T> orthogonal(T left, T right, T bottom, T top)
 {
-	Mat<4, 4, T> m(T(1));
+	Mat<4, 4, T> m;
 	m[0][0] = T(2) / (right - left);
 	m[1][1] = T(2) / (top - bottom);
 	m[2][2] = -T(1);
@@ -227,7 +469,7 @@ template <class T>
 template <class T, bool RightHanded = true, bool ZeroToOne = true>
 [[nodiscard]] Mat<4, 4, T> orthogonal(T left, T right, T bottom, T top, T zNear, T zFar)
 {
-	Mat<4, 4, T> m(1);
+	Mat<4, 4, T> m;
 
 	if constexpr (RightHanded && ZeroToOne) {
 		m[0][0] = T(2) / (right - left);
@@ -342,7 +584,7 @@ template <class T, bool RightHanded = true>
 [[nodiscard]] Mat<4, 4, T> lookAt(Vec<3, T> const& eye, Vec<3, T> const& target,
                                   Vec<3, T> const& up)
 {
-	Mat<4, 4, T> m(1);
+	Mat<4, 4, T> m;
 
 	if constexpr (RightHanded) {
 		Vec<3, T> const f(normalize(target - eye));
@@ -413,6 +655,117 @@ template <class T>
 	result[3] = m[3];
 	return result;
 }
+
+/*!
+ * @brief Eigen decomposition of a symmetric 3x3 matrix using cyclic Jacobi rotations.
+ *
+ * Only the lower triangle of `m` is read.
+ *
+ * @return The eigenvalues in ascending order and the matrix whose columns are the
+ * corresponding unit eigenvectors.
+ */
+template <class T>
+[[nodiscard]] std::pair<Vec<3, T>, Mat<3, 3, T>> eigenSymmetric(Mat<3, 3, T> const& m)
+{
+	// a(row, col) = a[col][row], kept symmetric throughout
+	Mat<3, 3, T> a = m;
+	a[1][0]        = m[0][1];
+	a[2][0]        = m[0][2];
+	a[2][1]        = m[1][2];
+
+	Mat<3, 3, T> v;
+
+	for (int sweep{}; 50 > sweep; ++sweep) {
+		T off  = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+		T diag = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+		if (off <= std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon() *
+		               diag) {
+			break;
+		}
+
+		for (std::size_t p{}; 2 > p; ++p) {
+			for (std::size_t q = p + 1; 3 > q; ++q) {
+				T apq = a[q][p];
+				if (T(0) == apq) {
+					continue;
+				}
+
+				T theta = (a[q][q] - a[p][p]) / (T(2) * apq);
+				T t     = T(1) / (std::abs(theta) + std::sqrt(theta * theta + T(1)));
+				t       = T(0) > theta ? -t : t;
+				T c     = T(1) / std::sqrt(t * t + T(1));
+				T s     = t * c;
+
+				for (std::size_t k{}; 3 > k; ++k) {
+					T kp    = a[p][k];
+					T kq    = a[q][k];
+					a[p][k] = c * kp - s * kq;
+					a[q][k] = s * kp + c * kq;
+				}
+				for (std::size_t k{}; 3 > k; ++k) {
+					T pk    = a[k][p];
+					T qk    = a[k][q];
+					a[k][p] = c * pk - s * qk;
+					a[k][q] = s * pk + c * qk;
+				}
+				for (std::size_t k{}; 3 > k; ++k) {
+					T kp    = v[p][k];
+					T kq    = v[q][k];
+					v[p][k] = c * kp - s * kq;
+					v[q][k] = s * kp + c * kq;
+				}
+			}
+		}
+	}
+
+	Vec<3, T> values(a[0][0], a[1][1], a[2][2]);
+	for (std::size_t i{}; 2 > i; ++i) {
+		for (std::size_t j = i + 1; 3 > j; ++j) {
+			if (values[j] < values[i]) {
+				std::swap(values[i], values[j]);
+				std::swap(v[i], v[j]);
+			}
+		}
+	}
+
+	return {values, v};
+}
+
+namespace detail
+{
+/*!
+ * @brief Centroid and unnormalized covariance of the points in [`first`, `last`), as
+ * used by the least squares fits.
+ *
+ * Only the lower triangle of the covariance is filled, which is what `eigenSymmetric`
+ * reads.
+ */
+template <class ForwardIt>
+[[nodiscard]] auto centroidCovariance(ForwardIt first, ForwardIt last)
+{
+	using T = typename std::iterator_traits<ForwardIt>::value_type::value_type;
+
+	Vec<3, T>   centroid{};
+	std::size_t n{};
+	for (auto it = first; last != it; ++it, ++n) {
+		centroid += *it;
+	}
+	centroid /= static_cast<T>(n);
+
+	Mat<3, 3, T> cov(T(0));
+	for (auto it = first; last != it; ++it) {
+		Vec<3, T> d = *it - centroid;
+		cov[0][0] += d.x * d.x;
+		cov[0][1] += d.x * d.y;
+		cov[0][2] += d.x * d.z;
+		cov[1][1] += d.y * d.y;
+		cov[1][2] += d.y * d.z;
+		cov[2][2] += d.z * d.z;
+	}
+
+	return std::pair<Vec<3, T>, Mat<3, 3, T>>(centroid, cov);
+}
+}  // namespace detail
 }  // namespace ufo
 
 #endif  // UFO_MATH_DETAIL_MAT_FUN_HPP
\ No newline at end of file
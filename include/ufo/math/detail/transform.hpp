@@ -59,6 +59,12 @@ using Transform2f = Transform2<float>;
 using Transform2d = Transform2<double>;
 using Transform3f = Transform3<float>;
 using Transform3d = Transform3<double>;
+
+template <class T = float>
+struct QuatTransform;
+
+using QuatTransformf = QuatTransform<float>;
+using QuatTransformd = QuatTransform<double>;
 }  // namespace ufo
 
 #endif  // UFO_MATH_DETAIL_TRANSFORM_HPP
\ No newline at end of file
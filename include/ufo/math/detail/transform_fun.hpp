@@ -44,71 +44,83 @@
 
 // UFO
 #include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/quat.hpp>
 #include <ufo/math/detail/transform.hpp>
+#include <ufo/math/grain_size.hpp>
 #include <ufo/math/mat3x3.hpp>
 #include <ufo/math/mat4x4.hpp>
+#include <ufo/math/thread_pool.hpp>
 #include <ufo/math/vec2.hpp>
 #include <ufo/math/vec3.hpp>
 #include <ufo/utility/type_traits.hpp>
 
 // STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <numeric>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace ufo
 {
-template <std::size_t Dim, class T>
-[[nodiscard]] Vec<Dim, T> transform(Transform<Dim, T> const& t, Vec<Dim, T> const& v)
+namespace detail
 {
-	return t * v;
-}
+/*!
+ * @brief How much work `op` of `transform` does per element.
+ *
+ * `GrainSize` is tuned for rigid transforms of points, so only `CHEAP` operations of
+ * about that cost go through it. `EXPENSIVE` ones, such as BVH queries, always use the
+ * policy as given.
+ */
+enum class ElementCost : std::uint8_t { CHEAP, EXPENSIVE };
 
-template <std::size_t Dim, class T, class InputIt, class OutputIt>
-OutputIt transform(Transform<Dim, T> const& t, InputIt first, InputIt last,
-                   OutputIt d_first)
+/*!
+ * @brief Writes `op(first[i])` to `d_first[i]` using `policy`.
+ *
+ * For `CHEAP` operations, inputs below `grainSize().sequential_below` run sequentially,
+ * and larger ones use no more threads than give every thread
+ * `grainSize().min_per_thread` elements, where the backend allows setting it.
+ */
+template <ElementCost Cost = ElementCost::EXPENSIVE, class ExecutionPolicy,
+          class RandomIt1, class RandomIt2, class UnaryOp>
+RandomIt2 transform(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                    RandomIt2 d_first, UnaryOp op)
 {
-	return std::transform(first, last, d_first, [&t](auto const& x) { return t * x; });
-}
+	std::size_t const size = std::distance(first, last);
 
-template <std::size_t Dim, class T, class InputIt>
-[[nodiscard]] auto transform(Transform<Dim, T> const& t, InputIt first, InputIt last)
-{
-	using V = typename std::iterator_traits<InputIt>::value_type;
-	std::vector<V> v;
-	v.reserve(std::distance(first, last));
-	transform(t, first, last, std::back_inserter(v));
-	return v;
-}
+	if constexpr (ElementCost::CHEAP == Cost) {
+		if (runSequential(size)) {
+			return std::transform(first, last, d_first, op);
+		}
+	}
 
-template <std::size_t Dim, class T, class Range>
-[[nodiscard]] auto transform(Transform<Dim, T> const& t, Range const& range)
-{
-	using std::begin;
-	using std::end;
-	return transform(t, begin(range), end(range));
-}
+	if constexpr (is_thread_pool_policy_v<ExecutionPolicy>) {
+		std::size_t grain = policy.grain;
+		if (ElementCost::CHEAP == Cost && 0 == grain) {
+			grain = grain_min_per_thread.load(std::memory_order_relaxed);
+		}
 
-template <
-    class ExecutionPolicy, std::size_t Dim, class T, class RandomIt1, class RandomIt2,
-    std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, bool> = true>
-RandomIt2 transform(ExecutionPolicy&& policy, Transform<Dim, T> const& t, RandomIt1 first,
-                    RandomIt1 last, RandomIt2 d_first)
-{
-	if constexpr (execution::is_stl_v<ExecutionPolicy>) {
-		return std::transform(execution::toSTL(policy), first, last, d_first,
-		                      [&t](auto const& x) { return t * x; });
+		policy.pool->forEach(
+		    0, size, [&op, first, d_first](std::size_t i) { d_first[i] = op(first[i]); },
+		    grain);
+
+		return d_first + size;
+	} else if constexpr (execution::is_stl_v<ExecutionPolicy>) {
+		return std::transform(execution::toSTL(policy), first, last, d_first, op);
 	}
 #if defined(UFO_PAR_GCD)
 	else if constexpr (execution::is_gcd_v<ExecutionPolicy>) {
-		std::size_t const size = std::distance(first, last);
-
 		// FIXME: Is this needed?
 		__block RandomIt2 d_first_local = d_first;
 
 		dispatch_apply(size, dispatch_get_global_queue(0, 0), ^(std::size_t i) {
-			d_first_local[i] = t * first[i];
+			d_first_local[i] = op(first[i]);
 		});
 
 		return d_first + size;
@@ -116,19 +128,15 @@ RandomIt2 transform(ExecutionPolicy&& policy, Transform<Dim, T> const& t, Random
 #endif
 #if defined(UFO_PAR_TBB)
 	else if constexpr (execution::is_tbb_v<ExecutionPolicy>) {
-		std::size_t const size = std::distance(first, last);
-
-		oneapi::tbb::parallel_for(std::size_t(0), size, [&t, first, d_first](std::size_t i) {
-			d_first[i] = t * first[i];
+		oneapi::tbb::parallel_for(std::size_t(0), size, [&op, first, d_first](std::size_t i) {
+			d_first[i] = op(first[i]);
 		});
 
 		return d_first + size;
 	}
 #endif
 	else if constexpr (execution::is_omp_v<ExecutionPolicy>) {
-		std::size_t const size = std::distance(first, last);
-
-		auto fun = [t, first](std::size_t i) { return t * first[i]; };
+		auto fun = [op, first](std::size_t i) { return op(first[i]); };
 
 		if constexpr (execution::is_seq_v<ExecutionPolicy>) {
 			for (std::size_t i = 0; size != i; ++i) {
@@ -139,11 +147,25 @@ RandomIt2 transform(ExecutionPolicy&& policy, Transform<Dim, T> const& t, Random
 			for (std::size_t i = 0; size != i; ++i) {
 				d_first[i] = fun(i);
 			}
+		} else if constexpr (execution::is_par_v<ExecutionPolicy> &&
+		                     ElementCost::CHEAP == Cost) {
+			[[maybe_unused]] int const threads = static_cast<int>(parallelThreads(size));
+#pragma omp parallel for num_threads(threads)
+			for (std::size_t i = 0; size != i; ++i) {
+				d_first[i] = fun(i);
+			}
 		} else if constexpr (execution::is_par_v<ExecutionPolicy>) {
 #pragma omp parallel for
 			for (std::size_t i = 0; size != i; ++i) {
 				d_first[i] = fun(i);
 			}
+		} else if constexpr (execution::is_par_unseq_v<ExecutionPolicy> &&
+		                     ElementCost::CHEAP == Cost) {
+			[[maybe_unused]] int const threads = static_cast<int>(parallelThreads(size));
+#pragma omp parallel for simd num_threads(threads)
+			for (std::size_t i = 0; size != i; ++i) {
+				d_first[i] = fun(i);
+			}
 		} else if constexpr (execution::is_par_unseq_v<ExecutionPolicy>) {
 #pragma omp parallel for simd
 			for (std::size_t i = 0; size != i; ++i) {
@@ -158,9 +180,231 @@ RandomIt2 transform(ExecutionPolicy&& policy, Transform<Dim, T> const& t, Random
 	}
 }
 
+/*!
+ * @brief Calls `f(i)` for every index `i` in [`first`, `last`) using `policy`.
+ */
+template <class ExecutionPolicy, class UnaryFunction>
+void forEach(ExecutionPolicy&& policy, std::size_t first, std::size_t last,
+             UnaryFunction f)
+{
+	if (first >= last) {
+		return;
+	}
+
+	if constexpr (is_thread_pool_policy_v<ExecutionPolicy>) {
+		policy.pool->forEach(first, last, f, policy.grain);
+	} else if constexpr (execution::is_stl_v<ExecutionPolicy>) {
+		// The STL needs iterators to loop over, one index per block keeps the memory
+		// independent of the size of the range
+		std::size_t const size   = last - first;
+		std::size_t const blocks = std::min(size, 8 * hardwareThreads());
+		std::size_t const q      = size / blocks;
+		std::size_t const r      = size % blocks;
+
+		std::vector<std::size_t> indices(blocks);
+		std::iota(indices.begin(), indices.end(), std::size_t(0));
+		std::for_each(execution::toSTL(policy), indices.begin(), indices.end(),
+		              [first, q, r, &f](std::size_t b) {
+			              std::size_t       i = first + b * q + std::min(b, r);
+			              std::size_t const l = i + q + (r > b ? 1 : 0);
+			              for (; l != i; ++i) {
+				              f(i);
+			              }
+		              });
+	}
+#if defined(UFO_PAR_GCD)
+	else if constexpr (execution::is_gcd_v<ExecutionPolicy>) {
+		dispatch_apply(last - first, dispatch_get_global_queue(0, 0),
+		               ^(std::size_t i) { f(first + i); });
+	}
+#endif
+#if defined(UFO_PAR_TBB)
+	else if constexpr (execution::is_tbb_v<ExecutionPolicy>) {
+		oneapi::tbb::parallel_for(first, last, f);
+	}
+#endif
+	else if constexpr (execution::is_omp_v<ExecutionPolicy>) {
+		if constexpr (execution::is_seq_v<ExecutionPolicy>) {
+			for (std::size_t i = first; last != i; ++i) {
+				f(i);
+			}
+		} else if constexpr (execution::is_unseq_v<ExecutionPolicy>) {
+#pragma omp simd
+			for (std::size_t i = first; last != i; ++i) {
+				f(i);
+			}
+		} else if constexpr (execution::is_par_v<ExecutionPolicy>) {
+#pragma omp parallel for
+			for (std::size_t i = first; last != i; ++i) {
+				f(i);
+			}
+		} else if constexpr (execution::is_par_unseq_v<ExecutionPolicy>) {
+#pragma omp parallel for simd
+			for (std::size_t i = first; last != i; ++i) {
+				f(i);
+			}
+		}
+	} else {
+		static_assert(dependent_false_v<ExecutionPolicy>,
+		              "Not implemented for the execution policy");
+	}
+}
+
+/*!
+ * @brief Index loop for algorithms that take the loop as a parameter, so that the same
+ * code serves both the sequential and the execution policy overloads.
+ */
+struct SequentialForEach {
+	template <class UnaryFunction>
+	void operator()(std::size_t first, std::size_t last, UnaryFunction f) const
+	{
+		for (; last != first; ++first) {
+			f(first);
+		}
+	}
+};
+
+template <class ExecutionPolicy>
+struct PolicyForEach {
+	ExecutionPolicy& policy;
+
+	template <class UnaryFunction>
+	void operator()(std::size_t first, std::size_t last, UnaryFunction f) const
+	{
+		forEach(policy, first, last, f);
+	}
+};
+
+/*!
+ * @brief Sums `count(block_first, block_last)` over blocks of [`first`, `last`) counted
+ * in parallel using `policy`, for the `countInliers` of the geometric primitives.
+ */
+template <class ExecutionPolicy, class RandomIt, class CountBlock>
+[[nodiscard]] std::size_t countInliers(ExecutionPolicy&& policy, RandomIt first,
+                                       RandomIt last, CountBlock count)
+{
+	constexpr std::size_t block_size = 4096;
+
+	std::size_t const size   = std::distance(first, last);
+	std::size_t const blocks = (size + block_size - 1) / block_size;
+
+	std::vector<std::size_t> counts(blocks);
+	forEach(std::forward<ExecutionPolicy>(policy), 0, blocks, [&](std::size_t b) {
+		auto f    = first + b * block_size;
+		auto l    = first + std::min(size, (b + 1) * block_size);
+		counts[b] = count(f, l);
+	});
+	return std::accumulate(counts.begin(), counts.end(), std::size_t(0));
+}
+}  // namespace detail
+
+/*!
+ * @brief Measures the cost of starting a parallel loop with `policy` against the cost of
+ * transforming a point, and sets `grainSize()` to where `policy` starts to pay off.
+ *
+ * Takes a few milliseconds, meant to be called once at start-up with the policy that
+ * will be used.
+ */
+template <
+    class ExecutionPolicy,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+GrainSize calibrateGrainSize(ExecutionPolicy&& policy)
+{
+	using clock = std::chrono::steady_clock;
+
+	std::size_t const threads = detail::hardwareThreads();
+	if (1 == threads) {
+		GrainSize const grain{std::numeric_limits<std::size_t>::max(),
+		                      std::numeric_limits<std::size_t>::max()};
+		setGrainSize(grain);
+		return grain;
+	}
+
+	Mat3x3f const rotation(0, 1, 0, -1, 0, 0, 0, 0, 1);
+	Vec3f const   translation(1, 2, 3);
+
+	constexpr std::size_t n = std::size_t(1) << 14;
+	std::vector<Vec3f> in(n, translation);
+	std::vector<Vec3f> out(n);
+
+	// Best of a few runs, to not count page faults or interrupts
+	double element = std::numeric_limits<double>::infinity();
+	for (int run{}; 5 > run; ++run) {
+		auto const start = clock::now();
+		std::transform(in.begin(), in.end(), out.begin(),
+		               [&](Vec3f const& v) { return rotation * v + translation; });
+		std::chrono::duration<double> const elapsed = clock::now() - start;
+		element = std::min(element, elapsed.count() / static_cast<double>(n));
+		std::swap(in, out);
+	}
+
+	// A loop with one trivial iteration per thread is all start-up and join
+	double dispatch = std::numeric_limits<double>::infinity();
+	for (int run{}; 5 > run; ++run) {
+		auto const start = clock::now();
+		detail::forEach(policy, 0, threads, [&out](std::size_t i) { out[i] += 1.0f; });
+		std::chrono::duration<double> const elapsed = clock::now() - start;
+		dispatch = std::min(dispatch, elapsed.count());
+	}
+
+	// Parallel wins once the time saved, n * element * (1 - 1 / threads), exceeds the
+	// start-up cost
+	double const saved = std::max(element, 1e-12) *
+	                     (1.0 - 1.0 / static_cast<double>(threads));
+	std::size_t const sequential_below =
+	    static_cast<std::size_t>(std::ceil(dispatch / saved));
+
+	GrainSize const grain{sequential_below,
+	                      std::max(std::size_t(1), sequential_below / threads)};
+	setGrainSize(grain);
+	return grain;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] Vec<Dim, T> transform(Transform<Dim, T> const& t, Vec<Dim, T> const& v)
+{
+	return t * v;
+}
+
+template <std::size_t Dim, class T, class InputIt, class OutputIt>
+OutputIt transform(Transform<Dim, T> const& t, InputIt first, InputIt last,
+                   OutputIt d_first)
+{
+	return std::transform(first, last, d_first, [&t](auto const& x) { return t * x; });
+}
+
+template <std::size_t Dim, class T, class InputIt>
+[[nodiscard]] auto transform(Transform<Dim, T> const& t, InputIt first, InputIt last)
+{
+	using V = typename std::iterator_traits<InputIt>::value_type;
+	std::vector<V> v;
+	v.reserve(std::distance(first, last));
+	transform(t, first, last, std::back_inserter(v));
+	return v;
+}
+
+template <std::size_t Dim, class T, class Range>
+[[nodiscard]] auto transform(Transform<Dim, T> const& t, Range const& range)
+{
+	using std::begin;
+	using std::end;
+	return transform(t, begin(range), end(range));
+}
+
+template <
+    class ExecutionPolicy, std::size_t Dim, class T, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 transform(ExecutionPolicy&& policy, Transform<Dim, T> const& t, RandomIt1 first,
+                    RandomIt1 last, RandomIt2 d_first)
+{
+	return detail::transform<detail::ElementCost::CHEAP>(
+	    std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	    [&t](auto const& x) { return t * x; });
+}
+
 template <
     class ExecutionPolicy, std::size_t Dim, class T, class RandomIt,
-    std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
 auto transform(ExecutionPolicy&& policy, Transform<Dim, T> const& t, RandomIt first,
                RandomIt last)
 {
@@ -172,7 +416,7 @@ auto transform(ExecutionPolicy&& policy, Transform<Dim, T> const& t, RandomIt fi
 
 template <
     class ExecutionPolicy, std::size_t Dim, class T, class Range,
-    std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
 auto transform(ExecutionPolicy&& policy, Transform<Dim, T> const& t, Range const& range)
 {
 	using std::begin;
@@ -197,7 +441,7 @@ void transformInPlace(Transform<Dim, T> const& t, Range& range)
 
 template <
     class ExecutionPolicy, std::size_t Dim, class T, class RandomInOutIt,
-    std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
 RandomInOutIt transformInPlace(ExecutionPolicy&& policy, Transform<Dim, T> const& t,
                                RandomInOutIt first, RandomInOutIt last)
 {
@@ -206,7 +450,7 @@ RandomInOutIt transformInPlace(ExecutionPolicy&& policy, Transform<Dim, T> const
 
 template <
     class ExecutionPolicy, std::size_t Dim, class T, class Range,
-    std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
 void transformInPlace(ExecutionPolicy&& policy, Transform<Dim, T> const& t, Range& range)
 {
 	using std::begin;
@@ -220,6 +464,105 @@ template <std::size_t Dim, class T>
 	Mat<Dim, Dim, T> inv = transpose(Mat<Dim, Dim, T>(t));
 	return Transform<Dim, T>(inv, inv * -t.translation);
 }
+
+//
+// QuatTransform
+//
+// The batch overloads expand the rotation to a 3x3 matrix once and run the matrix
+// kernel, as applying a quaternion directly costs roughly twice the multiplications
+// per point.
+//
+
+template <class T>
+[[nodiscard]] Vec<3, T> transform(QuatTransform<T> const& t, Vec<3, T> const& v)
+{
+	return t * v;
+}
+
+template <class T, class InputIt, class OutputIt>
+OutputIt transform(QuatTransform<T> const& t, InputIt first, InputIt last,
+                   OutputIt d_first)
+{
+	return transform(Transform<3, T>(t), first, last, d_first);
+}
+
+template <class T, class InputIt>
+[[nodiscard]] auto transform(QuatTransform<T> const& t, InputIt first, InputIt last)
+{
+	return transform(Transform<3, T>(t), first, last);
+}
+
+template <class T, class Range>
+[[nodiscard]] auto transform(QuatTransform<T> const& t, Range const& range)
+{
+	return transform(Transform<3, T>(t), range);
+}
+
+template <
+    class ExecutionPolicy, class T, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 transform(ExecutionPolicy&& policy, QuatTransform<T> const& t,
+                    RandomIt1 first, RandomIt1 last, RandomIt2 d_first)
+{
+	return transform(std::forward<ExecutionPolicy>(policy), Transform<3, T>(t), first,
+	                 last, d_first);
+}
+
+template <
+    class ExecutionPolicy, class T, class RandomIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+auto transform(ExecutionPolicy&& policy, QuatTransform<T> const& t, RandomIt first,
+               RandomIt last)
+{
+	return transform(std::forward<ExecutionPolicy>(policy), Transform<3, T>(t), first,
+	                 last);
+}
+
+template <
+    class ExecutionPolicy, class T, class Range,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+auto transform(ExecutionPolicy&& policy, QuatTransform<T> const& t, Range const& range)
+{
+	return transform(std::forward<ExecutionPolicy>(policy), Transform<3, T>(t), range);
+}
+
+template <class T, class InputOutputIt>
+InputOutputIt transformInPlace(QuatTransform<T> const& t, InputOutputIt first,
+                               InputOutputIt last)
+{
+	return transformInPlace(Transform<3, T>(t), first, last);
+}
+
+template <class T, class Range>
+void transformInPlace(QuatTransform<T> const& t, Range& range)
+{
+	transformInPlace(Transform<3, T>(t), range);
+}
+
+template <
+    class ExecutionPolicy, class T, class RandomInOutIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomInOutIt transformInPlace(ExecutionPolicy&& policy, QuatTransform<T> const& t,
+                               RandomInOutIt first, RandomInOutIt last)
+{
+	return transformInPlace(std::forward<ExecutionPolicy>(policy), Transform<3, T>(t),
+	                        first, last);
+}
+
+template <
+    class ExecutionPolicy, class T, class Range,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+void transformInPlace(ExecutionPolicy&& policy, QuatTransform<T> const& t, Range& range)
+{
+	transformInPlace(std::forward<ExecutionPolicy>(policy), Transform<3, T>(t), range);
+}
+
+template <class T>
+[[nodiscard]] QuatTransform<T> inverse(QuatTransform<T> const& t)
+{
+	Quat<T> inv = conjugate(t.rotation);
+	return QuatTransform<T>(inv, inv * -t.translation);
+}
 }  // namespace ufo
 
 #endif  // UFO_MATH_DETAIL_TRANSFORM_FUN_HPP
\ No newline at end of file
@@ -61,6 +61,8 @@ template <class T = float>
 using Vec3 = Vec<3, T>;
 template <class T = float>
 using Vec4 = Vec<4, T>;
+template <class T = float>
+using Vec6 = Vec<6, T>;
 
 using Vec1f = Vec1<float>;
 using Vec1d = Vec1<double>;
@@ -82,6 +84,8 @@ using Vec4d = Vec4<double>;
 using Vec4i = Vec4<int>;
 using Vec4u = Vec4<unsigned>;
 using Vec4b = Vec4<bool>;
+using Vec6f = Vec6<float>;
+using Vec6d = Vec6<double>;
 }  // namespace ufo
 
 #endif  // UFO_MATH_DETAIL_VEC_HPP
\ No newline at end of file
@@ -57,17 +57,25 @@ namespace ufo
 template <std::size_t Dim, class T>
 std::ostream& operator<<(std::ostream& out, Vec<Dim, T> const& v)
 {
-	out << "x: " << v.x;
-	if constexpr (1 < Dim) {
-		out << " y: " << v.y;
-	}
-	if constexpr (2 < Dim) {
-		out << " z: " << v.z;
-	}
-	if constexpr (3 < Dim) {
-		out << " w: " << v.w;
+	if constexpr (4 < Dim) {
+		out << v[0];
+		for (std::size_t i{1}; Dim > i; ++i) {
+			out << ' ' << v[i];
+		}
+		return out;
+	} else {
+		out << "x: " << v.x;
+		if constexpr (1 < Dim) {
+			out << " y: " << v.y;
+		}
+		if constexpr (2 < Dim) {
+			out << " z: " << v.z;
+		}
+		if constexpr (3 < Dim) {
+			out << " w: " << v.w;
+		}
+		return out;
 	}
-	return out;
 }
 
 template <std::size_t Dim, class T>
@@ -79,13 +87,13 @@ void swap(Vec<Dim, T>& lhs, Vec<Dim, T>& rhs) noexcept
 template <std::size_t Dim, class T>
 [[nodiscard]] T* begin(Vec<Dim, T>& v) noexcept
 {
-	return &v.x;
+	return &v[0];
 }
 
 template <std::size_t Dim, class T>
 [[nodiscard]] T const* begin(Vec<Dim, T> const& v) noexcept
 {
-	return &v.x;
+	return &v[0];
 }
 
 template <std::size_t Dim, class T>
@@ -97,13 +105,13 @@ template <std::size_t Dim, class T>
 template <std::size_t Dim, class T>
 [[nodiscard]] T* end(Vec<Dim, T>& v) noexcept
 {
-	return &v.x + Dim;
+	return &v[0] + Dim;
 }
 
 template <std::size_t Dim, class T>
 [[nodiscard]] T const* end(Vec<Dim, T> const& v) noexcept
 {
-	return &v.x + Dim;
+	return &v[0] + Dim;
 }
 
 template <std::size_t Dim, class T>
@@ -205,7 +213,11 @@ template <std::size_t Dim, class T>
 		}
 		return v.x < v.y ? v.x : v.y;
 	} else {
-		// Error
+		T res = v[0];
+		for (std::size_t i{1}; Dim > i; ++i) {
+			res = v[i] < res ? v[i] : res;
+		}
+		return res;
 	}
 }
 
@@ -233,7 +245,11 @@ template <std::size_t Dim, class T>
 		}
 		return v.x > v.y ? v.x : v.y;
 	} else {
-		// Error
+		T res = v[0];
+		for (std::size_t i{1}; Dim > i; ++i) {
+			res = v[i] > res ? v[i] : res;
+		}
+		return res;
 	}
 }
 
@@ -251,7 +267,11 @@ template <std::size_t Dim, class T>
 		std::size_t b = v.y < v.w ? 1 : 3;
 		return v[a] < v[b] ? a : b;
 	} else {
-		// Error
+		std::size_t res{};
+		for (std::size_t i{1}; Dim > i; ++i) {
+			res = v[i] < v[res] ? i : res;
+		}
+		return res;
 	}
 }
 
@@ -269,7 +289,11 @@ template <std::size_t Dim, class T>
 		std::size_t b = v.y > v.w ? 1 : 3;
 		return v[a] > v[b] ? a : b;
 	} else {
-		// Error
+		std::size_t res{};
+		for (std::size_t i{1}; Dim > i; ++i) {
+			res = v[i] > v[res] ? i : res;
+		}
+		return res;
 	}
 }
 
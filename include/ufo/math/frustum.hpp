@@ -0,0 +1,452 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_FRUSTUM_HPP
+#define UFO_MATH_FRUSTUM_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/aabb.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/mat4x4.hpp>
+#include <ufo/math/packet.hpp>
+#include <ufo/math/sphere.hpp>
+#include <ufo/math/vec3.hpp>
+#include <ufo/math/vec4.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief Result of a frustum culling test.
+ */
+enum class Containment : std::uint8_t { OUTSIDE, INTERSECTS, INSIDE };
+
+inline std::ostream& operator<<(std::ostream& out, Containment c)
+{
+	switch (c) {
+		case Containment::OUTSIDE: return out << "OUTSIDE";
+		case Containment::INTERSECTS: return out << "INTERSECTS";
+		case Containment::INSIDE: return out << "INSIDE";
+	}
+	return out;
+}
+
+/*!
+ * @brief View frustum given by six normalized planes pointing inwards.
+ *
+ * A point `p` is on the inside of plane `(n, d)` when `dot(n, p) + d >= 0`. The tests are
+ * conservative: a volume is only reported `OUTSIDE` if it is completely outside one of the
+ * planes, so volumes close to the edges of the frustum can be reported `INTERSECTS` even
+ * though they do not touch it.
+ */
+template <class T = float>
+struct Frustum {
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	static constexpr size_type LEFT_PLANE   = 0;
+	static constexpr size_type RIGHT_PLANE  = 1;
+	static constexpr size_type BOTTOM_PLANE = 2;
+	static constexpr size_type TOP_PLANE    = 3;
+	static constexpr size_type NEAR_PLANE   = 4;
+	static constexpr size_type FAR_PLANE    = 5;
+
+	std::array<Vec4<T>, 6> planes{};
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Frustum() noexcept               = default;
+	constexpr Frustum(Frustum const&) noexcept = default;
+
+	constexpr explicit Frustum(std::array<Vec4<T>, 6> const& planes) noexcept
+	    : planes(planes)
+	{
+	}
+
+	/*!
+	 * @brief Extracts the planes of the clip volume of `m` (Gribb & Hartmann).
+	 *
+	 * `m` is typically `projection * view`, where the projection is created by
+	 * `perspective`, `infinitePerspective` or `ortho`. The resulting planes are in the
+	 * space `m` transforms from (world space for `projection * view`).
+	 *
+	 * @param m The view-projection matrix
+	 * @param zero_to_one Whether the depth range of clip space is [0, 1] (as for the
+	 * `ZeroToOne` variants of the projections) or [-1, 1]
+	 */
+	explicit Frustum(Mat4x4<T> const& m, bool zero_to_one = true)
+	{
+		Vec4<T> r0(m[0][0], m[1][0], m[2][0], m[3][0]);
+		Vec4<T> r1(m[0][1], m[1][1], m[2][1], m[3][1]);
+		Vec4<T> r2(m[0][2], m[1][2], m[2][2], m[3][2]);
+		Vec4<T> r3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+		planes[LEFT_PLANE]   = r3 + r0;
+		planes[RIGHT_PLANE]  = r3 - r0;
+		planes[BOTTOM_PLANE] = r3 + r1;
+		planes[TOP_PLANE]    = r3 - r1;
+		planes[NEAR_PLANE]   = zero_to_one ? r2 : r3 + r2;
+		planes[FAR_PLANE]    = r3 - r2;
+
+		for (auto& p : planes) {
+			T len = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+			if (T(0) < len) {
+				p /= len;
+			} else {
+				// Plane at infinity (e.g., far plane of `infinitePerspective`)
+				p = Vec4<T>(T(0), T(0), T(0), T(1));
+			}
+		}
+	}
+
+	constexpr Frustum& operator=(Frustum const&) noexcept = default;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Accessors                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] constexpr Vec4<T>& operator[](size_type pos) noexcept
+	{
+		return planes[pos];
+	}
+
+	[[nodiscard]] constexpr Vec4<T> const& operator[](size_type pos) const noexcept
+	{
+		return planes[pos];
+	}
+
+	[[nodiscard]] static constexpr size_type size() noexcept { return 6; }
+};
+
+using Frustumf = Frustum<float>;
+using Frustumd = Frustum<double>;
+
+/*!
+ * @brief Creates the frustum of a view-projection matrix built with the same template
+ * arguments as `perspective`, `infinitePerspective` and `ortho`.
+ *
+ * Handedness only changes how the projection maps view space into clip space, the clip
+ * volume itself is the same, so `RightHanded` is accepted for symmetry but only
+ * `ZeroToOne` changes the extraction.
+ */
+template <class T, bool RightHanded = true, bool ZeroToOne = true>
+[[nodiscard]] Frustum<T> frustum(Mat4x4<T> const& m)
+{
+	return Frustum<T>(m, ZeroToOne);
+}
+
+template <class T>
+[[nodiscard]] constexpr bool operator==(Frustum<T> const& lhs,
+                                        Frustum<T> const& rhs) noexcept
+{
+	return lhs.planes == rhs.planes;
+}
+
+template <class T>
+[[nodiscard]] constexpr bool operator!=(Frustum<T> const& lhs,
+                                        Frustum<T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, Frustum<T> const& f)
+{
+	using F = Frustum<T>;
+	return out << "Left: " << f[F::LEFT_PLANE] << ", Right: " << f[F::RIGHT_PLANE]
+	           << ", Bottom: " << f[F::BOTTOM_PLANE] << ", Top: " << f[F::TOP_PLANE]
+	           << ", Near: " << f[F::NEAR_PLANE] << ", Far: " << f[F::FAR_PLANE];
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Packets                                       |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief `N` axis-aligned bounding boxes in structure-of-arrays layout, given by their
+ * centers and half sizes.
+ */
+template <class T = float, std::size_t N = packet_size_v<T>>
+struct AABBPacket {
+	static constexpr std::size_t size = N;
+
+	alignas(N * sizeof(T)) std::array<T, N> x;
+	alignas(N * sizeof(T)) std::array<T, N> y;
+	alignas(N * sizeof(T)) std::array<T, N> z;
+	alignas(N * sizeof(T)) std::array<T, N> hx;
+	alignas(N * sizeof(T)) std::array<T, N> hy;
+	alignas(N * sizeof(T)) std::array<T, N> hz;
+
+	constexpr void set(std::size_t lane, AABB<3, T> const& aabb) noexcept
+	{
+		Vec3<T> c = aabb.center();
+		Vec3<T> h = aabb.halfSize();
+		x[lane]   = c.x;
+		y[lane]   = c.y;
+		z[lane]   = c.z;
+		hx[lane]  = h.x;
+		hy[lane]  = h.y;
+		hz[lane]  = h.z;
+	}
+};
+
+/*!
+ * @brief `N` spheres in structure-of-arrays layout.
+ */
+template <class T = float, std::size_t N = packet_size_v<T>>
+struct SpherePacket {
+	static constexpr std::size_t size = N;
+
+	alignas(N * sizeof(T)) std::array<T, N> x;
+	alignas(N * sizeof(T)) std::array<T, N> y;
+	alignas(N * sizeof(T)) std::array<T, N> z;
+	alignas(N * sizeof(T)) std::array<T, N> radius;
+
+	constexpr void set(std::size_t lane, Vec3<T> const& center, T r) noexcept
+	{
+		x[lane]      = center.x;
+		y[lane]      = center.y;
+		z[lane]      = center.z;
+		radius[lane] = r;
+	}
+
+	constexpr void set(std::size_t lane, Sphere<T> const& sphere) noexcept
+	{
+		set(lane, sphere.center, sphere.radius);
+	}
+};
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Functions                                      |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+[[nodiscard]] constexpr bool contains(Frustum<T> const& f, Vec3<T> const& point) noexcept
+{
+	for (auto const& p : f.planes) {
+		if (T(0) > p.x * point.x + p.y * point.y + p.z * point.z + p.w) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <class T>
+[[nodiscard]] Containment classify(Frustum<T> const& f, AABB<3, T> const& aabb) noexcept
+{
+	Vec3<T> c = aabb.center();
+	Vec3<T> h = aabb.halfSize();
+
+	Containment res = Containment::INSIDE;
+	for (auto const& p : f.planes) {
+		T d = p.x * c.x + p.y * c.y + p.z * c.z + p.w;
+		T r = std::abs(p.x) * h.x + std::abs(p.y) * h.y + std::abs(p.z) * h.z;
+		if (-r > d) {
+			return Containment::OUTSIDE;
+		} else if (r > d) {
+			res = Containment::INTERSECTS;
+		}
+	}
+	return res;
+}
+
+template <class T>
+[[nodiscard]] constexpr Containment classify(Frustum<T> const& f, Vec3<T> const& center,
+                                             T radius) noexcept
+{
+	Containment res = Containment::INSIDE;
+	for (auto const& p : f.planes) {
+		T d = p.x * center.x + p.y * center.y + p.z * center.z + p.w;
+		if (-radius > d) {
+			return Containment::OUTSIDE;
+		} else if (radius > d) {
+			res = Containment::INTERSECTS;
+		}
+	}
+	return res;
+}
+
+template <class T>
+[[nodiscard]] constexpr Containment classify(Frustum<T> const& f,
+                                             Sphere<T> const&  sphere) noexcept
+{
+	return classify(f, sphere.center, sphere.radius);
+}
+
+/*!
+ * @brief Classifies all `N` boxes of `packet` at once.
+ *
+ * The lanes are processed without branches so that the loops compile to one vector
+ * operation per plane and coordinate.
+ */
+template <class T, std::size_t N>
+[[nodiscard]] std::array<Containment, N> classify(Frustum<T> const&      f,
+                                                  AABBPacket<T, N> const& packet) noexcept
+{
+	std::array<bool, N> outside{};
+	std::array<bool, N> intersects{};
+
+	for (auto const& p : f.planes) {
+		T const ax = std::abs(p.x);
+		T const ay = std::abs(p.y);
+		T const az = std::abs(p.z);
+		for (std::size_t i{}; N > i; ++i) {
+			T d = p.x * packet.x[i] + p.y * packet.y[i] + p.z * packet.z[i] + p.w;
+			T r = ax * packet.hx[i] + ay * packet.hy[i] + az * packet.hz[i];
+			outside[i] |= -r > d;
+			intersects[i] |= r > d;
+		}
+	}
+
+	std::array<Containment, N> res;
+	for (std::size_t i{}; N > i; ++i) {
+		res[i] = static_cast<Containment>(2 - int(intersects[i]) - int(outside[i]));
+	}
+	return res;
+}
+
+/*!
+ * @brief Classifies all `N` spheres of `packet` at once.
+ */
+template <class T, std::size_t N>
+[[nodiscard]] std::array<Containment, N> classify(
+    Frustum<T> const& f, SpherePacket<T, N> const& packet) noexcept
+{
+	std::array<bool, N> outside{};
+	std::array<bool, N> intersects{};
+
+	for (auto const& p : f.planes) {
+		for (std::size_t i{}; N > i; ++i) {
+			T d = p.x * packet.x[i] + p.y * packet.y[i] + p.z * packet.z[i] + p.w;
+			outside[i] |= -packet.radius[i] > d;
+			intersects[i] |= packet.radius[i] > d;
+		}
+	}
+
+	std::array<Containment, N> res;
+	for (std::size_t i{}; N > i; ++i) {
+		res[i] = static_cast<Containment>(2 - int(intersects[i]) - int(outside[i]));
+	}
+	return res;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Batch                                        |
+|                                                                                     |
+**************************************************************************************/
+
+namespace detail
+{
+template <class T, std::size_t N, class RandomIt1, class RandomIt2>
+void classifyBlock(Frustum<T> const& f, RandomIt1 first, std::size_t count,
+                   RandomIt2 d_first)
+{
+	using value_type = typename std::iterator_traits<RandomIt1>::value_type;
+	using packet_type =
+	    std::conditional_t<std::is_same_v<Sphere<T>, value_type>, SpherePacket<T, N>,
+	                       AABBPacket<T, N>>;
+
+	packet_type packet{};
+	for (std::size_t i{}; count > i; ++i) {
+		packet.set(i, first[i]);
+	}
+	auto res = classify(f, packet);
+	std::copy(res.begin(), res.begin() + count, d_first);
+}
+}  // namespace detail
+
+/*!
+ * @brief Classifies the `AABB<3, T>`s or `Sphere<T>`s in [`first`, `last`), `N` at a
+ * time, and writes the results to `d_first`.
+ */
+template <class T, std::size_t N = packet_size_v<T>, class RandomIt1, class RandomIt2>
+RandomIt2 classify(Frustum<T> const& f, RandomIt1 first, RandomIt1 last,
+                   RandomIt2 d_first)
+{
+	std::size_t const size = std::distance(first, last);
+	for (std::size_t i{}; size > i; i += N) {
+		detail::classifyBlock<T, N>(f, first + i, std::min(N, size - i), d_first + i);
+	}
+	return d_first + size;
+}
+
+template <
+    class T, std::size_t N = packet_size_v<T>, class ExecutionPolicy, class RandomIt1,
+    class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 classify(ExecutionPolicy&& policy, Frustum<T> const& f, RandomIt1 first,
+                   RandomIt1 last, RandomIt2 d_first)
+{
+	std::size_t const size   = std::distance(first, last);
+	std::size_t const blocks = (size + N - 1) / N;
+	detail::forEach(std::forward<ExecutionPolicy>(policy), 0, blocks,
+	                [&f, first, size, d_first](std::size_t b) {
+		                std::size_t const i = b * N;
+		                detail::classifyBlock<T, N>(f, first + i, std::min(N, size - i),
+		                                            d_first + i);
+	                });
+	return d_first + size;
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_FRUSTUM_HPP
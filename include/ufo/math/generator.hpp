@@ -0,0 +1,187 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_GENERATOR_HPP
+#define UFO_MATH_GENERATOR_HPP
+
+// STL
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief Coroutine that produces a sequence of `T` with `co_yield`, one value per
+ * resumption.
+ *
+ * The body runs lazily: nothing happens until `begin` is called, and every increment of
+ * the iterator runs the body up to the next `co_yield`. A yielded value stays valid until
+ * the iterator is incremented. An exception thrown by the body is rethrown from `begin`
+ * or the increment that resumed it.
+ */
+template <class T>
+class Generator
+{
+ public:
+	struct promise_type {
+		T const*           value{};
+		std::exception_ptr error{};
+
+		Generator get_return_object() noexcept
+		{
+			return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() const noexcept { return {}; }
+
+		std::suspend_always final_suspend() const noexcept { return {}; }
+
+		std::suspend_always yield_value(T const& v) noexcept
+		{
+			value = std::addressof(v);
+			return {};
+		}
+
+		void return_void() const noexcept {}
+
+		void unhandled_exception() noexcept { error = std::current_exception(); }
+	};
+
+	class iterator
+	{
+	 public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type        = T;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = T const*;
+		using reference         = T const&;
+
+		iterator() = default;
+
+		[[nodiscard]] reference operator*() const { return *handle_.promise().value; }
+
+		[[nodiscard]] pointer operator->() const { return handle_.promise().value; }
+
+		iterator& operator++()
+		{
+			resume(handle_);
+			return *this;
+		}
+
+		void operator++(int) { ++*this; }
+
+		[[nodiscard]] friend bool operator==(iterator const& it,
+		                                     std::default_sentinel_t) noexcept
+		{
+			return !it.handle_ || it.handle_.done();
+		}
+
+	 private:
+		explicit iterator(std::coroutine_handle<promise_type> handle) noexcept
+		    : handle_(handle)
+		{
+		}
+
+		friend class Generator;
+
+	 private:
+		std::coroutine_handle<promise_type> handle_{};
+	};
+
+	Generator(Generator const&) = delete;
+
+	Generator(Generator&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+	Generator& operator=(Generator const&) = delete;
+
+	Generator& operator=(Generator&& rhs) noexcept
+	{
+		if (this != &rhs) {
+			if (handle_) {
+				handle_.destroy();
+			}
+			handle_ = std::exchange(rhs.handle_, {});
+		}
+		return *this;
+	}
+
+	~Generator()
+	{
+		if (handle_) {
+			handle_.destroy();
+		}
+	}
+
+	/*!
+	 * @brief Runs the body up to the first `co_yield`, can only be called once.
+	 */
+	[[nodiscard]] iterator begin()
+	{
+		resume(handle_);
+		return iterator(handle_);
+	}
+
+	[[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+ private:
+	explicit Generator(std::coroutine_handle<promise_type> handle) noexcept
+	    : handle_(handle)
+	{
+	}
+
+	static void resume(std::coroutine_handle<promise_type> handle)
+	{
+		handle.resume();
+		if (handle.promise().error) {
+			std::rethrow_exception(std::exchange(handle.promise().error, {}));
+		}
+	}
+
+ private:
+	std::coroutine_handle<promise_type> handle_;
+};
+}  // namespace ufo
+
+#endif  // UFO_MATH_GENERATOR_HPP
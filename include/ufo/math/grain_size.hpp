@@ -0,0 +1,110 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_GRAIN_SIZE_HPP
+#define UFO_MATH_GRAIN_SIZE_HPP
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+namespace ufo
+{
+/*!
+ * @brief Cost model for the parallel `transform` and `transformInPlace` overloads that
+ * apply a `Transform` or `QuatTransform` to points, including the strided ones.
+ *
+ * Starting a parallel loop costs microseconds, while transforming a point costs about a
+ * nanosecond, so small inputs are faster on the calling thread. The defaults fit a
+ * rigid transform of `Vec3f`s on a desktop CPU; `calibrateGrainSize` measures them for
+ * the machine at hand. Other batch operations, such as quantization or BVH queries, do
+ * not use it and always run with the policy as given.
+ */
+struct GrainSize {
+	// Inputs smaller than this run sequentially, whatever the execution policy
+	std::size_t sequential_below = 4096;
+	// Fewest elements worth handing to a thread, limits the threads for mid-sized inputs
+	std::size_t min_per_thread = 1024;
+};
+
+namespace detail
+{
+inline std::atomic<std::size_t> grain_sequential_below{GrainSize{}.sequential_below};
+inline std::atomic<std::size_t> grain_min_per_thread{GrainSize{}.min_per_thread};
+
+[[nodiscard]] inline std::size_t hardwareThreads() noexcept
+{
+	static std::size_t const threads = std::max(1u, std::thread::hardware_concurrency());
+	return threads;
+}
+
+/*!
+ * @brief Number of threads worth using for `size` elements, at least one.
+ */
+[[nodiscard]] inline std::size_t parallelThreads(std::size_t size) noexcept
+{
+	std::size_t const min_per_thread =
+	    std::max(std::size_t(1), grain_min_per_thread.load(std::memory_order_relaxed));
+	return std::clamp(size / min_per_thread, std::size_t(1), hardwareThreads());
+}
+
+[[nodiscard]] inline bool runSequential(std::size_t size) noexcept
+{
+	return grain_sequential_below.load(std::memory_order_relaxed) > size;
+}
+}  // namespace detail
+
+[[nodiscard]] inline GrainSize grainSize() noexcept
+{
+	return {detail::grain_sequential_below.load(std::memory_order_relaxed),
+	        detail::grain_min_per_thread.load(std::memory_order_relaxed)};
+}
+
+inline void setGrainSize(GrainSize const& grain) noexcept
+{
+	detail::grain_sequential_below.store(grain.sequential_below, std::memory_order_relaxed);
+	detail::grain_min_per_thread.store(grain.min_per_thread, std::memory_order_relaxed);
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_GRAIN_SIZE_HPP
@@ -0,0 +1,322 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_HALF_HPP
+#define UFO_MATH_HALF_HPP
+
+// UFO
+#include <ufo/math/detail/vec.hpp>
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__F16C__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace ufo
+{
+namespace detail
+{
+[[nodiscard]] inline std::uint32_t floatBits(float f) noexcept
+{
+	std::uint32_t u;
+	std::memcpy(&u, &f, sizeof(u));
+	return u;
+}
+
+[[nodiscard]] inline float bitsFloat(std::uint32_t u) noexcept
+{
+	float f;
+	std::memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+// Round to nearest even, based on float_to_half_fast3_rtne by Fabian Giesen
+[[nodiscard]] inline std::uint16_t floatToHalf(float f) noexcept
+{
+#if defined(__F16C__)
+	return static_cast<std::uint16_t>(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#else
+	constexpr std::uint32_t f32_infty  = 255u << 23;
+	constexpr std::uint32_t f16_max    = (127u + 16u) << 23;
+	constexpr std::uint32_t denorm_mag = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+	std::uint32_t u    = floatBits(f);
+	std::uint32_t sign = u & 0x80000000u;
+	u ^= sign;
+
+	std::uint16_t h;
+	if (u >= f16_max) {
+		// Inf or NaN (all exponent bits set)
+		h = u > f32_infty ? 0x7E00u : 0x7C00u;
+	} else if (u < (113u << 23)) {
+		// Resulting value is a subnormal or zero, let the FPU do the rounding
+		h = static_cast<std::uint16_t>(
+		    floatBits(bitsFloat(u) + bitsFloat(denorm_mag)) - denorm_mag);
+	} else {
+		std::uint32_t mant_odd = (u >> 13) & 1u;
+		// Update exponent, rounding bias part 1
+		u += (static_cast<std::uint32_t>(15 - 127) << 23) + 0xFFFu;
+		// Rounding bias part 2
+		u += mant_odd;
+		h = static_cast<std::uint16_t>(u >> 13);
+	}
+
+	return static_cast<std::uint16_t>(h | (sign >> 16));
+#endif
+}
+
+// Based on half_to_float by Fabian Giesen
+[[nodiscard]] inline float halfToFloat(std::uint16_t h) noexcept
+{
+#if defined(__F16C__)
+	return _cvtsh_ss(h);
+#else
+	constexpr std::uint32_t shifted_exp = 0x7C00u << 13;
+
+	std::uint32_t u   = (h & 0x7FFFu) << 13;
+	std::uint32_t exp = shifted_exp & u;
+	u += (127u - 15u) << 23;
+
+	if (shifted_exp == exp) {
+		// Inf or NaN
+		u += (128u - 16u) << 23;
+	} else if (0u == exp) {
+		// Zero or subnormal, renormalize
+		u += 1u << 23;
+		u = floatBits(bitsFloat(u) - bitsFloat(113u << 23));
+	}
+
+	return bitsFloat(u | (static_cast<std::uint32_t>(h & 0x8000u) << 16));
+#endif
+}
+
+[[nodiscard]] inline std::uint16_t floatToBFloat16(float f) noexcept
+{
+	std::uint32_t u = floatBits(f);
+	if ((u & 0x7FFFFFFFu) > 0x7F800000u) {
+		// Quiet NaN, keep the sign
+		return static_cast<std::uint16_t>((u >> 16) | 0x0040u);
+	}
+	// Round to nearest even
+	u += 0x7FFFu + ((u >> 16) & 1u);
+	return static_cast<std::uint16_t>(u >> 16);
+}
+
+[[nodiscard]] inline float bfloat16ToFloat(std::uint16_t b) noexcept
+{
+	return bitsFloat(static_cast<std::uint32_t>(b) << 16);
+}
+}  // namespace detail
+
+/*!
+ * @brief IEEE 754 binary16 storage type.
+ *
+ * Only meant for storage, all arithmetic is done in `float`. `Half` converts implicitly
+ * to and from `float`, so it can be used as the scalar type of the `Vec` templates
+ * (e.g., `Vec3h`). Use `convert` to convert whole arrays, which uses F16C/AVX-512 when
+ * available.
+ */
+struct Half {
+	std::uint16_t bits{};
+
+	constexpr Half() noexcept = default;
+
+	Half(float value) noexcept : bits(detail::floatToHalf(value)) {}
+
+	template <class U, std::enable_if_t<std::is_arithmetic_v<U>, bool> = true>
+	explicit Half(U value) noexcept : Half(static_cast<float>(value))
+	{
+	}
+
+	[[nodiscard]] static constexpr Half fromBits(std::uint16_t bits) noexcept
+	{
+		Half h;
+		h.bits = bits;
+		return h;
+	}
+
+	operator float() const noexcept { return detail::halfToFloat(bits); }
+
+	Half& operator+=(float rhs) noexcept { return *this = float(*this) + rhs; }
+	Half& operator-=(float rhs) noexcept { return *this = float(*this) - rhs; }
+	Half& operator*=(float rhs) noexcept { return *this = float(*this) * rhs; }
+	Half& operator/=(float rhs) noexcept { return *this = float(*this) / rhs; }
+};
+
+/*!
+ * @brief bfloat16 storage type (the upper 16 bits of an IEEE 754 binary32).
+ *
+ * Same range as `float` with 8 bits of precision. Like `Half`, all arithmetic is done in
+ * `float`.
+ */
+struct BFloat16 {
+	std::uint16_t bits{};
+
+	constexpr BFloat16() noexcept = default;
+
+	BFloat16(float value) noexcept : bits(detail::floatToBFloat16(value)) {}
+
+	template <class U, std::enable_if_t<std::is_arithmetic_v<U>, bool> = true>
+	explicit BFloat16(U value) noexcept : BFloat16(static_cast<float>(value))
+	{
+	}
+
+	[[nodiscard]] static constexpr BFloat16 fromBits(std::uint16_t bits) noexcept
+	{
+		BFloat16 b;
+		b.bits = bits;
+		return b;
+	}
+
+	operator float() const noexcept { return detail::bfloat16ToFloat(bits); }
+
+	BFloat16& operator+=(float rhs) noexcept { return *this = float(*this) + rhs; }
+	BFloat16& operator-=(float rhs) noexcept { return *this = float(*this) - rhs; }
+	BFloat16& operator*=(float rhs) noexcept { return *this = float(*this) * rhs; }
+	BFloat16& operator/=(float rhs) noexcept { return *this = float(*this) / rhs; }
+};
+
+static_assert(2 == sizeof(Half));
+static_assert(2 == sizeof(BFloat16));
+
+using Vec1h  = Vec1<Half>;
+using Vec2h  = Vec2<Half>;
+using Vec3h  = Vec3<Half>;
+using Vec4h  = Vec4<Half>;
+using Vec1bf = Vec1<BFloat16>;
+using Vec2bf = Vec2<BFloat16>;
+using Vec3bf = Vec3<BFloat16>;
+using Vec4bf = Vec4<BFloat16>;
+
+/**************************************************************************************
+|                                                                                     |
+|                                  Bulk conversion                                    |
+|                                                                                     |
+**************************************************************************************/
+
+inline float* convert(Half const* first, Half const* last, float* d_first) noexcept
+{
+	std::size_t const size = static_cast<std::size_t>(last - first);
+	std::size_t       i{};
+#if defined(__AVX512F__)
+	for (; size >= i + 16; i += 16) {
+		__m256i h = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first + i));
+		// The maskz variants avoid GCC's maybe-uninitialized false positives
+		_mm512_storeu_ps(d_first + i, _mm512_maskz_cvtph_ps(0xFFFF, h));
+	}
+#endif
+#if defined(__F16C__)
+	for (; size >= i + 8; i += 8) {
+		__m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + i));
+		_mm256_storeu_ps(d_first + i, _mm256_cvtph_ps(h));
+	}
+#endif
+	for (; size != i; ++i) {
+		d_first[i] = first[i];
+	}
+	return d_first + size;
+}
+
+inline Half* convert(float const* first, float const* last, Half* d_first) noexcept
+{
+	std::size_t const size = static_cast<std::size_t>(last - first);
+	std::size_t       i{};
+#if defined(__AVX512F__)
+	for (; size >= i + 16; i += 16) {
+		__m256i h = _mm512_maskz_cvtps_ph(0xFFFF, _mm512_loadu_ps(first + i),
+		                                  _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(d_first + i), h);
+	}
+#endif
+#if defined(__F16C__)
+	for (; size >= i + 8; i += 8) {
+		__m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(first + i), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(d_first + i), h);
+	}
+#endif
+	for (; size != i; ++i) {
+		d_first[i] = first[i];
+	}
+	return d_first + size;
+}
+
+inline float* convert(BFloat16 const* first, BFloat16 const* last,
+                      float* d_first) noexcept
+{
+	// Plain integer shifts, the compiler vectorizes this loop
+	std::size_t const size = static_cast<std::size_t>(last - first);
+	for (std::size_t i{}; size != i; ++i) {
+		d_first[i] = first[i];
+	}
+	return d_first + size;
+}
+
+inline BFloat16* convert(float const* first, float const* last,
+                         BFloat16* d_first) noexcept
+{
+	std::size_t const size = static_cast<std::size_t>(last - first);
+	for (std::size_t i{}; size != i; ++i) {
+		d_first[i] = first[i];
+	}
+	return d_first + size;
+}
+
+template <std::size_t Dim, class T, class U,
+          std::enable_if_t<std::is_same_v<float, T> != std::is_same_v<float, U>, bool> =
+              true>
+Vec<Dim, U>* convert(Vec<Dim, T> const* first, Vec<Dim, T> const* last,
+                     Vec<Dim, U>* d_first) noexcept
+{
+	// The components of a `Vec` are laid out contiguously
+	static_assert(sizeof(Vec<Dim, T>) == Dim * sizeof(T));
+	static_assert(sizeof(Vec<Dim, U>) == Dim * sizeof(U));
+	convert(first->data(), first->data() + Dim * static_cast<std::size_t>(last - first),
+	        d_first->data());
+	return d_first + (last - first);
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_HALF_HPP
@@ -0,0 +1,500 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_ICP_HPP
+#define UFO_MATH_ICP_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/kdtree.hpp>
+#include <ufo/math/mat3x3.hpp>
+#include <ufo/math/matn.hpp>
+#include <ufo/math/packet.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+#include <ufo/math/vecn.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/**************************************************************************************
+|                                                                                     |
+|                                        SE(3)                                        |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief The exponential map of SE(3), the rigid transform of the twist with rotation part
+ * `omega` (axis times angle) and translation part `v`.
+ */
+template <class T>
+[[nodiscard]] Transform<3, T> se3Exp(Vec3<T> const& omega, Vec3<T> const& v)
+{
+	T const theta_sq = dot(omega, omega);
+	T const theta    = std::sqrt(theta_sq);
+
+	// Coefficients of [omega]x and [omega]x^2 in R and in the left Jacobian V
+	T a, b, c;
+	if (T(1e-8) > theta_sq) {
+		a = T(1) - theta_sq / T(6);
+		b = T(0.5) - theta_sq / T(24);
+		c = T(1) / T(6) - theta_sq / T(120);
+	} else {
+		a = std::sin(theta) / theta;
+		b = (T(1) - std::cos(theta)) / theta_sq;
+		c = (theta - std::sin(theta)) / (theta_sq * theta);
+	}
+
+	// Column-major, W[column][row]
+	Mat<3, 3, T> W(T(0));
+	W[1][0] = -omega.z;
+	W[2][0] = omega.y;
+	W[0][1] = omega.z;
+	W[2][1] = -omega.x;
+	W[0][2] = -omega.y;
+	W[1][2] = omega.x;
+	Mat<3, 3, T> const W2 = W * W;
+
+	Mat<3, 3, T> R;
+	Mat<3, 3, T> V;
+	for (std::size_t i{}; 3 > i; ++i) {
+		for (std::size_t j{}; 3 > j; ++j) {
+			R[i][j] += a * W[i][j] + b * W2[i][j];
+			V[i][j] += b * W[i][j] + c * W2[i][j];
+		}
+	}
+	return Transform<3, T>(R, V * v);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                   Robust kernels                                    |
+|                                                                                     |
+**************************************************************************************/
+
+enum class RobustKernel : std::uint8_t { NONE, HUBER, CAUCHY };
+
+inline std::ostream& operator<<(std::ostream& out, RobustKernel k)
+{
+	switch (k) {
+		case RobustKernel::NONE: return out << "NONE";
+		case RobustKernel::HUBER: return out << "HUBER";
+		case RobustKernel::CAUCHY: return out << "CAUCHY";
+	}
+	return out;
+}
+
+/*!
+ * @brief Iteratively reweighted least squares weight of `residual` under `kernel` with
+ * scale `k`.
+ */
+template <class T>
+[[nodiscard]] T robustWeight(RobustKernel kernel, T residual, T k) noexcept
+{
+	switch (kernel) {
+		case RobustKernel::NONE: return T(1);
+		case RobustKernel::HUBER: return k / std::max(k, std::abs(residual));
+		case RobustKernel::CAUCHY: return T(1) / (T(1) + (residual * residual) / (k * k));
+	}
+	return T(1);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                  Normal equations                                   |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Gauss-Newton normal equations `H x = -b` of point-to-plane residuals for a twist
+ * `x = (omega, v)` applied on the left of the current transform.
+ *
+ * Only the upper triangle of `H` is accumulated, row by row in `h`.
+ */
+template <class T>
+struct NormalEquations {
+	std::array<T, 21> h{};
+	std::array<T, 6>  b{};
+	T                 chi2{};
+	std::size_t       count{};
+
+	/*!
+	 * @brief Adds the residual `dot(normal, point - target)` of the already transformed
+	 * `point` with `weight`.
+	 */
+	constexpr void add(Vec3<T> const& point, Vec3<T> const& target, Vec3<T> const& normal,
+	                   T weight) noexcept
+	{
+		T const                r = dot(normal, point - target);
+		Vec3<T> const          c = cross(point, normal);
+		std::array<T, 6> const J{c.x, c.y, c.z, normal.x, normal.y, normal.z};
+		for (std::size_t i{}, k{}; 6 > i; ++i) {
+			for (std::size_t j = i; 6 > j; ++j, ++k) {
+				h[k] += weight * J[i] * J[j];
+			}
+			b[i] += weight * J[i] * r;
+		}
+		chi2 += r * r;
+		++count;
+	}
+
+	constexpr NormalEquations& operator+=(NormalEquations const& rhs) noexcept
+	{
+		for (std::size_t i{}; h.size() > i; ++i) {
+			h[i] += rhs.h[i];
+		}
+		for (std::size_t i{}; b.size() > i; ++i) {
+			b[i] += rhs.b[i];
+		}
+		chi2 += rhs.chi2;
+		count += rhs.count;
+		return *this;
+	}
+
+	/*!
+	 * @brief Solves for the twist with a Cholesky factorization.
+	 *
+	 * @return The rotation and translation parts, or `false` if `H` is not positive
+	 * definite, e.g. because the geometry does not constrain every direction.
+	 */
+	[[nodiscard]] bool solve(Vec3<T>& omega, Vec3<T>& v) const noexcept
+	{
+		Mat6<T> L;
+		for (std::size_t i{}, k{}; 6 > i; ++i) {
+			for (std::size_t j = i; 6 > j; ++j, ++k) {
+				L[i][j] = h[k];
+			}
+		}
+
+		if (!cholesky(L)) {
+			return false;
+		}
+
+		Vec6<T> x(-b[0], -b[1], -b[2], -b[3], -b[4], -b[5]);
+		choleskySolve(L, x);
+
+		omega = Vec3<T>(x[0], x[1], x[2]);
+		v     = Vec3<T>(x[3], x[4], x[5]);
+		return true;
+	}
+};
+
+/**************************************************************************************
+|                                                                                     |
+|                                         ICP                                         |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T = float>
+struct IcpParams {
+	// Source points farther than this from their closest target point are ignored
+	T max_correspondence_distance = T(1);
+
+	RobustKernel kernel       = RobustKernel::HUBER;
+	T            kernel_scale = T(0.1);
+
+	std::size_t max_iterations = 30;
+
+	// Stops once both the rotation (radians) and translation of an update are smaller
+	T convergence = T(1e-5);
+};
+
+template <class T = float>
+struct IcpResult {
+	Transform<3, T> transform;
+	// Number of correspondences of the last iteration
+	std::size_t correspondences{};
+	// Root mean square point-to-plane residual of the last iteration, before its update
+	T           rmse = std::numeric_limits<T>::infinity();
+	std::size_t iterations{};
+	bool        converged = false;
+};
+
+namespace detail
+{
+// Partial sums of one task, padded so that neighbouring tasks do not share a cache line
+template <class T>
+struct alignas(64) PaddedNormalEquations {
+	NormalEquations<T> value;
+};
+
+inline constexpr std::size_t icp_max_blocks = 64;
+inline constexpr std::size_t icp_min_block  = 512;
+
+/*!
+ * @brief Accumulates the point-to-plane equations of `[first, first + size)` one packet at
+ * a time: closest points are looked up per point, the residuals, weights and Jacobian
+ * products are evaluated over the lanes of the packet.
+ */
+template <class T, class RandomIt1, class RandomIt2>
+void pointToPlaneBlock(NormalEquations<T>& eq, Transform<3, T> const& transform,
+                       RandomIt1 first, std::size_t size, KDTree<3, T> const& target,
+                       RandomIt2 target_normals, IcpParams<T> const& params)
+{
+	constexpr std::size_t N = packet_size_v<T>;
+
+	T const k        = params.kernel_scale;
+	T const max_dist = params.max_correspondence_distance;
+
+	// Consecutive source points are usually close (sensor order), so the distance of the
+	// previous correspondence plus the step between the points bounds the next search
+	Vec3<T> previous;
+	T       previous_distance = std::numeric_limits<T>::infinity();
+
+	for (std::size_t s{}; size > s; s += N) {
+		std::size_t const count = std::min(N, size - s);
+
+		std::array<T, N> px{}, py{}, pz{}, qx{}, qy{}, qz{}, nx{}, ny{}, nz{}, valid{};
+		for (std::size_t i{}; count > i; ++i) {
+			Vec3<T> const p = transform(first[s + i]);
+			px[i]           = p.x;
+			py[i]           = p.y;
+			pz[i]           = p.z;
+
+			T const bound = previous_distance + distance(previous, p);
+			auto [index, d2] = target.nearest(p, std::min(max_dist, bound));
+			if (std::numeric_limits<std::size_t>::max() == index && max_dist > bound) {
+				std::tie(index, d2) = target.nearest(p, max_dist);
+			}
+			previous          = p;
+			previous_distance = std::sqrt(d2);
+
+			if (std::numeric_limits<std::size_t>::max() != index) {
+				Vec3<T> const q = target.point(index);
+				Vec3<T> const n = target_normals[index];
+				qx[i]           = q.x;
+				qy[i]           = q.y;
+				qz[i]           = q.z;
+				nx[i]           = n.x;
+				ny[i]           = n.y;
+				nz[i]           = n.z;
+				valid[i]        = T(1);
+			}
+		}
+
+		std::array<std::array<T, N>, 6> J;
+		std::array<T, N>                r, w;
+		for (std::size_t i{}; N > i; ++i) {
+			r[i]    = nx[i] * (px[i] - qx[i]) + ny[i] * (py[i] - qy[i]) + nz[i] * (pz[i] - qz[i]);
+			J[0][i] = py[i] * nz[i] - pz[i] * ny[i];
+			J[1][i] = pz[i] * nx[i] - px[i] * nz[i];
+			J[2][i] = px[i] * ny[i] - py[i] * nx[i];
+			J[3][i] = nx[i];
+			J[4][i] = ny[i];
+			J[5][i] = nz[i];
+		}
+
+		switch (params.kernel) {
+			case RobustKernel::NONE:
+				for (std::size_t i{}; N > i; ++i) {
+					w[i] = valid[i];
+				}
+				break;
+			case RobustKernel::HUBER:
+				for (std::size_t i{}; N > i; ++i) {
+					w[i] = valid[i] * k / std::max(k, std::abs(r[i]));
+				}
+				break;
+			case RobustKernel::CAUCHY:
+				for (std::size_t i{}; N > i; ++i) {
+					w[i] = valid[i] / (T(1) + (r[i] * r[i]) / (k * k));
+				}
+				break;
+		}
+
+		for (std::size_t a{}, h{}; 6 > a; ++a) {
+			for (std::size_t c = a; 6 > c; ++c, ++h) {
+				T sum{};
+				for (std::size_t i{}; N > i; ++i) {
+					sum += w[i] * J[a][i] * J[c][i];
+				}
+				eq.h[h] += sum;
+			}
+			T sum{};
+			for (std::size_t i{}; N > i; ++i) {
+				sum += w[i] * J[a][i] * r[i];
+			}
+			eq.b[a] += sum;
+		}
+
+		T           chi2{};
+		std::size_t n{};
+		for (std::size_t i{}; N > i; ++i) {
+			chi2 += valid[i] * r[i] * r[i];
+			n += T(0) != valid[i] ? 1 : 0;
+		}
+		eq.chi2 += chi2;
+		eq.count += n;
+	}
+}
+
+/*!
+ * @brief Splits the source into a fixed number of blocks, so the merged sums do not
+ * depend on the execution policy, accumulates each into its own padded partial and then
+ * merges them in order.
+ */
+template <class ForEach, class T, class RandomIt1, class RandomIt2>
+[[nodiscard]] NormalEquations<T> pointToPlaneEquations(
+    ForEach for_each, Transform<3, T> const& transform, RandomIt1 first, RandomIt1 last,
+    KDTree<3, T> const& target, RandomIt2 target_normals, IcpParams<T> const& params)
+{
+	std::size_t const size   = std::distance(first, last);
+	std::size_t const blocks = std::clamp<std::size_t>(size / icp_min_block, 1, icp_max_blocks);
+
+	std::array<PaddedNormalEquations<T>, icp_max_blocks> partial{};
+	for_each(0, blocks, [&](std::size_t b) {
+		std::size_t const begin = size * b / blocks;
+		std::size_t const end   = size * (b + 1) / blocks;
+		pointToPlaneBlock(partial[b].value, transform, first + begin, end - begin, target,
+		                  target_normals, params);
+	});
+
+	NormalEquations<T> eq;
+	for (std::size_t b{}; blocks > b; ++b) {
+		eq += partial[b].value;
+	}
+	return eq;
+}
+
+template <class ForEach, class T, class RandomIt1, class RandomIt2>
+[[nodiscard]] IcpResult<T> icp(ForEach for_each, RandomIt1 first, RandomIt1 last,
+                               KDTree<3, T> const& target, RandomIt2 target_normals,
+                               Transform<3, T> const& initial, IcpParams<T> const& params)
+{
+	IcpResult<T> res;
+	res.transform = initial;
+	for (; params.max_iterations > res.iterations && !res.converged; ++res.iterations) {
+		NormalEquations<T> const eq = pointToPlaneEquations(
+		    for_each, res.transform, first, last, target, target_normals, params);
+
+		res.correspondences = eq.count;
+		res.rmse            = 0 == eq.count ? std::numeric_limits<T>::infinity()
+		                                    : std::sqrt(eq.chi2 / static_cast<T>(eq.count));
+
+		Vec3<T> omega, v;
+		if (!eq.solve(omega, v)) {
+			break;
+		}
+		res.transform = se3Exp(omega, v) * res.transform;
+		res.converged = params.convergence > norm(omega) && params.convergence > norm(v);
+	}
+	return res;
+}
+}  // namespace detail
+
+/*!
+ * @brief Point-to-plane normal equations of the source points `[first, last)` moved by
+ * `transform`, against their closest points in `target`.
+ *
+ * `target_normals` holds the normal of each target point in the order the tree was built
+ * from. Does not allocate.
+ */
+template <class T, class RandomIt1, class RandomIt2>
+[[nodiscard]] NormalEquations<T> pointToPlaneEquations(
+    Transform<3, T> const& transform, RandomIt1 first, RandomIt1 last,
+    KDTree<3, T> const& target, RandomIt2 target_normals,
+    IcpParams<T> const& params = IcpParams<T>{})
+{
+	return detail::pointToPlaneEquations(detail::SequentialForEach{}, transform, first, last,
+	                                     target, target_normals, params);
+}
+
+/*!
+ * @brief The source is split into at most 64 blocks that are accumulated in parallel, the
+ * result is identical to the sequential version.
+ */
+template <
+    class ExecutionPolicy, class T, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] NormalEquations<T> pointToPlaneEquations(
+    ExecutionPolicy&& policy, Transform<3, T> const& transform, RandomIt1 first,
+    RandomIt1 last, KDTree<3, T> const& target, RandomIt2 target_normals,
+    IcpParams<T> const& params = IcpParams<T>{})
+{
+	return detail::pointToPlaneEquations(detail::PolicyForEach<ExecutionPolicy>{policy},
+	                                     transform, first, last, target, target_normals,
+	                                     params);
+}
+
+/*!
+ * @brief Point-to-plane ICP registering the source points `[first, last)` to `target`,
+ * starting from `initial`.
+ *
+ * Each iteration finds the closest target points, solves the robustly weighted normal
+ * equations and applies the update through the SE(3) exponential map. Does not allocate.
+ */
+template <class T, class RandomIt1, class RandomIt2>
+[[nodiscard]] IcpResult<T> icp(RandomIt1 first, RandomIt1 last, KDTree<3, T> const& target,
+                               RandomIt2              target_normals,
+                               Transform<3, T> const& initial = Transform<3, T>(),
+                               IcpParams<T> const&    params  = IcpParams<T>{})
+{
+	return detail::icp(detail::SequentialForEach{}, first, last, target, target_normals,
+	                   initial, params);
+}
+
+template <
+    class ExecutionPolicy, class T, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] IcpResult<T> icp(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                               KDTree<3, T> const& target, RandomIt2 target_normals,
+                               Transform<3, T> const& initial = Transform<3, T>(),
+                               IcpParams<T> const&    params  = IcpParams<T>{})
+{
+	return detail::icp(detail::PolicyForEach<ExecutionPolicy>{policy}, first, last, target,
+	                   target_normals, initial, params);
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_ICP_HPP
@@ -0,0 +1,664 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_KDTREE_HPP
+#define UFO_MATH_KDTREE_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/aabb.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Static k-d tree over points (`Vec<Dim, T>`).
+ *
+ * The tree is implicit: the points are stored in one array where the median of a range
+ * splits it into the two halves below it, so no node is ever allocated. Ranges of at most
+ * `leaf_size` points are leaves and are scanned linearly. Only the split dimension is
+ * stored, one byte per point.
+ *
+ * k-nearest neighbour and radius queries write into caller provided buffers and do not
+ * allocate. Reported indices refer to the order of the points the tree was built from and
+ * reported distances are squared.
+ */
+template <std::size_t Dim, class T = float>
+class KDTree
+{
+	static_assert(std::is_floating_point_v<T>);
+
+ public:
+	/**************************************************************************************
+	|                                                                                     |
+	|                                        Types                                        |
+	|                                                                                     |
+	**************************************************************************************/
+
+	using value_type = T;
+	using point_type = Vec<Dim, T>;
+	using size_type  = std::size_t;
+
+	static constexpr size_type leaf_size = 8;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	KDTree() = default;
+
+	template <class InputIt>
+	KDTree(InputIt first, InputIt last) : points_(first, last)
+	{
+		build(detail::SequentialForEach{});
+	}
+
+	/*!
+	 * @brief Builds the tree in parallel, the result is identical to the sequential build.
+	 */
+	template <
+	    class ExecutionPolicy, class RandomIt,
+	    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+	KDTree(ExecutionPolicy&& policy, RandomIt first, RandomIt last) : points_(first, last)
+	{
+		build(detail::PolicyForEach<ExecutionPolicy>{policy});
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Accessors                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	/*!
+	 * @brief The points in tree order.
+	 */
+	[[nodiscard]] std::vector<point_type> const& points() const noexcept { return points_; }
+
+	/*!
+	 * @brief For each point in tree order, its index in the input.
+	 */
+	[[nodiscard]] std::vector<std::uint32_t> const& indices() const noexcept
+	{
+		return indices_;
+	}
+
+	/*!
+	 * @brief The point with input index `index`.
+	 */
+	[[nodiscard]] point_type const& point(size_type index) const
+	{
+		assert(size() > index);
+		return points_[positions_[index]];
+	}
+
+	[[nodiscard]] size_type size() const noexcept { return points_.size(); }
+
+	[[nodiscard]] bool empty() const noexcept { return points_.empty(); }
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                       Queries                                       |
+	|                                                                                     |
+	**************************************************************************************/
+
+	/*!
+	 * @brief Finds the closest point to `query` within `max_distance`.
+	 *
+	 * @return The index of the point and its squared distance, or
+	 * `std::numeric_limits<size_type>::max()` and infinity if there is none.
+	 */
+	[[nodiscard]] std::pair<size_type, T> nearest(
+	    point_type const& query, T max_distance = std::numeric_limits<T>::infinity()) const
+	{
+		size_type index;
+		T         distance_sq;
+		if (0 == knn(query, 1, &index, &distance_sq, max_distance)) {
+			return {std::numeric_limits<size_type>::max(), std::numeric_limits<T>::infinity()};
+		}
+		return {index, distance_sq};
+	}
+
+	/*!
+	 * @brief Finds the `k` closest points to `query` within `max_distance` (inclusive).
+	 *
+	 * The first `k` elements of `indices` and `distances_sq` are used as scratch space, on
+	 * return the first `n` of them hold the neighbours sorted by increasing distance.
+	 *
+	 * @return The number of neighbours found, `n`.
+	 */
+	template <class IndexIt, class DistanceIt>
+	size_type knn(point_type const& query, size_type k, IndexIt indices,
+	              DistanceIt distances_sq,
+	              T max_distance = std::numeric_limits<T>::infinity()) const
+	{
+		using index_type = typename std::iterator_traits<IndexIt>::value_type;
+
+		if (0 == k || empty()) {
+			return 0;
+		}
+
+		Heap<IndexIt, DistanceIt> heap{indices, distances_sq, k, 0, max_distance * max_distance};
+		point_type offsets(T(0));
+		knn(0, size(), query, heap, T(0), offsets);
+
+		// Heap sort, largest distance last
+		for (size_type i = heap.size; 1 < i; --i) {
+			index_type const j = indices[i - 1];
+			T const          d = distances_sq[i - 1];
+			indices[i - 1]      = indices[0];
+			distances_sq[i - 1] = distances_sq[0];
+			heap.siftDown(0, i - 1, j, d);
+		}
+
+		for (size_type i{}; heap.size > i; ++i) {
+			indices[i] = static_cast<index_type>(indices_[static_cast<size_type>(indices[i])]);
+		}
+
+		return heap.size;
+	}
+
+	/*!
+	 * @brief Finds all points within `radius` (inclusive) of `query`.
+	 *
+	 * At most `capacity` of them are written, in no particular order, to `indices` and
+	 * `distances_sq`.
+	 *
+	 * @return The number of points within `radius`, which is larger than `capacity` if
+	 * the buffers were too small.
+	 */
+	template <class IndexIt, class DistanceIt>
+	size_type radius(point_type const& query, T radius, size_type capacity, IndexIt indices,
+	                 DistanceIt distances_sq) const
+	{
+		using index_type = typename std::iterator_traits<IndexIt>::value_type;
+
+		size_type count{};
+		if (!empty()) {
+			this->radius(0, size(), query, radius * radius, [&](size_type i, T d) {
+				if (capacity > count) {
+					indices[count]      = static_cast<index_type>(indices_[i]);
+					distances_sq[count] = d;
+				}
+				++count;
+			});
+		}
+		return count;
+	}
+
+ private:
+	/**************************************************************************************
+	|                                                                                     |
+	|                                       Search                                        |
+	|                                                                                     |
+	**************************************************************************************/
+
+	/*!
+	 * @brief Max-heap on the squared distance, kept directly in the caller's buffers.
+	 */
+	template <class IndexIt, class DistanceIt>
+	struct Heap {
+		using index_type = typename std::iterator_traits<IndexIt>::value_type;
+
+		IndexIt    indices;
+		DistanceIt distances_sq;
+		size_type  k;
+		size_type  size;
+		T          bound_sq;
+
+		[[nodiscard]] T worst() const { return k == size ? distances_sq[0] : bound_sq; }
+
+		void push(size_type index, T d)
+		{
+			if (k > size) {
+				if (bound_sq < d) {
+					return;
+				}
+				// Sift up
+				size_type i = size++;
+				while (0 < i) {
+					size_type const parent = (i - 1) / 2;
+					if (distances_sq[parent] >= d) {
+						break;
+					}
+					indices[i]      = indices[parent];
+					distances_sq[i] = distances_sq[parent];
+					i               = parent;
+				}
+				indices[i]      = static_cast<index_type>(index);
+				distances_sq[i] = d;
+			} else if (distances_sq[0] > d) {
+				siftDown(0, size, static_cast<index_type>(index), d);
+			}
+		}
+
+		void siftDown(size_type i, size_type n, index_type index, T d)
+		{
+			for (size_type child = 2 * i + 1; n > child; child = 2 * i + 1) {
+				if (n > child + 1 && distances_sq[child] < distances_sq[child + 1]) {
+					++child;
+				}
+				if (distances_sq[child] <= d) {
+					break;
+				}
+				indices[i]      = indices[child];
+				distances_sq[i] = distances_sq[child];
+				i               = child;
+			}
+			indices[i]      = index;
+			distances_sq[i] = d;
+		}
+	};
+
+	/*!
+	 * @brief `distance_sq` is the squared distance from `query` to the cell of the range,
+	 * built up from the per dimension `offsets` to the splitting planes crossed on the way
+	 * down, which prunes far more than the distance to the last plane alone.
+	 */
+	template <class H>
+	void knn(size_type first, size_type last, point_type const& query, H& heap,
+	         T distance_sq, point_type& offsets) const
+	{
+		if (leaf_size >= last - first) {
+			for (; last != first; ++first) {
+				heap.push(first, distanceSquared(points_[first], query));
+			}
+			return;
+		}
+
+		size_type const   mid  = first + (last - first) / 2;
+		std::size_t const dim  = dims_[mid];
+		T const           diff = query[dim] - points_[mid][dim];
+
+		heap.push(mid, distanceSquared(points_[mid], query));
+
+		T const old = offsets[dim];
+		T const far = distance_sq - old * old + diff * diff;
+		if (T(0) > diff) {
+			knn(first, mid, query, heap, distance_sq, offsets);
+			if (far <= heap.worst()) {
+				offsets[dim] = diff;
+				knn(mid + 1, last, query, heap, far, offsets);
+				offsets[dim] = old;
+			}
+		} else {
+			knn(mid + 1, last, query, heap, distance_sq, offsets);
+			if (far <= heap.worst()) {
+				offsets[dim] = diff;
+				knn(first, mid, query, heap, far, offsets);
+				offsets[dim] = old;
+			}
+		}
+	}
+
+	template <class F>
+	void radius(size_type first, size_type last, point_type const& query, T radius_sq,
+	            F f) const
+	{
+		if (leaf_size >= last - first) {
+			for (; last != first; ++first) {
+				if (T d = distanceSquared(points_[first], query); radius_sq >= d) {
+					f(first, d);
+				}
+			}
+			return;
+		}
+
+		size_type const mid  = first + (last - first) / 2;
+		T const         diff = query[dims_[mid]] - points_[mid][dims_[mid]];
+
+		if (T d = distanceSquared(points_[mid], query); radius_sq >= d) {
+			f(mid, d);
+		}
+
+		if (T(0) > diff) {
+			radius(first, mid, query, radius_sq, f);
+			if (diff * diff <= radius_sq) {
+				radius(mid + 1, last, query, radius_sq, f);
+			}
+		} else {
+			radius(mid + 1, last, query, radius_sq, f);
+			if (diff * diff <= radius_sq) {
+				radius(first, mid, query, radius_sq, f);
+			}
+		}
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                        Build                                        |
+	|                                                                                     |
+	**************************************************************************************/
+
+	struct Range {
+		AABB<Dim, T> bounds;
+		size_type    first;
+		size_type    last;
+	};
+
+	template <class ForEach>
+	void build(ForEach for_each)
+	{
+		std::size_t const n = points_.size();
+		assert(std::numeric_limits<std::uint32_t>::max() > n);
+		if (0 == n) {
+			return;
+		}
+
+		indices_.resize(n);
+		dims_.assign(n, 0);
+		for (size_type i{}; n > i; ++i) {
+			indices_[i] = static_cast<std::uint32_t>(i);
+		}
+
+		AABB<Dim, T> bounds;
+		for (auto const& p : points_) {
+			bounds.expand(p);
+		}
+
+		// Breadth first, one level at a time with one range per task. The ranges of a level
+		// are disjoint so they can be partitioned concurrently.
+		std::vector<Range> level{{bounds, 0, n}};
+		while (!level.empty()) {
+			for_each(0, level.size(), [&](std::size_t i) {
+				Range const& r = level[i];
+				if (leaf_size >= r.last - r.first) {
+					return;
+				}
+
+				std::size_t const dim = largestExtent(r.bounds);
+				size_type const   mid = r.first + (r.last - r.first) / 2;
+				std::nth_element(indices_.begin() + r.first, indices_.begin() + mid,
+				                 indices_.begin() + r.last,
+				                 [this, dim](std::uint32_t a, std::uint32_t b) {
+					                 T const va = points_[a][dim];
+					                 T const vb = points_[b][dim];
+					                 return va < vb || (va == vb && a < b);
+				                 });
+				dims_[mid] = static_cast<std::uint8_t>(dim);
+			});
+
+			std::vector<Range> next;
+			for (Range const& r : level) {
+				if (leaf_size >= r.last - r.first) {
+					continue;
+				}
+				size_type const   mid   = r.first + (r.last - r.first) / 2;
+				std::size_t const dim   = dims_[mid];
+				T const           split = points_[indices_[mid]][dim];
+
+				Range left{r.bounds, r.first, mid};
+				Range right{r.bounds, mid + 1, r.last};
+				left.bounds.max[dim]  = split;
+				right.bounds.min[dim] = split;
+				next.push_back(left);
+				next.push_back(right);
+			}
+			level = std::move(next);
+		}
+
+		std::vector<point_type> ordered(n);
+		positions_.resize(n);
+		for (size_type i{}; n > i; ++i) {
+			ordered[i]              = points_[indices_[i]];
+			positions_[indices_[i]] = static_cast<std::uint32_t>(i);
+		}
+		points_ = std::move(ordered);
+	}
+
+	[[nodiscard]] static std::size_t largestExtent(AABB<Dim, T> const& bounds) noexcept
+	{
+		std::size_t dim{};
+		T           extent = bounds.max[0] - bounds.min[0];
+		for (std::size_t i = 1; Dim > i; ++i) {
+			if (T e = bounds.max[i] - bounds.min[i]; extent < e) {
+				extent = e;
+				dim    = i;
+			}
+		}
+		return dim;
+	}
+
+ private:
+	std::vector<point_type>    points_;
+	std::vector<std::uint32_t> indices_;
+	std::vector<std::uint32_t> positions_;
+	std::vector<std::uint8_t>  dims_;
+};
+
+namespace detail
+{
+/*!
+ * @brief Order of the points `[first, last)` along a Morton curve over their bounds.
+ */
+template <class RandomIt>
+[[nodiscard]] std::vector<std::size_t> spatialOrder(RandomIt first, RandomIt last)
+{
+	using Point = typename std::iterator_traits<RandomIt>::value_type;
+	using T     = typename Point::value_type;
+
+	constexpr std::size_t dim  = Point::size();
+	constexpr std::size_t bits = std::min(std::size_t(21), 64 / dim);
+
+	std::size_t const size = std::distance(first, last);
+
+	AABB<dim, T> bounds;
+	for (auto it = first; last != it; ++it) {
+		bounds.expand(*it);
+	}
+
+	std::vector<std::uint64_t> codes(size);
+	for (std::size_t i{}; size > i; ++i) {
+		Point const&  p = first[i];
+		std::uint64_t code{};
+		for (std::size_t d{}; dim > d; ++d) {
+			T const extent = bounds.max[d] - bounds.min[d];
+			T const scale  = T(0) < extent ? T((std::uint64_t(1) << bits) - 1) / extent : T(0);
+			auto const c   = static_cast<std::uint64_t>((p[d] - bounds.min[d]) * scale);
+			for (std::size_t b{}; bits > b; ++b) {
+				code |= ((c >> b) & 1) << (b * dim + d);
+			}
+		}
+		codes[i] = code;
+	}
+
+	std::vector<std::size_t> order(size);
+	for (std::size_t i{}; size > i; ++i) {
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [&codes](std::size_t a, std::size_t b) {
+		return codes[a] < codes[b] || (codes[a] == codes[b] && a < b);
+	});
+	return order;
+}
+
+/*!
+ * @brief k-nearest neighbours of the queries `order[first, last)`, in that order.
+ *
+ * Consecutive queries are close to each other, so the `k`:th distance of the previous
+ * query plus the distance between the two queries bounds the search of the next one.
+ */
+template <std::size_t Dim, class T, class RandomIt, class IndexIt, class DistanceIt>
+void knnBlock(KDTree<Dim, T> const& tree, RandomIt queries,
+              std::vector<std::size_t> const& order, std::size_t first, std::size_t last,
+              std::size_t k, IndexIt indices, DistanceIt distances_sq)
+{
+	using index_type = typename std::iterator_traits<IndexIt>::value_type;
+
+	Vec<Dim, T> previous;
+	T           previous_distance = std::numeric_limits<T>::infinity();
+	for (; last != first; ++first) {
+		std::size_t const  q     = order[first];
+		Vec<Dim, T> const& query = queries[q];
+		auto               idx   = indices + q * k;
+		auto               dist  = distances_sq + q * k;
+
+		std::size_t n{};
+		if (std::numeric_limits<T>::infinity() != previous_distance) {
+			T const bound = previous_distance + distance(previous, query);
+			n             = tree.knn(query, k, idx, dist, bound);
+		}
+		if (k > n) {
+			n = tree.knn(query, k, idx, dist);
+		}
+
+		for (std::size_t i = n; k > i; ++i) {
+			idx[i]  = std::numeric_limits<index_type>::max();
+			dist[i] = std::numeric_limits<T>::infinity();
+		}
+
+		previous          = query;
+		previous_distance = k == n ? std::sqrt(dist[k - 1]) : std::numeric_limits<T>::infinity();
+	}
+}
+
+template <std::size_t Dim, class T, class RandomIt, class IndexIt, class DistanceIt,
+          class CountIt>
+void radiusBlock(KDTree<Dim, T> const& tree, RandomIt queries,
+                 std::vector<std::size_t> const& order, std::size_t first, std::size_t last,
+                 T radius, std::size_t capacity, IndexIt indices, DistanceIt distances_sq,
+                 CountIt counts)
+{
+	for (; last != first; ++first) {
+		std::size_t const q = order[first];
+		counts[q] = tree.radius(queries[q], radius, capacity, indices + q * capacity,
+		                        distances_sq + q * capacity);
+	}
+}
+
+inline constexpr std::size_t kdtree_query_block = 256;
+}  // namespace detail
+
+/*!
+ * @brief k-nearest neighbours of each query in `[first, last)`.
+ *
+ * The neighbours of the i:th query are written to `indices[i * k, (i + 1) * k)` and
+ * `distances_sq[i * k, (i + 1) * k)`, sorted by increasing distance. If the tree holds
+ * fewer than `k` points the remaining slots get the maximum index and infinite distance.
+ *
+ * The queries are visited along a Morton curve so that consecutive searches touch the same
+ * part of the tree and can bound each other.
+ */
+template <std::size_t Dim, class T, class RandomIt, class IndexIt, class DistanceIt>
+void knn(KDTree<Dim, T> const& tree, RandomIt first, RandomIt last, std::size_t k,
+         IndexIt indices, DistanceIt distances_sq)
+{
+	if (0 == k) {
+		return;
+	}
+	auto const order = detail::spatialOrder(first, last);
+	detail::knnBlock(tree, first, order, 0, order.size(), k, indices, distances_sq);
+}
+
+template <
+    class ExecutionPolicy, std::size_t Dim, class T, class RandomIt, class IndexIt,
+    class DistanceIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+void knn(ExecutionPolicy&& policy, KDTree<Dim, T> const& tree, RandomIt first,
+         RandomIt last, std::size_t k, IndexIt indices, DistanceIt distances_sq)
+{
+	constexpr std::size_t B = detail::kdtree_query_block;
+
+	if (0 == k) {
+		return;
+	}
+	auto const        order  = detail::spatialOrder(first, last);
+	std::size_t const size   = order.size();
+	std::size_t const blocks = (size + B - 1) / B;
+	detail::forEach(std::forward<ExecutionPolicy>(policy), 0, blocks, [&](std::size_t b) {
+		detail::knnBlock(tree, first, order, b * B, std::min(size, (b + 1) * B), k, indices,
+		                 distances_sq);
+	});
+}
+
+/*!
+ * @brief All points within `radius` of each query in `[first, last)`.
+ *
+ * Each query gets `capacity` slots in `indices` and `distances_sq`, the i:th starting at
+ * `i * capacity`, and `counts[i]` is set to the number of points within `radius` of it,
+ * see `KDTree::radius`.
+ */
+template <std::size_t Dim, class T, class RandomIt, class IndexIt, class DistanceIt,
+          class CountIt>
+void radius(KDTree<Dim, T> const& tree, RandomIt first, RandomIt last, T radius,
+            std::size_t capacity, IndexIt indices, DistanceIt distances_sq, CountIt counts)
+{
+	auto const order = detail::spatialOrder(first, last);
+	detail::radiusBlock(tree, first, order, 0, order.size(), radius, capacity, indices,
+	                    distances_sq, counts);
+}
+
+template <
+    class ExecutionPolicy, std::size_t Dim, class T, class RandomIt, class IndexIt,
+    class DistanceIt, class CountIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+void radius(ExecutionPolicy&& policy, KDTree<Dim, T> const& tree, RandomIt first,
+            RandomIt last, T radius, std::size_t capacity, IndexIt indices,
+            DistanceIt distances_sq, CountIt counts)
+{
+	constexpr std::size_t B = detail::kdtree_query_block;
+
+	auto const        order  = detail::spatialOrder(first, last);
+	std::size_t const size   = order.size();
+	std::size_t const blocks = (size + B - 1) / B;
+	detail::forEach(std::forward<ExecutionPolicy>(policy), 0, blocks, [&](std::size_t b) {
+		detail::radiusBlock(tree, first, order, b * B, std::min(size, (b + 1) * B), radius,
+		                    capacity, indices, distances_sq, counts);
+	});
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_KDTREE_HPP
@@ -0,0 +1,221 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_LINE_HPP
+#define UFO_MATH_LINE_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/mat3x3.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief Infinite line through `origin` with unit direction `direction`.
+ */
+template <class T = float>
+struct Line {
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	Vec3<T> origin{};
+	Vec3<T> direction = Vec3<T>(T(1), T(0), T(0));
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Line() noexcept            = default;
+	constexpr Line(Line const&) noexcept = default;
+
+	constexpr Line(Vec3<T> const& origin, Vec3<T> const& direction) noexcept
+	    : origin(origin), direction(direction)
+	{
+	}
+
+	constexpr Line& operator=(Line const&) noexcept = default;
+};
+
+using Linef = Line<float>;
+using Lined = Line<double>;
+
+/*!
+ * @brief Line through the two points `p0` and `p1`.
+ */
+template <class T>
+[[nodiscard]] Line<T> lineThrough(Vec3<T> const& p0, Vec3<T> const& p1)
+{
+	return Line<T>(p0, normalize(p1 - p0));
+}
+
+template <class T>
+[[nodiscard]] constexpr bool operator==(Line<T> const& lhs, Line<T> const& rhs) noexcept
+{
+	return lhs.origin == rhs.origin && lhs.direction == rhs.direction;
+}
+
+template <class T>
+[[nodiscard]] constexpr bool operator!=(Line<T> const& lhs, Line<T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, Line<T> const& line)
+{
+	return out << "Origin: " << line.origin << ", Direction: " << line.direction;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Functions                                      |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+[[nodiscard]] constexpr Vec3<T> project(Line<T> const& line, Vec3<T> const& point) noexcept
+{
+	return line.origin + line.direction * dot(point - line.origin, line.direction);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distanceSquared(Line<T> const& line,
+                                          Vec3<T> const& point) noexcept
+{
+	Vec3<T> d = point - line.origin;
+	T       t = dot(d, line.direction);
+	return dot(d, d) - t * t;
+}
+
+template <class T>
+[[nodiscard]] T distance(Line<T> const& line, Vec3<T> const& point)
+{
+	return std::sqrt(std::max(T(0), distanceSquared(line, point)));
+}
+
+template <class T>
+[[nodiscard]] Line<T> transform(Transform<3, T> const& t, Line<T> const& line)
+{
+	return Line<T>(t * line.origin, t.rotation * line.direction);
+}
+
+/*!
+ * @brief Least squares line through the points in [`first`, `last`).
+ *
+ * The direction is the eigenvector belonging to the largest eigenvalue of the covariance
+ * of the points and the origin is their centroid.
+ */
+template <class ForwardIt>
+[[nodiscard]] auto fitLine(ForwardIt first, ForwardIt last)
+{
+	using T = typename std::iterator_traits<ForwardIt>::value_type::value_type;
+
+	auto const [centroid, cov] = detail::centroidCovariance(first, last);
+	return Line<T>(centroid, eigenSymmetric(cov).second[2]);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Batch                                        |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T, class InputIt, class OutputIt>
+OutputIt distance(Line<T> const& line, InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [line](auto const& p) { return distance(line, p); });
+}
+
+template <
+    class T, class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 distance(ExecutionPolicy&& policy, Line<T> const& line, RandomIt1 first,
+                   RandomIt1 last, RandomIt2 d_first)
+{
+	return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                         [line](auto const& p) { return distance(line, p); });
+}
+
+/*!
+ * @brief Number of points in [`first`, `last`) within `threshold` of `line`.
+ */
+template <class T, class InputIt>
+[[nodiscard]] std::size_t countInliers(Line<T> const& line, InputIt first, InputIt last,
+                                       T threshold)
+{
+	T const t2 = threshold * threshold;
+
+	std::size_t count{};
+	for (; last != first; ++first) {
+		count += distanceSquared(line, *first) <= t2;
+	}
+	return count;
+}
+
+template <
+    class T, class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] std::size_t countInliers(ExecutionPolicy&& policy, Line<T> const& line,
+                                       RandomIt first, RandomIt last, T threshold)
+{
+	return detail::countInliers(std::forward<ExecutionPolicy>(policy), first, last,
+	                            [&](RandomIt f, RandomIt l) {
+		                            return countInliers(line, f, l, threshold);
+	                            });
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_LINE_HPP
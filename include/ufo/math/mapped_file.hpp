@@ -0,0 +1,173 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_MAPPED_FILE_HPP
+#define UFO_MATH_MAPPED_FILE_HPP
+
+// STL
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UFO_MATH_MAPPED_FILE_MMAP
+#endif
+
+namespace ufo
+{
+/*!
+ * @brief A whole file mapped read-only into memory.
+ *
+ * The OS reads pages from disk when they are first touched, so opening even a very large
+ * file is immediate. On platforms without `mmap` the file is read into memory instead.
+ * Either way the data starts at an address aligned to `ALIGNMENT`.
+ */
+class MappedFile
+{
+ public:
+	static constexpr std::size_t ALIGNMENT = 64;
+
+	MappedFile() = default;
+
+	/*!
+	 * @throws std::runtime_error If the file cannot be opened or mapped.
+	 */
+	explicit MappedFile(std::filesystem::path const& path)
+	{
+#if defined(UFO_MATH_MAPPED_FILE_MMAP)
+		int const fd = ::open(path.c_str(), O_RDONLY);
+		if (-1 == fd) {
+			throw std::runtime_error("Cannot open '" + path.string() + "'");
+		}
+		struct stat info;
+		if (-1 == ::fstat(fd, &info)) {
+			::close(fd);
+			throw std::runtime_error("Cannot stat '" + path.string() + "'");
+		}
+		size_ = static_cast<std::size_t>(info.st_size);
+		if (0 < size_) {
+			void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (MAP_FAILED == p) {
+				::close(fd);
+				throw std::runtime_error("Cannot map '" + path.string() + "'");
+			}
+			data_ = static_cast<std::byte const*>(p);
+		}
+		::close(fd);
+#else
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file) {
+			throw std::runtime_error("Cannot open '" + path.string() + "'");
+		}
+		size_ = static_cast<std::size_t>(file.tellg());
+		file.seekg(0);
+		auto* p = static_cast<std::byte*>(::operator new(size_, std::align_val_t(ALIGNMENT)));
+		data_   = p;
+		if (!file.read(reinterpret_cast<char*>(p), static_cast<std::streamsize>(size_))) {
+			release();
+			throw std::runtime_error("Cannot read '" + path.string() + "'");
+		}
+#endif
+	}
+
+	MappedFile(MappedFile const&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept
+	    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+	{
+	}
+
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	MappedFile& operator=(MappedFile&& rhs) noexcept
+	{
+		if (this != &rhs) {
+			release();
+			data_ = std::exchange(rhs.data_, nullptr);
+			size_ = std::exchange(rhs.size_, 0);
+		}
+		return *this;
+	}
+
+	~MappedFile() { release(); }
+
+	[[nodiscard]] std::byte const* data() const noexcept { return data_; }
+
+	[[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+	/*!
+	 * @brief The contents as characters, for parsing text formats in place.
+	 */
+	[[nodiscard]] std::string_view view() const noexcept
+	{
+		return {static_cast<char const*>(static_cast<void const*>(data_)), size_};
+	}
+
+ private:
+	void release() noexcept
+	{
+		if (nullptr == data_) {
+			return;
+		}
+#if defined(UFO_MATH_MAPPED_FILE_MMAP)
+		::munmap(const_cast<std::byte*>(data_), size_);
+#else
+		::operator delete(const_cast<std::byte*>(data_), std::align_val_t(ALIGNMENT));
+#endif
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+ private:
+	std::byte const* data_{};
+	std::size_t      size_{};
+};
+}  // namespace ufo
+
+#endif  // UFO_MATH_MAPPED_FILE_HPP
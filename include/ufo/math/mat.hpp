@@ -46,5 +46,6 @@
 #include <ufo/math/mat2x2.hpp>
 #include <ufo/math/mat3x3.hpp>
 #include <ufo/math/mat4x4.hpp>
+#include <ufo/math/matn.hpp>
 
 #endif  // UFO_MATH_MAT_HPP
\ No newline at end of file
@@ -0,0 +1,404 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_MATN_HPP
+#define UFO_MATH_MATN_HPP
+
+// UFO
+#include <ufo/math/detail/mat.hpp>
+#include <ufo/math/detail/mat_fun.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace ufo
+{
+namespace detail
+{
+// The square sizes 2 to 4 are specialized, everything else uses the primary template
+template <std::size_t Cols, std::size_t Rows>
+inline constexpr bool is_generic_mat_v = !(Cols == Rows && 2 <= Cols && 4 >= Cols);
+}  // namespace detail
+
+/*!
+ * @brief Column-major matrix of any compile-time size, the square sizes 2 to 4 are
+ * specialized.
+ *
+ * The columns live in a `std::array` on the stack and every loop runs over a
+ * compile-time bound, so the compiler can unroll them.
+ */
+template <std::size_t Cols, std::size_t Rows, class T>
+struct Mat {
+	static_assert(detail::is_generic_mat_v<Cols, Rows>,
+	              "Mat is specialized for the sizes 2x2, 3x3, and 4x4");
+
+ public:
+	using value_type  = T;
+	using size_type   = std::size_t;
+	using column_type = Vec<Rows, T>;
+	using row_type    = Vec<Cols, T>;
+
+ private:
+	std::array<column_type, Cols> value_{};
+
+ public:
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Mat() noexcept
+	{
+		for (size_type i{}; Cols > i && Rows > i; ++i) {
+			value_[i][i] = T(1);
+		}
+	}
+
+	constexpr Mat(Mat const&) noexcept = default;
+
+	constexpr explicit Mat(T value) noexcept
+	{
+		for (size_type i{}; Cols > i; ++i) {
+			value_[i] = column_type(value);
+		}
+	}
+
+	template <class... Args,
+	          std::enable_if_t<Cols == sizeof...(Args) &&
+	                               (std::is_convertible_v<Args, column_type> && ...),
+	                           bool> = true>
+	constexpr Mat(Args const&... columns) noexcept
+	    : value_{static_cast<column_type>(columns)...}
+	{
+	}
+
+	template <class U>
+	constexpr explicit Mat(Mat<Cols, Rows, U> const& m) noexcept
+	{
+		for (size_type i{}; Cols > i; ++i) {
+			value_[i] = static_cast<column_type>(m[i]);
+		}
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                 Assignment operator                                 |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Mat& operator=(Mat const&) noexcept = default;
+
+	template <class U>
+	constexpr Mat& operator=(Mat<Cols, Rows, U> const& m) noexcept
+	{
+		for (size_type i{}; Cols > i; ++i) {
+			value_[i] = m[i];
+		}
+		return *this;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                   Element access                                    |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] constexpr column_type& operator[](size_type pos) noexcept
+	{
+		assert(cols() > pos);
+		return value_[pos];
+	}
+
+	[[nodiscard]] constexpr column_type const& operator[](size_type pos) const noexcept
+	{
+		assert(cols() > pos);
+		return value_[pos];
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                              Unary arithmetic operator                              |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Mat operator+() const noexcept { return *this; }
+
+	constexpr Mat operator-() const noexcept
+	{
+		Mat res;
+		for (size_type i{}; Cols > i; ++i) {
+			res[i] = -value_[i];
+		}
+		return res;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                            Compound assignment operator                             |
+	|                                                                                     |
+	**************************************************************************************/
+
+	template <class U>
+	constexpr Mat& operator+=(U value)
+	{
+		for (size_type i{}; Cols > i; ++i) {
+			value_[i] += value;
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Mat& operator+=(Mat<Cols, Rows, U> const& m)
+	{
+		for (size_type i{}; Cols > i; ++i) {
+			value_[i] += m[i];
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Mat& operator-=(U value)
+	{
+		for (size_type i{}; Cols > i; ++i) {
+			value_[i] -= value;
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Mat& operator-=(Mat<Cols, Rows, U> const& m)
+	{
+		for (size_type i{}; Cols > i; ++i) {
+			value_[i] -= m[i];
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Mat& operator*=(U value)
+	{
+		for (size_type i{}; Cols > i; ++i) {
+			value_[i] *= value;
+		}
+		return *this;
+	}
+
+	template <class U, std::size_t C = Cols, std::enable_if_t<C == Rows, bool> = true>
+	constexpr Mat& operator*=(Mat<Cols, Rows, U> const& m)
+	{
+		return *this = *this * m;
+	}
+
+	template <class U>
+	constexpr Mat& operator/=(U value)
+	{
+		for (size_type i{}; Cols > i; ++i) {
+			value_[i] /= value;
+		}
+		return *this;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Capacity                                       |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] static constexpr size_type cols() noexcept { return Cols; }
+
+	[[nodiscard]] static constexpr size_type rows() noexcept { return Rows; }
+
+	[[nodiscard]] static constexpr size_type size() noexcept { return cols() * rows(); }
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                     Operations                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	void swap(Mat& other) noexcept { value_.swap(other.value_); }
+};
+
+/**************************************************************************************
+|                                                                                     |
+|                                  Binary operators                                   |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Mat<Cols, Rows, T> operator+(Mat<Cols, Rows, T> m, T value)
+{
+	return m += value;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Mat<Cols, Rows, T> operator+(T value, Mat<Cols, Rows, T> m)
+{
+	return m += value;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Mat<Cols, Rows, T> operator+(Mat<Cols, Rows, T> m1,
+                                       Mat<Cols, Rows, T> const& m2)
+{
+	return m1 += m2;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Mat<Cols, Rows, T> operator-(Mat<Cols, Rows, T> m, T value)
+{
+	return m -= value;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Mat<Cols, Rows, T> operator-(T value, Mat<Cols, Rows, T> const& m)
+{
+	return Mat<Cols, Rows, T>(value) -= m;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Mat<Cols, Rows, T> operator-(Mat<Cols, Rows, T> m1,
+                                       Mat<Cols, Rows, T> const& m2)
+{
+	return m1 -= m2;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Mat<Cols, Rows, T> operator*(Mat<Cols, Rows, T> m, T value)
+{
+	return m *= value;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Mat<Cols, Rows, T> operator*(T value, Mat<Cols, Rows, T> m)
+{
+	return m *= value;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Vec<Rows, T> operator*(Mat<Cols, Rows, T> const& m, Vec<Cols, T> const& v)
+{
+	Vec<Rows, T> res = m[0] * v[0];
+	for (std::size_t col{1}; Cols > col; ++col) {
+		res += m[col] * v[col];
+	}
+	return res;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Vec<Cols, T> operator*(Vec<Rows, T> const& v, Mat<Cols, Rows, T> const& m)
+{
+	Vec<Cols, T> res;
+	for (std::size_t col{}; Cols > col; ++col) {
+		res[col] = dot(v, m[col]);
+	}
+	return res;
+}
+
+template <std::size_t Cols, std::size_t Rows, std::size_t K, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows> ||
+                               detail::is_generic_mat_v<K, Cols>,
+                           bool> = true>
+constexpr Mat<K, Rows, T> operator*(Mat<Cols, Rows, T> const& m1,
+                                    Mat<K, Cols, T> const& m2)
+{
+	Mat<K, Rows, T> res;
+	for (std::size_t k{}; K > k; ++k) {
+		Vec<Rows, T> c = m1[0] * m2[k][0];
+		for (std::size_t col{1}; Cols > col; ++col) {
+			c += m1[col] * m2[k][col];
+		}
+		res[k] = c;
+	}
+	return res;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+constexpr Mat<Cols, Rows, T> operator/(Mat<Cols, Rows, T> m, T value)
+{
+	return m /= value;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Compare                                       |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+[[nodiscard]] constexpr bool operator==(Mat<Cols, Rows, T> const& lhs,
+                                        Mat<Cols, Rows, T> const& rhs) noexcept
+{
+	for (std::size_t i{}; Cols > i; ++i) {
+		if (lhs[i] != rhs[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Cols, std::size_t Rows, class T,
+          std::enable_if_t<detail::is_generic_mat_v<Cols, Rows>, bool> = true>
+[[nodiscard]] constexpr bool operator!=(Mat<Cols, Rows, T> const& lhs,
+                                        Mat<Cols, Rows, T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_MATN_HPP
@@ -0,0 +1,168 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_NUMA_HPP
+#define UFO_MATH_NUMA_HPP
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(UFO_MATH_NUMA)
+#include <numa.h>
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ufo
+{
+/*!
+ * @brief The NUMA nodes of the machine and the CPUs of each.
+ *
+ * With `UFO_MATH_NUMA` defined (and libnuma linked) `detect` reads the topology with
+ * libnuma, otherwise, or if libnuma reports that NUMA is not available, the machine is a
+ * single node with every hardware thread. `fake` builds a topology without CPUs for
+ * testing the NUMA code paths on any machine, threads are then not pinned.
+ */
+class NumaTopology
+{
+ public:
+	NumaTopology() : NumaTopology(detect()) {}
+
+	[[nodiscard]] static NumaTopology detect()
+	{
+#if defined(UFO_MATH_NUMA)
+		if (-1 != numa_available()) {
+			NumaTopology topology(std::vector<std::vector<int>>{});
+			struct bitmask* mask = numa_allocate_cpumask();
+			for (int node{}; numa_max_node() >= node; ++node) {
+				if (0 != numa_node_to_cpus(node, mask)) {
+					continue;
+				}
+				std::vector<int> cpus;
+				for (unsigned cpu{}; mask->size > cpu; ++cpu) {
+					if (numa_bitmask_isbitset(mask, cpu)) {
+						cpus.push_back(static_cast<int>(cpu));
+					}
+				}
+				if (!cpus.empty()) {
+					topology.cpus_.push_back(std::move(cpus));
+				}
+			}
+			numa_free_cpumask(mask);
+			if (!topology.cpus_.empty()) {
+				topology.threads_.reserve(topology.cpus_.size());
+				for (auto const& c : topology.cpus_) {
+					topology.threads_.push_back(c.size());
+				}
+				return topology;
+			}
+		}
+#endif
+		return fake(1, std::max(1u, std::thread::hardware_concurrency()));
+	}
+
+	/*!
+	 * @brief Topology of `nodes` nodes with `threads_per_node` threads each and no CPUs.
+	 */
+	[[nodiscard]] static NumaTopology fake(std::size_t nodes, std::size_t threads_per_node)
+	{
+		NumaTopology topology(std::vector<std::vector<int>>(std::max(std::size_t(1), nodes)));
+		topology.threads_.assign(topology.cpus_.size(),
+		                         std::max(std::size_t(1), threads_per_node));
+		return topology;
+	}
+
+	[[nodiscard]] std::size_t nodes() const noexcept { return threads_.size(); }
+
+	/*!
+	 * @brief Number of threads to run on `node`, one per CPU for detected topologies.
+	 */
+	[[nodiscard]] std::size_t threads(std::size_t node) const { return threads_[node]; }
+
+	/*!
+	 * @brief The CPUs of `node`, empty for fake topologies.
+	 */
+	[[nodiscard]] std::vector<int> const& cpus(std::size_t node) const
+	{
+		return cpus_[node];
+	}
+
+	/*!
+	 * @brief Restricts the calling thread to the CPUs of `node`, does nothing if it has
+	 * none or the platform does not support it.
+	 *
+	 * @return Whether the thread was pinned.
+	 */
+	bool pin(std::size_t node) const
+	{
+#if defined(__linux__)
+		if (cpus_[node].empty()) {
+			return false;
+		}
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for (int cpu : cpus_[node]) {
+			CPU_SET(cpu, &set);
+		}
+		return 0 == pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+		(void)node;
+		return false;
+#endif
+	}
+
+ private:
+	explicit NumaTopology(std::vector<std::vector<int>> cpus) : cpus_(std::move(cpus)) {}
+
+ private:
+	std::vector<std::vector<int>> cpus_;
+	std::vector<std::size_t>      threads_;
+};
+}  // namespace ufo
+
+#endif  // UFO_MATH_NUMA_HPP
@@ -0,0 +1,276 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_OCTAHEDRAL_HPP
+#define UFO_MATH_OCTAHEDRAL_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/vec2.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief Unit vector stored with the octahedral encoding, using `Bits` bits for each of
+ * the two components.
+ *
+ * See "A Survey of Efficient Representations for Independent Unit Vectors" by Cigolle
+ * et al. Maximum angular error measured in double precision over 10^6 random
+ * directions (with `float` the error of `Oct32` is dominated by `float` itself):
+ *
+ * | Type    | Size    | `octEncode` | `octEncodePrecise` |
+ * | ------- | ------- | ----------- | ------------------ |
+ * | `Oct16` | 2 bytes | 0.95 deg    | 0.63 deg           |
+ * | `Oct24` | 3 bytes | 0.059 deg   | 0.040 deg          |
+ * | `Oct32` | 4 bytes | 0.0037 deg  | 0.0025 deg         |
+ *
+ * @tparam Bits Number of bits per component (1-16)
+ */
+template <std::size_t Bits>
+struct Oct {
+	static_assert(0 < Bits && 16 >= Bits, "Bits has to be in the range [1, 16]");
+
+	static constexpr std::uint32_t const max_level = (std::uint32_t(1) << Bits) - 1u;
+
+	std::array<std::uint8_t, (2 * Bits + 7) / 8> data{};
+
+	constexpr Oct() noexcept = default;
+
+	constexpr Oct(std::uint32_t x, std::uint32_t y) noexcept
+	{
+		std::uint32_t v = x | (y << Bits);
+		for (std::size_t i{}; data.size() > i; ++i) {
+			data[i] = static_cast<std::uint8_t>(v >> (8 * i));
+		}
+	}
+
+	[[nodiscard]] constexpr std::uint32_t value() const noexcept
+	{
+		std::uint32_t v{};
+		for (std::size_t i{}; data.size() > i; ++i) {
+			v |= static_cast<std::uint32_t>(data[i]) << (8 * i);
+		}
+		return v;
+	}
+
+	[[nodiscard]] constexpr std::uint32_t x() const noexcept { return value() & max_level; }
+
+	[[nodiscard]] constexpr std::uint32_t y() const noexcept
+	{
+		return (value() >> Bits) & max_level;
+	}
+};
+
+using Oct16 = Oct<8>;
+using Oct24 = Oct<12>;
+using Oct32 = Oct<16>;
+
+static_assert(2 == sizeof(Oct16));
+static_assert(3 == sizeof(Oct24));
+static_assert(4 == sizeof(Oct32));
+
+template <std::size_t Bits>
+[[nodiscard]] constexpr bool operator==(Oct<Bits> const& lhs, Oct<Bits> const& rhs) noexcept
+{
+	return lhs.data == rhs.data;
+}
+
+template <std::size_t Bits>
+[[nodiscard]] constexpr bool operator!=(Oct<Bits> const& lhs, Oct<Bits> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+namespace detail
+{
+template <class T>
+[[nodiscard]] constexpr T signNotZero(T v) noexcept
+{
+	return T(0) <= v ? T(1) : T(-1);
+}
+}  // namespace detail
+
+/*!
+ * @brief Projects a unit vector onto the octahedron and unfolds it to [-1, 1]^2.
+ */
+template <class T>
+[[nodiscard]] constexpr Vec2<T> octWrap(Vec3<T> const& v) noexcept
+{
+	T const inv_l1 = T(1) / (std::abs(v.x) + std::abs(v.y) + std::abs(v.z));
+	T const px     = v.x * inv_l1;
+	T const py     = v.y * inv_l1;
+	// Branchless fold of the lower hemisphere
+	T const fx = (T(1) - std::abs(py)) * detail::signNotZero(px);
+	T const fy = (T(1) - std::abs(px)) * detail::signNotZero(py);
+	bool const lower = T(0) > v.z;
+	return Vec2<T>(lower ? fx : px, lower ? fy : py);
+}
+
+/*!
+ * @brief Inverse of `octWrap`, the result is normalized.
+ */
+template <class T>
+[[nodiscard]] constexpr Vec3<T> octUnwrap(Vec2<T> const& p) noexcept
+{
+	Vec3<T> v(p.x, p.y, T(1) - std::abs(p.x) - std::abs(p.y));
+	T const t = std::max(-v.z, T(0));
+	v.x -= T(0) <= v.x ? t : -t;
+	v.y -= T(0) <= v.y ? t : -t;
+	return normalize(v);
+}
+
+template <std::size_t Bits, class T>
+[[nodiscard]] constexpr Oct<Bits> octEncode(Vec3<T> const& v) noexcept
+{
+	constexpr T const s = static_cast<T>(Oct<Bits>::max_level) * T(0.5);
+
+	Vec2<T> p = octWrap(v);
+	// Map [-1, 1] to [0, max_level] and round to nearest
+	return Oct<Bits>(static_cast<std::uint32_t>(std::clamp(p.x * s + s + T(0.5), T(0), s + s)),
+	                 static_cast<std::uint32_t>(std::clamp(p.y * s + s + T(0.5), T(0), s + s)));
+}
+
+template <class T, std::size_t Bits>
+[[nodiscard]] constexpr Vec3<T> octDecode(Oct<Bits> const& o) noexcept
+{
+	constexpr T const s = T(2) / static_cast<T>(Oct<Bits>::max_level);
+	return octUnwrap(
+	    Vec2<T>(static_cast<T>(o.x()) * s - T(1), static_cast<T>(o.y()) * s - T(1)));
+}
+
+/*!
+ * @brief Like `octEncode`, but picks the best of the four surrounding grid points by
+ * decoding each of them. Roughly 1/3 lower maximum error at about 4x the cost.
+ */
+template <std::size_t Bits, class T>
+[[nodiscard]] constexpr Oct<Bits> octEncodePrecise(Vec3<T> const& v) noexcept
+{
+	constexpr T const s = static_cast<T>(Oct<Bits>::max_level) * T(0.5);
+
+	Vec2<T> p = octWrap(v);
+	T const x = std::clamp(p.x * s + s, T(0), s + s);
+	T const y = std::clamp(p.y * s + s, T(0), s + s);
+
+	std::uint32_t const x0 = static_cast<std::uint32_t>(x);
+	std::uint32_t const y0 = static_cast<std::uint32_t>(y);
+	std::uint32_t const x1 = std::min(x0 + 1u, Oct<Bits>::max_level);
+	std::uint32_t const y1 = std::min(y0 + 1u, Oct<Bits>::max_level);
+
+	Oct<Bits> best(x0, y0);
+	T         best_dot = dot(v, octDecode<T>(best));
+	for (Oct<Bits> c : {Oct<Bits>(x1, y0), Oct<Bits>(x0, y1), Oct<Bits>(x1, y1)}) {
+		T const d = dot(v, octDecode<T>(c));
+		best      = d > best_dot ? c : best;
+		best_dot  = d > best_dot ? d : best_dot;
+	}
+	return best;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Batch                                        |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Bits, class InputIt, class OutputIt>
+OutputIt octEncode(InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [](auto const& v) { return octEncode<Bits>(v); });
+}
+
+template <
+    std::size_t Bits, class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 octEncode(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                    RandomIt2 d_first)
+{
+	return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                         [](auto const& v) { return octEncode<Bits>(v); });
+}
+
+template <std::size_t Bits, class InputIt, class OutputIt>
+OutputIt octEncodePrecise(InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [](auto const& v) { return octEncodePrecise<Bits>(v); });
+}
+
+template <
+    std::size_t Bits, class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 octEncodePrecise(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                           RandomIt2 d_first)
+{
+	return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                         [](auto const& v) { return octEncodePrecise<Bits>(v); });
+}
+
+template <class T, class InputIt, class OutputIt>
+OutputIt octDecode(InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [](auto const& o) { return octDecode<T>(o); });
+}
+
+template <
+    class T, class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 octDecode(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                    RandomIt2 d_first)
+{
+	return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                         [](auto const& o) { return octDecode<T>(o); });
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_OCTAHEDRAL_HPP
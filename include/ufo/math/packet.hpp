@@ -0,0 +1,73 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_PACKET_HPP
+#define UFO_MATH_PACKET_HPP
+
+// STL
+#include <cstddef>
+
+namespace ufo
+{
+/*!
+ * @brief Number of bytes in the widest vector register the code is compiled for.
+ */
+#if defined(__AVX512F__)
+inline constexpr std::size_t simd_width_bytes = 64;
+#elif defined(__AVX__)
+inline constexpr std::size_t simd_width_bytes = 32;
+#else
+inline constexpr std::size_t simd_width_bytes = 16;
+#endif
+
+/*!
+ * @brief Default number of lanes in a structure-of-arrays packet of `T`.
+ *
+ * One full vector register of `T`, but never fewer than 8, so that it is 16 for `float`
+ * with AVX-512 and 8 otherwise. Packet kernels are written as plain loops over the lanes
+ * that the compiler vectorizes.
+ */
+template <class T>
+inline constexpr std::size_t packet_size_v =
+    8 < simd_width_bytes / sizeof(T) ? simd_width_bytes / sizeof(T) : 8;
+}  // namespace ufo
+
+#endif  // UFO_MATH_PACKET_HPP
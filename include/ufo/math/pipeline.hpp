@@ -0,0 +1,328 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_PIPELINE_HPP
+#define UFO_MATH_PIPELINE_HPP
+
+// UFO
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/generator.hpp>
+
+// STL
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Number of elements per chunk when none is given, 4096 `Vec3f` are 48 KiB and
+ * stay in L2 between stages.
+ */
+inline constexpr std::size_t default_chunk_size = 4096;
+
+/*!
+ * @brief Stream of chunks that the stages below take and produce.
+ *
+ * A chunk is only valid until the next one is requested. Stages work in place on the
+ * chunk they get, so a whole pipeline touches every element once per stage while it is
+ * still in cache, instead of once per stage over the whole scan:
+ *
+ * @code
+ * for (std::span<Vec3f> chunk :
+ *      filterChunks(transformChunks(t, chunks(scan)), [](Vec3f const& p) { ... })) {
+ *   integrate(chunk);
+ * }
+ * @endcode
+ *
+ * `asyncChunks` moves everything before it to its own thread, so the stages before and
+ * after it overlap on different cores.
+ */
+template <class T>
+using Chunks = Generator<std::span<T>>;
+
+namespace detail
+{
+/*!
+ * @brief Bounded queue of chunks between the thread of `asyncChunks` and its consumer.
+ */
+template <class T>
+class ChunkQueue
+{
+ public:
+	explicit ChunkQueue(std::size_t depth) : slots_(std::max(std::size_t(1), depth)) {}
+
+	void produce(Chunks<T>& chunks)
+	{
+		try {
+			for (std::span<T> chunk : chunks) {
+				{
+					std::unique_lock lock(mutex_);
+					cv_.wait(lock, [this] { return stop_ || slots_.size() > tail_ - head_; });
+					if (stop_) {
+						break;
+					}
+				}
+
+				// The consumer does not look at this slot until `tail_` moves past it
+				slots_[tail_ % slots_.size()].assign(chunk.begin(), chunk.end());
+
+				{
+					std::lock_guard lock(mutex_);
+					++tail_;
+				}
+				cv_.notify_all();
+			}
+		} catch (...) {
+			std::lock_guard lock(mutex_);
+			error_ = std::current_exception();
+		}
+
+		{
+			std::lock_guard lock(mutex_);
+			done_ = true;
+		}
+		cv_.notify_all();
+	}
+
+	/*!
+	 * @brief Waits for the next chunk, empty once the producer is done.
+	 */
+	[[nodiscard]] std::optional<std::span<T>> pop()
+	{
+		std::unique_lock lock(mutex_);
+		cv_.wait(lock, [this] { return done_ || tail_ != head_; });
+		if (tail_ == head_) {
+			return std::nullopt;
+		}
+		return std::span<T>(slots_[head_ % slots_.size()]);
+	}
+
+	/*!
+	 * @brief Gives the slot of the chunk returned by `pop` back to the producer.
+	 */
+	void release()
+	{
+		{
+			std::lock_guard lock(mutex_);
+			++head_;
+		}
+		cv_.notify_all();
+	}
+
+	void stop()
+	{
+		{
+			std::lock_guard lock(mutex_);
+			stop_ = true;
+		}
+		cv_.notify_all();
+	}
+
+	void rethrow()
+	{
+		std::lock_guard lock(mutex_);
+		if (error_) {
+			std::rethrow_exception(error_);
+		}
+	}
+
+ private:
+	std::vector<std::vector<T>> slots_;
+	std::size_t                 head_{};
+	std::size_t                 tail_{};
+	bool                        done_{};
+	bool                        stop_{};
+	std::exception_ptr          error_{};
+	std::mutex                  mutex_;
+	std::condition_variable     cv_;
+};
+
+/*!
+ * @brief Stops and joins the producer of `asyncChunks`, also when the consumer stops
+ * early.
+ */
+template <class T>
+struct ChunkProducer {
+	ChunkQueue<T>& queue;
+	std::thread    thread;
+
+	ChunkProducer(ChunkQueue<T>& queue, Chunks<T>& chunks)
+	    : queue(queue), thread([&queue, &chunks] { queue.produce(chunks); })
+	{
+	}
+
+	ChunkProducer(ChunkProducer const&) = delete;
+
+	ChunkProducer& operator=(ChunkProducer const&) = delete;
+
+	~ChunkProducer()
+	{
+		queue.stop();
+		thread.join();
+	}
+};
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Source                                        |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Copies [`first`, `last`) into chunks of `size` elements (the last one may be
+ * smaller), the input itself is never modified but has to outlive the chunks.
+ */
+template <class InputIt>
+[[nodiscard]] Chunks<typename std::iterator_traits<InputIt>::value_type> chunks(
+    InputIt first, InputIt last, std::size_t size = default_chunk_size)
+{
+	using T = typename std::iterator_traits<InputIt>::value_type;
+
+	std::vector<T> buffer;
+	buffer.reserve(std::max(std::size_t(1), size));
+	while (last != first) {
+		buffer.clear();
+		for (; last != first && buffer.capacity() > buffer.size(); ++first) {
+			buffer.push_back(*first);
+		}
+		co_yield std::span<T>(buffer);
+	}
+}
+
+template <class Range>
+[[nodiscard]] auto chunks(Range const& range, std::size_t size = default_chunk_size)
+{
+	using std::begin;
+	using std::end;
+	return chunks(begin(range), end(range), size);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Stages                                        |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Calls `f(chunk)` on every chunk. If `f` returns a `std::span<T>`, that is
+ * passed on instead of the chunk (for example a prefix after compaction), otherwise the
+ * chunk as `f` left it.
+ */
+template <class T, class UnaryFunction>
+[[nodiscard]] Chunks<T> mapChunks(Chunks<T> chunks, UnaryFunction f)
+{
+	for (std::span<T> chunk : chunks) {
+		if constexpr (std::is_void_v<std::invoke_result_t<UnaryFunction&, std::span<T>>>) {
+			f(chunk);
+			co_yield chunk;
+		} else {
+			co_yield std::span<T>(f(chunk));
+		}
+	}
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] Chunks<Vec<Dim, T>> transformChunks(Transform<Dim, T> t,
+                                                  Chunks<Vec<Dim, T>> chunks)
+{
+	for (std::span<Vec<Dim, T>> chunk : chunks) {
+		transformInPlace(t, chunk.begin(), chunk.end());
+		co_yield chunk;
+	}
+}
+
+template <class T>
+[[nodiscard]] Chunks<Vec<3, T>> transformChunks(QuatTransform<T> t,
+                                                Chunks<Vec<3, T>> chunks)
+{
+	for (std::span<Vec<3, T>> chunk : chunks) {
+		transformInPlace(t, chunk.begin(), chunk.end());
+		co_yield chunk;
+	}
+}
+
+/*!
+ * @brief Keeps the elements for which `pred` returns true, in order. Chunks that end up
+ * empty are dropped.
+ */
+template <class T, class UnaryPredicate>
+[[nodiscard]] Chunks<T> filterChunks(Chunks<T> chunks, UnaryPredicate pred)
+{
+	for (std::span<T> chunk : chunks) {
+		auto const last = std::remove_if(chunk.begin(), chunk.end(),
+		                                 [&pred](T const& x) { return !pred(x); });
+		if (chunk.begin() != last) {
+			co_yield chunk.first(static_cast<std::size_t>(last - chunk.begin()));
+		}
+	}
+}
+
+/*!
+ * @brief Runs `chunks`, and so every stage before this one, on a thread of its own that
+ * stays up to `depth` chunks ahead of the consumer.
+ *
+ * Each chunk is copied once into a queue slot. Exceptions from the earlier stages are
+ * rethrown to the consumer after the chunks produced before them.
+ */
+template <class T>
+[[nodiscard]] Chunks<T> asyncChunks(Chunks<T> chunks, std::size_t depth = 2)
+{
+	detail::ChunkQueue<T>    queue(depth);
+	detail::ChunkProducer<T> producer(queue, chunks);
+	while (auto chunk = queue.pop()) {
+		co_yield *chunk;
+		queue.release();
+	}
+	queue.rethrow();
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_PIPELINE_HPP
@@ -0,0 +1,253 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_PLANE_HPP
+#define UFO_MATH_PLANE_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/mat3x3.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+#include <ufo/math/vec4.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief Plane given by a unit normal and the signed distance from the plane to the
+ * origin, so that `dot(normal, p) + distance` is the signed distance of `p` to the plane.
+ *
+ * This is the same convention as the planes of `Frustum`.
+ */
+template <class T = float>
+struct Plane {
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	Vec3<T> normal = Vec3<T>(T(0), T(0), T(1));
+	T       distance{};
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Plane() noexcept             = default;
+	constexpr Plane(Plane const&) noexcept = default;
+
+	constexpr Plane(Vec3<T> const& normal, T distance) noexcept
+	    : normal(normal), distance(distance)
+	{
+	}
+
+	/*!
+	 * @brief Plane with unit normal `normal` going through `point`.
+	 */
+	constexpr Plane(Vec3<T> const& normal, Vec3<T> const& point) noexcept
+	    : normal(normal), distance(-dot(normal, point))
+	{
+	}
+
+	/*!
+	 * @brief Plane through three points, with the normal pointing to the side from which
+	 * `p0`, `p1`, `p2` appear counter-clockwise.
+	 */
+	Plane(Vec3<T> const& p0, Vec3<T> const& p1, Vec3<T> const& p2)
+	    : Plane(normalize(cross(p1 - p0, p2 - p0)), p0)
+	{
+	}
+
+	/*!
+	 * @brief Plane from the coefficients `(a, b, c, d)` of `ax + by + cz + d = 0`.
+	 */
+	explicit Plane(Vec4<T> const& coefficients)
+	{
+		Vec3<T> n(coefficients.x, coefficients.y, coefficients.z);
+		T       len = norm(n);
+		normal      = n / len;
+		distance    = coefficients.w / len;
+	}
+
+	constexpr Plane& operator=(Plane const&) noexcept = default;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                 Conversion operator                                 |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] constexpr explicit operator Vec4<T>() const noexcept
+	{
+		return Vec4<T>(normal.x, normal.y, normal.z, distance);
+	}
+};
+
+using Planef = Plane<float>;
+using Planed = Plane<double>;
+
+template <class T>
+[[nodiscard]] constexpr bool operator==(Plane<T> const& lhs, Plane<T> const& rhs) noexcept
+{
+	return lhs.normal == rhs.normal && lhs.distance == rhs.distance;
+}
+
+template <class T>
+[[nodiscard]] constexpr bool operator!=(Plane<T> const& lhs, Plane<T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, Plane<T> const& plane)
+{
+	return out << "Normal: " << plane.normal << ", Distance: " << plane.distance;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Functions                                      |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+[[nodiscard]] constexpr T signedDistance(Plane<T> const& plane,
+                                         Vec3<T> const&  point) noexcept
+{
+	return plane.normal.x * point.x + plane.normal.y * point.y + plane.normal.z * point.z +
+	       plane.distance;
+}
+
+/*!
+ * @brief Orthogonal projection of `point` onto `plane`.
+ */
+template <class T>
+[[nodiscard]] constexpr Vec3<T> project(Plane<T> const& plane,
+                                        Vec3<T> const&  point) noexcept
+{
+	return point - plane.normal * signedDistance(plane, point);
+}
+
+template <class T>
+[[nodiscard]] Plane<T> transform(Transform<3, T> const& t, Plane<T> const& plane)
+{
+	Vec3<T> n = t.rotation * plane.normal;
+	return Plane<T>(n, plane.distance - dot(n, t.translation));
+}
+
+/*!
+ * @brief Least squares plane through the points in [`first`, `last`).
+ *
+ * The normal is the eigenvector belonging to the smallest eigenvalue of the covariance
+ * of the points, i.e., the plane minimizes the sum of squared orthogonal distances.
+ * Requires at least three points that are not collinear.
+ */
+template <class ForwardIt>
+[[nodiscard]] auto fitPlane(ForwardIt first, ForwardIt last)
+{
+	using T = typename std::iterator_traits<ForwardIt>::value_type::value_type;
+
+	auto const [centroid, cov] = detail::centroidCovariance(first, last);
+	return Plane<T>(eigenSymmetric(cov).second[0], centroid);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Batch                                        |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T, class InputIt, class OutputIt>
+OutputIt signedDistance(Plane<T> const& plane, InputIt first, InputIt last,
+                        OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [plane](auto const& p) { return signedDistance(plane, p); });
+}
+
+template <
+    class T, class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 signedDistance(ExecutionPolicy&& policy, Plane<T> const& plane,
+                         RandomIt1 first, RandomIt1 last, RandomIt2 d_first)
+{
+	return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                         [plane](auto const& p) { return signedDistance(plane, p); });
+}
+
+/*!
+ * @brief Number of points in [`first`, `last`) within `threshold` of `plane`.
+ */
+template <class T, class InputIt>
+[[nodiscard]] std::size_t countInliers(Plane<T> const& plane, InputIt first, InputIt last,
+                                       T threshold)
+{
+	std::size_t count{};
+	for (; last != first; ++first) {
+		count += std::abs(signedDistance(plane, *first)) <= threshold;
+	}
+	return count;
+}
+
+template <
+    class T, class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] std::size_t countInliers(ExecutionPolicy&& policy, Plane<T> const& plane,
+                                       RandomIt first, RandomIt last, T threshold)
+{
+	return detail::countInliers(std::forward<ExecutionPolicy>(policy), first, last,
+	                            [&](RandomIt f, RandomIt l) {
+		                            return countInliers(plane, f, l, threshold);
+	                            });
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_PLANE_HPP
@@ -0,0 +1,1050 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_POINT_IO_HPP
+#define UFO_MATH_POINT_IO_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/array_file.hpp>
+#include <ufo/math/chars.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/mapped_file.hpp>
+#include <ufo/math/strided_view.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief How `parseCSV` finds the points in a CSV file.
+ */
+struct CsvOptions {
+	char delimiter = ',';
+	// Number of lines at the start to skip, such as a line of column names
+	std::size_t header_lines = 0;
+	// The fields holding x, y and z
+	std::array<std::size_t, 3> columns{0, 1, 2};
+};
+
+enum class PointFileFormat : std::uint8_t { ASCII, BINARY };
+
+namespace detail
+{
+/*!
+ * @brief Splits text into lines, without the line ending (`\n` or `\r\n`).
+ */
+class LineReader
+{
+ public:
+	explicit LineReader(std::string_view text) noexcept : text_(text) {}
+
+	[[nodiscard]] bool next(std::string_view& line) noexcept
+	{
+		if (text_.empty()) {
+			return false;
+		}
+		auto const end = text_.find('\n');
+		line           = text_.substr(0, end);
+		text_.remove_prefix(std::string_view::npos == end ? text_.size() : end + 1);
+		if (!line.empty() && '\r' == line.back()) {
+			line.remove_suffix(1);
+		}
+		++number_;
+		return true;
+	}
+
+	/*!
+	 * @brief The number of the last line returned, starting from 1.
+	 */
+	[[nodiscard]] std::size_t number() const noexcept { return number_; }
+
+	/*!
+	 * @brief What has not been returned yet.
+	 */
+	[[nodiscard]] std::string_view rest() const noexcept { return text_; }
+
+ private:
+	std::string_view text_;
+	std::size_t      number_{};
+};
+
+[[nodiscard]] inline bool isBlankOrComment(std::string_view line) noexcept
+{
+	auto const first = line.find_first_not_of(" \t");
+	return std::string_view::npos == first || '#' == line[first];
+}
+
+/*!
+ * @brief The words of `line`, separated by runs of spaces and tabs.
+ */
+[[nodiscard]] inline std::vector<std::string_view> splitWords(std::string_view line)
+{
+	std::vector<std::string_view> w;
+	std::size_t                   first = line.find_first_not_of(" \t");
+	while (std::string_view::npos != first) {
+		std::size_t const last = std::min(line.find_first_of(" \t", first), line.size());
+		w.push_back(line.substr(first, last - first));
+		first = line.find_first_not_of(" \t", last);
+	}
+	return w;
+}
+
+[[noreturn]] inline void parseError(char const* format, std::size_t line,
+                                    std::string_view what)
+{
+	throw std::runtime_error(std::string(format) + " line " + std::to_string(line) + ": " +
+	                         std::string(what));
+}
+
+/*!
+ * @brief Reads `columns[i]` of the fields of `line` into `p[i]`. Fields are separated by
+ * `delimiter`, or by runs of spaces and tabs if `delimiter` is a space.
+ */
+template <class T>
+[[nodiscard]] bool parseFields(std::string_view line, char delimiter,
+                               std::array<std::size_t, 3> const& columns, Vec<3, T>& p)
+{
+	std::size_t const last_column = *std::max_element(columns.begin(), columns.end());
+
+	bool const  whitespace = ' ' == delimiter;
+	char const* first      = line.data();
+	char const* last       = line.data() + line.size();
+	for (std::size_t column{}; last_column >= column; ++column) {
+		if (whitespace) {
+			for (; last != first && (' ' == *first || '\t' == *first); ++first) {
+			}
+		}
+		char const* end = std::find_if(first, last, [whitespace, delimiter](char c) {
+			return whitespace ? ' ' == c || '\t' == c : delimiter == c;
+		});
+
+		for (std::size_t i{}; 3 > i; ++i) {
+			if (columns[i] == column) {
+				char const* begin = first;
+				for (; end != begin && (' ' == *begin || '\t' == *begin); ++begin) {
+				}
+				auto const res = std::from_chars(begin, end, p[i]);
+				if (std::errc() != res.ec) {
+					return false;
+				}
+			}
+		}
+
+		if (last == end && last_column != column) {
+			return false;
+		}
+		first = last == end ? end : end + 1;
+	}
+	return true;
+}
+
+/*!
+ * @brief Header of a PLY file.
+ */
+struct PlyHeader {
+	struct Property {
+		std::string name;
+		std::string type;
+		// For list properties the type of the count, `type` is that of the items
+		std::string count_type{};
+	};
+
+	struct Element {
+		std::string           name;
+		std::size_t           count{};
+		std::vector<Property> properties{};
+	};
+
+	std::string          format;
+	std::vector<Element> elements;
+	// Bytes up to and including the `end_header` line
+	std::size_t size{};
+};
+
+[[nodiscard]] inline PlyHeader parsePlyHeader(std::string_view text)
+{
+	LineReader       lines(text);
+	std::string_view line;
+	if (!lines.next(line) || "ply" != line) {
+		throw std::runtime_error("Not a PLY file");
+	}
+
+	PlyHeader h;
+	while (lines.next(line)) {
+		auto const w = splitWords(line);
+		if (w.empty() || "comment" == w[0] || "obj_info" == w[0]) {
+			continue;
+		} else if ("end_header" == w[0]) {
+			h.size = text.size() - lines.rest().size();
+			if (h.format.empty()) {
+				parseError("PLY", lines.number(), "missing format");
+			}
+			return h;
+		} else if ("format" == w[0] && 3 == w.size()) {
+			h.format = w[1];
+		} else if ("element" == w[0] && 3 == w.size()) {
+			std::size_t count{};
+			auto const  res = std::from_chars(w[2].data(), w[2].data() + w[2].size(), count);
+			if (std::errc() != res.ec) {
+				parseError("PLY", lines.number(), line);
+			}
+			h.elements.push_back({std::string(w[1]), count});
+		} else if ("property" == w[0] && 3 == w.size() && !h.elements.empty()) {
+			h.elements.back().properties.push_back({std::string(w[2]), std::string(w[1])});
+		} else if ("property" == w[0] && 5 == w.size() && "list" == w[1] &&
+		           !h.elements.empty()) {
+			h.elements.back().properties.push_back(
+			    {std::string(w[4]), std::string(w[3]), std::string(w[2])});
+		} else {
+			parseError("PLY", lines.number(), line);
+		}
+	}
+	throw std::runtime_error("PLY header has no end_header");
+}
+
+/*!
+ * @brief The indices of the x, y and z properties of `element`.
+ */
+[[nodiscard]] inline std::array<std::size_t, 3> plyPositionColumns(
+    PlyHeader::Element const& element)
+{
+	std::array<std::size_t, 3> columns{};
+	std::array<char const*, 3> names{"x", "y", "z"};
+	for (std::size_t i{}; 3 > i; ++i) {
+		auto const it = std::find_if(
+		    element.properties.begin(), element.properties.end(),
+		    [&names, i](PlyHeader::Property const& p) { return names[i] == p.name; });
+		if (element.properties.end() == it || !it->count_type.empty()) {
+			throw std::runtime_error(std::string("PLY vertex element has no property ") +
+			                         names[i]);
+		}
+		columns[i] = static_cast<std::size_t>(it - element.properties.begin());
+	}
+	return columns;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                    Point layout                                     |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Where the points are in a PLY or PCD file and where x, y and z are in each.
+ */
+struct PointLayout {
+	struct Field {
+		ScalarType type{};
+		// Byte offset into a binary record, or field index in an ASCII line
+		std::size_t offset{};
+	};
+
+	// File format, for error messages
+	char const* name{};
+	bool        binary{};
+	// Whether the byte order of the file differs from the one of the host
+	bool swap{};
+	// Bytes before the first point
+	std::size_t data{};
+	// Number of points
+	std::size_t size{};
+	// Bytes per binary record
+	std::size_t stride{};
+	// ASCII lines between `data` and the first point, and before `data`
+	std::size_t          skip_lines{};
+	std::size_t          header_lines{};
+	std::array<Field, 3> fields{};
+};
+
+[[nodiscard]] inline ScalarType plyScalarType(std::string_view name)
+{
+	if ("char" == name || "int8" == name) {
+		return ScalarType::INT8;
+	} else if ("uchar" == name || "uint8" == name) {
+		return ScalarType::UINT8;
+	} else if ("short" == name || "int16" == name) {
+		return ScalarType::INT16;
+	} else if ("ushort" == name || "uint16" == name) {
+		return ScalarType::UINT16;
+	} else if ("int" == name || "int32" == name) {
+		return ScalarType::INT32;
+	} else if ("uint" == name || "uint32" == name) {
+		return ScalarType::UINT32;
+	} else if ("float" == name || "float32" == name) {
+		return ScalarType::FLOAT;
+	} else if ("double" == name || "float64" == name) {
+		return ScalarType::DOUBLE;
+	}
+	throw std::runtime_error("Unknown PLY property type '" + std::string(name) + "'");
+}
+
+[[nodiscard]] inline PointLayout plyLayout(std::string_view text)
+{
+	PlyHeader const h = parsePlyHeader(text);
+
+	PointLayout l;
+	l.name         = "PLY";
+	l.data         = h.size;
+	l.header_lines = static_cast<std::size_t>(
+	    std::count(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(h.size), '\n'));
+	if ("ascii" == h.format) {
+		l.binary = false;
+	} else if ("binary_little_endian" == h.format) {
+		l.binary = true;
+		l.swap   = std::endian::little != std::endian::native;
+	} else if ("binary_big_endian" == h.format) {
+		l.binary = true;
+		l.swap   = std::endian::big != std::endian::native;
+	} else {
+		throw std::runtime_error("PLY format '" + h.format + "' is not supported");
+	}
+
+	auto const record = [](PlyHeader::Element const& element) {
+		std::size_t size{};
+		for (auto const& p : element.properties) {
+			if (!p.count_type.empty()) {
+				throw std::runtime_error("Binary PLY element '" + element.name +
+				                         "' has list properties");
+			}
+			size += scalarSize(plyScalarType(p.type));
+		}
+		return size;
+	};
+
+	for (auto const& element : h.elements) {
+		if ("vertex" != element.name) {
+			// Elements before the vertices are skipped
+			if (l.binary) {
+				l.data += element.count * record(element);
+			} else {
+				l.skip_lines += element.count;
+			}
+			continue;
+		}
+
+		auto const columns = plyPositionColumns(element);
+
+		l.size = element.count;
+		if (l.binary) {
+			l.stride = record(element);
+		}
+		for (std::size_t i{}; 3 > i; ++i) {
+			l.fields[i].type   = plyScalarType(element.properties[columns[i]].type);
+			l.fields[i].offset = columns[i];
+			if (l.binary) {
+				l.fields[i].offset = 0;
+				for (std::size_t j{}; columns[i] > j; ++j) {
+					l.fields[i].offset += scalarSize(plyScalarType(element.properties[j].type));
+				}
+			}
+		}
+		return l;
+	}
+	throw std::runtime_error("PLY file has no vertex element");
+}
+
+[[nodiscard]] inline ScalarType pcdScalarType(std::string_view type,
+                                              std::string_view size)
+{
+	char const t = type.empty() ? '\0' : type[0];
+	if ("1" == size && ('I' == t || 'U' == t)) {
+		return 'I' == t ? ScalarType::INT8 : ScalarType::UINT8;
+	} else if ("2" == size && ('I' == t || 'U' == t)) {
+		return 'I' == t ? ScalarType::INT16 : ScalarType::UINT16;
+	} else if ("4" == size && 'F' == t) {
+		return ScalarType::FLOAT;
+	} else if ("4" == size && ('I' == t || 'U' == t)) {
+		return 'I' == t ? ScalarType::INT32 : ScalarType::UINT32;
+	} else if ("8" == size && 'F' == t) {
+		return ScalarType::DOUBLE;
+	} else if ("8" == size && ('I' == t || 'U' == t)) {
+		return 'I' == t ? ScalarType::INT64 : ScalarType::UINT64;
+	}
+	throw std::runtime_error("Unknown PCD field type '" + std::string(type) + "' of size " +
+	                         std::string(size));
+}
+
+[[nodiscard]] inline PointLayout pcdLayout(std::string_view text)
+{
+	PointLayout l;
+	l.name = "PCD";
+
+	std::vector<std::string_view> fields, sizes, types;
+	std::vector<std::size_t>      counts;
+	std::string_view              data;
+	std::size_t                   points{};
+
+	LineReader       lines(text);
+	std::string_view line;
+
+	// A whole word as a count, anything else is an error
+	auto const number = [&lines, &line](std::string_view word) {
+		std::size_t value{};
+		auto const  res = std::from_chars(word.data(), word.data() + word.size(), value);
+		if (std::errc() != res.ec || word.data() + word.size() != res.ptr) {
+			parseError("PCD", lines.number(), line);
+		}
+		return value;
+	};
+
+	while (data.empty() && lines.next(line)) {
+		auto const w = splitWords(line);
+		if (w.empty() || '#' == w[0][0]) {
+			continue;
+		}
+		std::vector<std::string_view> const values(w.begin() + 1, w.end());
+		if ("FIELDS" == w[0]) {
+			fields = values;
+		} else if ("SIZE" == w[0]) {
+			sizes = values;
+		} else if ("TYPE" == w[0]) {
+			types = values;
+		} else if ("COUNT" == w[0]) {
+			counts.clear();
+			for (auto const& v : values) {
+				counts.push_back(number(v));
+				if (0 == counts.back()) {
+					parseError("PCD", lines.number(), line);
+				}
+			}
+		} else if ("POINTS" == w[0] && 2 == w.size()) {
+			points = number(w[1]);
+		} else if ("DATA" == w[0] && 2 == w.size()) {
+			data = w[1];
+		} else if ("VERSION" != w[0] && "WIDTH" != w[0] && "HEIGHT" != w[0] &&
+		           "VIEWPOINT" != w[0]) {
+			parseError("PCD", lines.number(), line);
+		}
+	}
+
+	if (data.empty()) {
+		throw std::runtime_error("PCD header has no DATA line");
+	}
+	if (sizes.size() != fields.size() || types.size() != fields.size() ||
+	    (!counts.empty() && counts.size() != fields.size())) {
+		throw std::runtime_error("PCD header has FIELDS, SIZE, TYPE and COUNT of different "
+		                         "lengths");
+	}
+	if ("ascii" == data) {
+		l.binary = false;
+	} else if ("binary" == data) {
+		l.binary = true;
+		l.swap   = std::endian::little != std::endian::native;
+	} else {
+		throw std::runtime_error("PCD data '" + std::string(data) + "' is not supported");
+	}
+
+	l.data         = text.size() - lines.rest().size();
+	l.header_lines = lines.number();
+	l.size         = points;
+
+	std::array<bool, 3>              found{};
+	std::array<char const*, 3> const names{"x", "y", "z"};
+	std::size_t                      column{};
+	for (std::size_t f{}; fields.size() > f; ++f) {
+		std::size_t const count = counts.empty() ? 1 : counts[f];
+		ScalarType const type = pcdScalarType(types[f], sizes[f]);
+		for (std::size_t i{}; 3 > i; ++i) {
+			if (names[i] == fields[f]) {
+				l.fields[i] = {type, l.binary ? l.stride : column};
+				found[i]    = true;
+			}
+		}
+		l.stride += count * scalarSize(type);
+		column += count;
+	}
+	if (0 == l.stride) {
+		throw std::runtime_error("PCD header has records without bytes");
+	}
+
+	for (std::size_t i{}; 3 > i; ++i) {
+		if (!found[i]) {
+			throw std::runtime_error(std::string("PCD file has no field ") + names[i]);
+		}
+	}
+	return l;
+}
+
+/*!
+ * @brief Calls `f(S{})` with `S` the scalar of `type`, so that decoding loops are
+ * instantiated per type and nothing is decided per point.
+ */
+template <class F>
+void visitScalarType(ScalarType type, F f)
+{
+	switch (type) {
+		case ScalarType::INT8: f(std::int8_t{}); break;
+		case ScalarType::UINT8: f(std::uint8_t{}); break;
+		case ScalarType::INT16: f(std::int16_t{}); break;
+		case ScalarType::UINT16: f(std::uint16_t{}); break;
+		case ScalarType::INT32: f(std::int32_t{}); break;
+		case ScalarType::UINT32: f(std::uint32_t{}); break;
+		case ScalarType::INT64: f(std::int64_t{}); break;
+		case ScalarType::UINT64: f(std::uint64_t{}); break;
+		case ScalarType::FLOAT: f(float{}); break;
+		case ScalarType::DOUBLE: f(double{}); break;
+	}
+}
+
+template <class S, bool Swap>
+[[nodiscard]] S loadScalar(std::byte const* p) noexcept
+{
+	std::array<std::byte, sizeof(S)> b;
+	std::memcpy(b.data(), p, sizeof(S));
+	if constexpr (Swap) {
+		std::reverse(b.begin(), b.end());
+	}
+	return std::bit_cast<S>(b);
+}
+
+/*!
+ * @brief Views of the x, y and z of `points`.
+ */
+template <class T>
+[[nodiscard]] std::array<StridedView<T>, 3> componentViews(std::span<Vec<3, T>> points)
+{
+	auto const stride = static_cast<std::ptrdiff_t>(sizeof(Vec<3, T>));
+	if (points.empty()) {
+		return {StridedView<T>(static_cast<T*>(nullptr), 0, stride),
+		        StridedView<T>(static_cast<T*>(nullptr), 0, stride),
+		        StridedView<T>(static_cast<T*>(nullptr), 0, stride)};
+	}
+	return {StridedView<T>(&points[0][0], points.size(), stride),
+	        StridedView<T>(&points[0][1], points.size(), stride),
+	        StridedView<T>(&points[0][2], points.size(), stride)};
+}
+
+/*!
+ * @brief Writes field `c` of the records [`first`, `last`) to `out`.
+ */
+template <bool Swap, class T>
+void decodeField(PointLayout const& l, std::byte const* records, std::size_t c,
+                 std::size_t first, std::size_t last, StridedView<T> const& out)
+{
+	visitScalarType(l.fields[c].type, [&](auto tag) {
+		using S = decltype(tag);
+
+		std::byte const* p = records + first * l.stride + l.fields[c].offset;
+		for (; last != first; ++first, p += l.stride) {
+			out[first] = static_cast<T>(loadScalar<S, Swap>(p));
+		}
+	});
+}
+
+/*!
+ * @brief Decodes the points described by `l` from `bytes` into `out[0]`, `out[1]` and
+ * `out[2]`, which have `l.size` elements each.
+ *
+ * Binary records are decoded in blocks using `for_each`, one field at a time per block,
+ * so the types are only looked at once per block.
+ */
+template <class ForEach, class T>
+void decodePoints(ForEach for_each, std::string_view bytes, PointLayout const& l,
+                  std::array<StridedView<T>, 3> const& out)
+{
+	for (auto const& o : out) {
+		if (l.size != o.size()) {
+			throw std::invalid_argument("Output does not have one element per point");
+		}
+	}
+
+	if (!l.binary) {
+		LineReader       lines(bytes.substr(l.data));
+		std::string_view line;
+		for (std::size_t i{}; l.skip_lines > i; ++i) {
+			if (!lines.next(line)) {
+				throw std::runtime_error(std::string(l.name) + " file is truncated");
+			}
+		}
+
+		std::array<std::size_t, 3> const columns{l.fields[0].offset, l.fields[1].offset,
+		                                         l.fields[2].offset};
+		for (std::size_t i{}; l.size > i; ++i) {
+			if (!lines.next(line)) {
+				throw std::runtime_error(std::string(l.name) + " file is truncated");
+			}
+			Vec<3, T> p;
+			if (!parseFields(line, ' ', columns, p)) {
+				parseError(l.name, l.header_lines + l.skip_lines + lines.number(), line);
+			}
+			out[0][i] = p[0];
+			out[1][i] = p[1];
+			out[2][i] = p[2];
+		}
+		return;
+	}
+
+	if (bytes.size() < l.data || (bytes.size() - l.data) / l.stride < l.size) {
+		throw std::runtime_error(std::string(l.name) + " file is truncated");
+	}
+
+	auto const* records = static_cast<std::byte const*>(
+	    static_cast<void const*>(bytes.data() + l.data));
+
+	constexpr std::size_t block  = 1 << 14;
+	std::size_t const     blocks = (l.size + block - 1) / block;
+	for_each(0, blocks, [&](std::size_t b) {
+		std::size_t const first = b * block;
+		std::size_t const last  = std::min(l.size, first + block);
+		for (std::size_t c{}; 3 > c; ++c) {
+			if (l.swap) {
+				decodeField<true>(l, records, c, first, last, out[c]);
+			} else {
+				decodeField<false>(l, records, c, first, last, out[c]);
+			}
+		}
+	});
+}
+
+template <class T, class ForEach>
+[[nodiscard]] std::vector<Vec<3, T>> decodePoints(ForEach          for_each,
+                                                  std::string_view bytes,
+                                                  PointLayout const& l)
+{
+	std::vector<Vec<3, T>> points(l.size);
+	decodePoints(for_each, bytes, l, componentViews(std::span<Vec<3, T>>(points)));
+	return points;
+}
+
+/*!
+ * @brief Writes `header` followed by `points`, either as they are in memory or as lines
+ * of `x y z`.
+ */
+template <class T>
+void writePoints(std::filesystem::path const& path, std::string const& header,
+                 std::span<Vec<3, T> const> points, PointFileFormat format)
+{
+	static_assert(sizeof(Vec<3, T>) == 3 * sizeof(T), "Vec<3, T> has to be packed");
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Cannot open '" + path.string() + "' for writing");
+	}
+
+	file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+	if (PointFileFormat::BINARY == format) {
+		file.write(reinterpret_cast<char const*>(points.data()),
+		           static_cast<std::streamsize>(points.size_bytes()));
+	} else {
+		// Room for a line of three doubles in their shortest form
+		constexpr std::size_t line = 3 * 32;
+
+		std::vector<char> buffer(1 << 16);
+		char*             first = buffer.data();
+		char* const       last  = buffer.data() + buffer.size();
+		for (auto const& p : points) {
+			if (line > static_cast<std::size_t>(last - first)) {
+				file.write(buffer.data(), first - buffer.data());
+				first = buffer.data();
+			}
+			first    = toChars(first, last, p).ptr;
+			*first++ = '\n';
+		}
+		file.write(buffer.data(), first - buffer.data());
+	}
+
+	if (!file) {
+		throw std::runtime_error("Failed writing '" + path.string() + "'");
+	}
+}
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                         XYZ                                         |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Parses lines of `x y z`, separated by spaces, tabs or commas. Further columns
+ * are ignored, as are blank lines and lines starting with `#`.
+ *
+ * @throws std::runtime_error On a line that does not start with three numbers.
+ */
+template <class T = float>
+[[nodiscard]] std::vector<Vec<3, T>> parseXYZ(std::string_view text)
+{
+	std::vector<Vec<3, T>> points;
+	points.reserve(text.size() / 32);
+
+	detail::LineReader lines(text);
+	std::string_view   line;
+	while (lines.next(line)) {
+		if (detail::isBlankOrComment(line)) {
+			continue;
+		}
+		Vec<3, T>& p = points.emplace_back();
+		if (std::errc() != fromChars(line.data(), line.data() + line.size(), p).ec) {
+			detail::parseError("XYZ", lines.number(), line);
+		}
+	}
+	return points;
+}
+
+template <class T = float>
+[[nodiscard]] std::vector<Vec<3, T>> readXYZ(std::filesystem::path const& path)
+{
+	MappedFile const file(path);
+	return parseXYZ<T>(file.view());
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                         CSV                                         |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Parses the points of a CSV file, see `CsvOptions`. Blank lines are ignored.
+ *
+ * @throws std::runtime_error On a line without numbers in the position columns.
+ */
+template <class T = float>
+[[nodiscard]] std::vector<Vec<3, T>> parseCSV(std::string_view  text,
+                                              CsvOptions const& options = {})
+{
+	std::vector<Vec<3, T>> points;
+	points.reserve(text.size() / 32);
+
+	detail::LineReader lines(text);
+	std::string_view   line;
+	while (lines.next(line)) {
+		if (options.header_lines >= lines.number() ||
+		    std::string_view::npos == line.find_first_not_of(" \t")) {
+			continue;
+		}
+		Vec<3, T>& p = points.emplace_back();
+		if (!detail::parseFields(line, options.delimiter, options.columns, p)) {
+			detail::parseError("CSV", lines.number(), line);
+		}
+	}
+	return points;
+}
+
+template <class T = float>
+[[nodiscard]] std::vector<Vec<3, T>> readCSV(std::filesystem::path const& path,
+                                             CsvOptions const&            options = {})
+{
+	MappedFile const file(path);
+	return parseCSV<T>(file.view(), options);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                         PLY                                         |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Parses the x, y and z properties of the vertices of a PLY file, in ASCII or
+ * either binary format. Elements before the vertices are skipped, other properties are
+ * ignored.
+ *
+ * @throws std::runtime_error If the file is not a PLY file with a vertex element with x,
+ * y and z, or is truncated or malformed.
+ */
+template <class T = float>
+[[nodiscard]] std::vector<Vec<3, T>> parsePLY(std::string_view text)
+{
+	return detail::decodePoints<T>(detail::SequentialForEach{}, text,
+	                               detail::plyLayout(text));
+}
+
+template <class T = float>
+[[nodiscard]] std::vector<Vec<3, T>> readPLY(std::filesystem::path const& path)
+{
+	MappedFile const file(path);
+	return parsePLY<T>(file.view());
+}
+
+/*!
+ * @brief Like `readPLY(path)`, but binary vertices are decoded in blocks using `policy`.
+ */
+template <class T = float, class ExecutionPolicy,
+          std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] std::vector<Vec<3, T>> readPLY(ExecutionPolicy&&            policy,
+                                             std::filesystem::path const& path)
+{
+	MappedFile const file(path);
+	return detail::decodePoints<T>(detail::PolicyForEach<ExecutionPolicy>{policy},
+	                               file.view(), detail::plyLayout(file.view()));
+}
+
+/*!
+ * @brief Writes `points` as the x, y and z properties of the vertices of a PLY file,
+ * `float` or `double` as `T`. Binary files are little-endian.
+ *
+ * @throws std::runtime_error If the file cannot be written.
+ */
+template <class T>
+void writePLY(std::filesystem::path const& path, std::span<Vec<3, T> const> points,
+              PointFileFormat format = PointFileFormat::BINARY)
+{
+	static_assert(std::is_floating_point_v<T>, "T has to be float or double");
+	if (PointFileFormat::BINARY == format) {
+		detail::requireLittleEndian();
+	}
+
+	std::string const type = std::is_same_v<float, T> ? "float" : "double";
+
+	std::string header = "ply\nformat ";
+	header += PointFileFormat::BINARY == format ? "binary_little_endian" : "ascii";
+	header += " 1.0\nelement vertex " + std::to_string(points.size()) + '\n';
+	header += "property " + type + " x\nproperty " + type + " y\nproperty " + type + " z\n";
+	header += "end_header\n";
+
+	detail::writePoints(path, header, points, format);
+}
+
+template <class Range>
+void writePLY(std::filesystem::path const& path, Range const& range,
+              PointFileFormat format = PointFileFormat::BINARY)
+{
+	using T = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(range))>>;
+	writePLY(path, std::span<T const>(std::data(range), std::size(range)), format);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                         PCD                                         |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Parses the x, y and z fields of a PCD file with `DATA ascii` or `DATA binary`.
+ * Other fields are ignored. `DATA binary_compressed` is not supported.
+ *
+ * @throws std::runtime_error If the file is not a PCD file with x, y and z fields, or is
+ * truncated or malformed.
+ */
+template <class T = float>
+[[nodiscard]] std::vector<Vec<3, T>> parsePCD(std::string_view text)
+{
+	return detail::decodePoints<T>(detail::SequentialForEach{}, text,
+	                               detail::pcdLayout(text));
+}
+
+template <class T = float>
+[[nodiscard]] std::vector<Vec<3, T>> readPCD(std::filesystem::path const& path)
+{
+	MappedFile const file(path);
+	return parsePCD<T>(file.view());
+}
+
+/*!
+ * @brief Like `readPCD(path)`, but binary points are decoded in blocks using `policy`.
+ */
+template <class T = float, class ExecutionPolicy,
+          std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] std::vector<Vec<3, T>> readPCD(ExecutionPolicy&&            policy,
+                                             std::filesystem::path const& path)
+{
+	MappedFile const file(path);
+	return detail::decodePoints<T>(detail::PolicyForEach<ExecutionPolicy>{policy},
+	                               file.view(), detail::pcdLayout(file.view()));
+}
+
+/*!
+ * @brief Writes `points` as the x, y and z fields of a PCD file, `float` or `double` as
+ * `T`. Binary files are little-endian.
+ *
+ * @throws std::runtime_error If the file cannot be written.
+ */
+template <class T>
+void writePCD(std::filesystem::path const& path, std::span<Vec<3, T> const> points,
+              PointFileFormat format = PointFileFormat::BINARY)
+{
+	static_assert(std::is_floating_point_v<T>, "T has to be float or double");
+	if (PointFileFormat::BINARY == format) {
+		detail::requireLittleEndian();
+	}
+
+	std::string const size = std::to_string(sizeof(T));
+	std::string const n    = std::to_string(points.size());
+
+	std::string header = "# .PCD v0.7 - Point Cloud Data file format\nVERSION 0.7\n";
+	header += "FIELDS x y z\nSIZE " + size + ' ' + size + ' ' + size + '\n';
+	header += "TYPE F F F\nCOUNT 1 1 1\nWIDTH " + n + "\nHEIGHT 1\n";
+	header += "VIEWPOINT 0 0 0 1 0 0 0\nPOINTS " + n + "\nDATA ";
+	header += PointFileFormat::BINARY == format ? "binary\n" : "ascii\n";
+
+	detail::writePoints(path, header, points, format);
+}
+
+template <class Range>
+void writePCD(std::filesystem::path const& path, Range const& range,
+              PointFileFormat format = PointFileFormat::BINARY)
+{
+	using T = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(range))>>;
+	writePCD(path, std::span<T const>(std::data(range), std::size(range)), format);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                  Point cloud file                                   |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief A memory-mapped PLY or PCD file whose points are decoded straight into buffers
+ * of the caller, either `Vec3`s or separate x, y and z arrays.
+ *
+ * The header is parsed once when opening. Reading allocates nothing, and binary files are
+ * decoded in blocks, in parallel when given an execution policy.
+ */
+class PointCloudFile
+{
+ public:
+	/*!
+	 * @brief Opens `path`, a PLY file if it starts with `ply` and a PCD file otherwise.
+	 *
+	 * @throws std::runtime_error If the file cannot be read or its header is malformed.
+	 */
+	explicit PointCloudFile(std::filesystem::path const& path) : file_(path)
+	{
+		std::string_view const text = file_.view();
+		layout_ = text.starts_with("ply") ? detail::plyLayout(text) : detail::pcdLayout(text);
+	}
+
+	/*!
+	 * @brief The number of points.
+	 */
+	[[nodiscard]] std::size_t size() const noexcept { return layout_.size; }
+
+	[[nodiscard]] bool binary() const noexcept { return layout_.binary; }
+
+	/*!
+	 * @throws std::invalid_argument If `points` does not have `size()` elements.
+	 * @throws std::runtime_error If the file is truncated or malformed.
+	 */
+	template <class T>
+	void read(std::span<Vec<3, T>> points) const
+	{
+		read(detail::SequentialForEach{}, detail::componentViews(points));
+	}
+
+	template <class ExecutionPolicy, class T,
+	          std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+	void read(ExecutionPolicy&& policy, std::span<Vec<3, T>> points) const
+	{
+		read(detail::PolicyForEach<ExecutionPolicy>{policy}, detail::componentViews(points));
+	}
+
+	/*!
+	 * @brief Reads the points into separate x, y and z arrays.
+	 *
+	 * @throws std::invalid_argument If `x`, `y` or `z` does not have `size()` elements.
+	 * @throws std::runtime_error If the file is truncated or malformed.
+	 */
+	template <class T>
+	void read(std::span<T> x, std::span<T> y, std::span<T> z) const
+	{
+		read(detail::SequentialForEach{}, soaViews(x, y, z));
+	}
+
+	template <class ExecutionPolicy, class T,
+	          std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+	void read(ExecutionPolicy&& policy, std::span<T> x, std::span<T> y,
+	          std::span<T> z) const
+	{
+		read(detail::PolicyForEach<ExecutionPolicy>{policy}, soaViews(x, y, z));
+	}
+
+	template <class T = float>
+	[[nodiscard]] std::vector<Vec<3, T>> read() const
+	{
+		std::vector<Vec<3, T>> points(size());
+		read(std::span<Vec<3, T>>(points));
+		return points;
+	}
+
+	template <class T = float, class ExecutionPolicy,
+	          std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+	[[nodiscard]] std::vector<Vec<3, T>> read(ExecutionPolicy&& policy) const
+	{
+		std::vector<Vec<3, T>> points(size());
+		read(std::forward<ExecutionPolicy>(policy), std::span<Vec<3, T>>(points));
+		return points;
+	}
+
+ private:
+	template <class T>
+	[[nodiscard]] static std::array<StridedView<T>, 3> soaViews(std::span<T> x,
+	                                                            std::span<T> y,
+	                                                            std::span<T> z) noexcept
+	{
+		auto const stride = static_cast<std::ptrdiff_t>(sizeof(T));
+		return {StridedView<T>(x.data(), x.size(), stride),
+		        StridedView<T>(y.data(), y.size(), stride),
+		        StridedView<T>(z.data(), z.size(), stride)};
+	}
+
+	template <class ForEach, class T>
+	void read(ForEach for_each, std::array<StridedView<T>, 3> const& out) const
+	{
+		detail::decodePoints(for_each, file_.view(), layout_, out);
+	}
+
+ private:
+	MappedFile          file_;
+	detail::PointLayout layout_;
+};
+}  // namespace ufo
+
+#endif  // UFO_MATH_POINT_IO_HPP
@@ -0,0 +1,255 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_QUANTIZER_HPP
+#define UFO_MATH_QUANTIZER_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+namespace detail
+{
+// Spread the lower 21 bits so that there are two zero bits between each
+[[nodiscard]] constexpr std::uint64_t spreadBits3(std::uint64_t x) noexcept
+{
+	x &= 0x1FFFFFu;
+	x = (x | x << 32) & 0x1F00000000FFFFu;
+	x = (x | x << 16) & 0x1F0000FF0000FFu;
+	x = (x | x << 8) & 0x100F00F00F00F00Fu;
+	x = (x | x << 4) & 0x10C30C30C30C30C3u;
+	x = (x | x << 2) & 0x1249249249249249u;
+	return x;
+}
+
+// Inverse of `spreadBits3`
+[[nodiscard]] constexpr std::uint64_t compactBits3(std::uint64_t x) noexcept
+{
+	x &= 0x1249249249249249u;
+	x = (x ^ (x >> 2)) & 0x10C30C30C30C30C3u;
+	x = (x ^ (x >> 4)) & 0x100F00F00F00F00Fu;
+	x = (x ^ (x >> 8)) & 0x1F0000FF0000FFu;
+	x = (x ^ (x >> 16)) & 0x1F00000000FFFFu;
+	x = (x ^ (x >> 32)) & 0x1FFFFFu;
+	return x;
+}
+}  // namespace detail
+
+/*!
+ * @brief Quantizes points inside an axis-aligned bounding box to `Bits` bits per axis,
+ * packed into a single `std::uint32_t` (`3 * Bits <= 32`) or `std::uint64_t`.
+ *
+ * The box is divided into `2^Bits - 1` steps per axis and points are rounded to the
+ * nearest grid point, so the reconstruction error per axis is at most half a step (see
+ * `errorBound`). Points outside the box are clamped to it. If `Morton` is true the
+ * axes are bit-interleaved, giving codes that sort in Morton (Z-) order.
+ *
+ * Encoding and decoding are branchless, so the batch overloads vectorize.
+ *
+ * | Bits | Code            | Error bound for a 100 m box |
+ * | ---- | --------------- | --------------------------- |
+ * | 10   | `std::uint32_t` | 4.9 cm                      |
+ * | 16   | `std::uint64_t` | 0.77 mm                     |
+ * | 21   | `std::uint64_t` | 0.024 mm                    |
+ *
+ * @tparam Bits Number of bits per axis (1-21)
+ * @tparam T The scalar type
+ * @tparam Morton Whether the axes are bit-interleaved
+ */
+template <std::size_t Bits, class T = float, bool Morton = false>
+class Quantizer
+{
+	static_assert(0 < Bits && 21 >= Bits, "Bits has to be in the range [1, 21]");
+	static_assert(std::is_floating_point_v<T>, "T has to be a floating point type");
+
+ public:
+	using value_type = T;
+	using code_type  = std::conditional_t<32 >= 3 * Bits, std::uint32_t, std::uint64_t>;
+
+	static constexpr std::uint32_t const max_level = (std::uint32_t(1) << Bits) - 1u;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Quantizer(Vec3<T> const& min, Vec3<T> const& max) noexcept
+	    : min_(min)
+	    , max_(max)
+	    , step_((max - min) / static_cast<T>(max_level))
+	    , inv_step_(static_cast<T>(max_level) / (max - min))
+	{
+		assert(all(lessThan(min, max)));
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Encoding                                       |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] code_type encode(Vec3<T> const& v) const noexcept
+	{
+		Vec3<T> q = clamp((v - min_) * inv_step_, Vec3<T>(0), Vec3<T>(static_cast<T>(max_level)));
+		std::uint64_t x = static_cast<std::uint64_t>(q.x + T(0.5));
+		std::uint64_t y = static_cast<std::uint64_t>(q.y + T(0.5));
+		std::uint64_t z = static_cast<std::uint64_t>(q.z + T(0.5));
+
+		if constexpr (Morton) {
+			return static_cast<code_type>(detail::spreadBits3(x) |
+			                              (detail::spreadBits3(y) << 1) |
+			                              (detail::spreadBits3(z) << 2));
+		} else {
+			return static_cast<code_type>(x | (y << Bits) | (z << (2 * Bits)));
+		}
+	}
+
+	template <class InputIt, class OutputIt>
+	OutputIt encode(InputIt first, InputIt last, OutputIt d_first) const
+	{
+		return std::transform(first, last, d_first,
+		                      [this](Vec3<T> const& v) { return encode(v); });
+	}
+
+	template <
+	    class ExecutionPolicy, class RandomIt1, class RandomIt2,
+	    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+	RandomIt2 encode(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+	                 RandomIt2 d_first) const
+	{
+		return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+		                         [this](Vec3<T> const& v) { return encode(v); });
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Decoding                                       |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] Vec3<T> decode(code_type code) const noexcept
+	{
+		std::uint64_t c = code;
+		std::uint64_t x, y, z;
+		if constexpr (Morton) {
+			x = detail::compactBits3(c);
+			y = detail::compactBits3(c >> 1);
+			z = detail::compactBits3(c >> 2);
+		} else {
+			x = c & max_level;
+			y = (c >> Bits) & max_level;
+			z = (c >> (2 * Bits)) & max_level;
+		}
+		return min_ + Vec3<T>(static_cast<T>(x), static_cast<T>(y), static_cast<T>(z)) * step_;
+	}
+
+	template <class InputIt, class OutputIt>
+	OutputIt decode(InputIt first, InputIt last, OutputIt d_first) const
+	{
+		return std::transform(first, last, d_first,
+		                      [this](code_type c) { return decode(c); });
+	}
+
+	template <
+	    class ExecutionPolicy, class RandomIt1, class RandomIt2,
+	    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+	RandomIt2 decode(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+	                 RandomIt2 d_first) const
+	{
+		return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+		                         [this](code_type c) { return decode(c); });
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Accessors                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] constexpr Vec3<T> const& min() const noexcept { return min_; }
+
+	[[nodiscard]] constexpr Vec3<T> const& max() const noexcept { return max_; }
+
+	/*!
+	 * @brief Distance between two neighbouring grid points along each axis.
+	 */
+	[[nodiscard]] constexpr Vec3<T> const& step() const noexcept { return step_; }
+
+	/*!
+	 * @brief Maximum per-axis reconstruction error for points inside the box.
+	 *
+	 * Half a step, plus a few ulps of slack for the rounding done in `T` when encoding
+	 * and decoding (only noticeable with 21 bits and `float`).
+	 */
+	[[nodiscard]] constexpr Vec3<T> errorBound() const noexcept
+	{
+		return step_ * static_cast<T>(0.5) +
+		       (abs(min_) + abs(max_)) * (T(4) * std::numeric_limits<T>::epsilon());
+	}
+
+	/*!
+	 * @brief Maximum Euclidean reconstruction error for points inside the box.
+	 */
+	[[nodiscard]] T maxError() const noexcept { return norm(errorBound()); }
+
+ private:
+	Vec3<T> min_;
+	Vec3<T> max_;
+	Vec3<T> step_;
+	Vec3<T> inv_step_;
+};
+}  // namespace ufo
+
+#endif  // UFO_MATH_QUANTIZER_HPP
@@ -0,0 +1,236 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_QUAT_TRANSFORM_HPP
+#define UFO_MATH_QUAT_TRANSFORM_HPP
+
+// UFO
+#include <ufo/math/detail/transform.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/mat3x3.hpp>
+#include <ufo/math/mat4x4.hpp>
+#include <ufo/math/quat.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <cstddef>
+#include <ostream>
+
+namespace ufo
+{
+/*!
+ * @brief Compact rigid 3D transform storing the rotation as a unit quaternion.
+ *
+ * Uses 7 scalars instead of the 12 of `Transform<3, T>`, which makes it the better
+ * choice for storing large numbers of poses. Transforming single points is slightly more
+ * expensive than with `Transform<3, T>`; the batch `transform` overloads therefore expand
+ * the rotation to a matrix once and transform all points with that.
+ *
+ * @tparam T The scalar type
+ */
+template <class T>
+struct QuatTransform {
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	Quat<T>   rotation;
+	Vec<3, T> translation;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr QuatTransform() noexcept                     = default;
+	constexpr QuatTransform(QuatTransform const&) noexcept = default;
+
+	constexpr QuatTransform(Quat<T> const& rotation, Vec<3, T> const& translation) noexcept
+	    : rotation(rotation), translation(translation)
+	{
+	}
+
+	constexpr explicit QuatTransform(Quat<T> const& rotation) noexcept
+	    : rotation(rotation)
+	{
+	}
+
+	template <class T1, class T2>
+	constexpr QuatTransform(Quat<T1> const& rotation,
+	                        Vec<3, T2> const& translation) noexcept
+	    : rotation(rotation), translation(translation)
+	{
+	}
+
+	constexpr QuatTransform(Mat<3, 3, T> const& rotation, Vec<3, T> const& translation)
+	    : rotation(rotation), translation(translation)
+	{
+	}
+
+	constexpr explicit QuatTransform(Mat<3, 3, T> const& rotation) : rotation(rotation) {}
+
+	constexpr explicit QuatTransform(Mat<4, 4, T> const& m)
+	    : QuatTransform(Mat<3, 3, T>(m), Vec<3, T>(m[3]))
+	{
+	}
+
+	constexpr explicit QuatTransform(Transform<3, T> const& t)
+	    : rotation(t.rotation), translation(t.translation)
+	{
+	}
+
+	template <class U>
+	constexpr explicit QuatTransform(QuatTransform<U> const& other) noexcept
+	    : rotation(other.rotation), translation(other.translation)
+	{
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                 Assignment operator                                 |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr QuatTransform& operator=(QuatTransform const&) noexcept = default;
+
+	template <class U>
+	constexpr QuatTransform& operator=(QuatTransform<U> const& rhs) noexcept
+	{
+		rotation    = rhs.rotation;
+		translation = rhs.translation;
+		return *this;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                 Conversion operator                                 |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr explicit operator Transform<3, T>() const
+	{
+		return Transform<3, T>(static_cast<Mat<3, 3, T>>(rotation), translation);
+	}
+
+	constexpr explicit operator Mat<3, 3, T>() const
+	{
+		return static_cast<Mat<3, 3, T>>(rotation);
+	}
+
+	constexpr explicit operator Mat<4, 4, T>() const
+	{
+		Mat<4, 4, T> m(static_cast<Mat<3, 3, T>>(rotation));
+		m[3] = Vec<4, T>(translation, T(1));
+		return m;
+	}
+
+	constexpr explicit operator Quat<T>() const { return rotation; }
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Something                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] Vec<3, T> operator()(Vec<3, T> const& v) const
+	{
+		return rotation * v + translation;
+	}
+
+	[[nodiscard]] Quat<T> operator()(Quat<T> const& q) const { return rotation * q; }
+
+	QuatTransform& operator*=(QuatTransform const& t)
+	{
+		translation = rotation * t.translation + translation;
+		rotation *= t.rotation;
+		return *this;
+	}
+};
+
+template <class T>
+QuatTransform<T> operator*(QuatTransform<T> const& t1, QuatTransform<T> const& t2)
+{
+	QuatTransform<T> t = t1;
+	t *= t2;
+	return t;
+}
+
+template <class T>
+Vec<3, T> operator*(QuatTransform<T> const& t, Vec<3, T> const& v)
+{
+	return t(v);
+}
+
+template <class T>
+Quat<T> operator*(QuatTransform<T> const& t, Quat<T> const& q)
+{
+	return t(q);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, QuatTransform<T> const& t)
+{
+	return out << "Translation: " << t.translation << ", Rotation: " << t.rotation;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Compare                                       |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+[[nodiscard]] constexpr bool operator==(QuatTransform<T> const& lhs,
+                                        QuatTransform<T> const& rhs) noexcept
+{
+	return lhs.rotation == rhs.rotation && lhs.translation == rhs.translation;
+}
+
+template <class T>
+[[nodiscard]] constexpr bool operator!=(QuatTransform<T> const& lhs,
+                                        QuatTransform<T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_QUAT_TRANSFORM_HPP
@@ -0,0 +1,468 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_RANSAC_HPP
+#define UFO_MATH_RANSAC_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/line.hpp>
+#include <ufo/math/plane.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+template <class T = float>
+struct RansacParams {
+	// Maximum distance from the model for a point to count as an inlier
+	T threshold = T(0.1);
+	// Probability that the returned model was estimated from an all-inlier sample
+	T confidence = T(0.99);
+
+	std::size_t max_iterations = 10'000;
+
+	// Hypotheses are generated and evaluated in batches of this size, which is also the
+	// amount of parallelism available to the execution policy overloads
+	std::size_t batch_size = 64;
+
+	// The result only depends on the seed, not on the execution policy or thread count
+	std::uint64_t seed = 0;
+
+	// Sequential probability ratio test, abandons bad hypotheses after verifying only a
+	// small part of the points (Matas & Chum, "Randomized RANSAC with Sequential
+	// Probability Ratio Test")
+	bool sprt = true;
+	// Probability that a point is consistent with a bad model
+	T sprt_delta = T(0.01);
+	// Initial estimate of the inlier ratio, updated as better models are found
+	T sprt_epsilon = T(0.1);
+	// Time to generate a hypothesis, measured in point verifications
+	T sprt_model_cost = T(200);
+
+	// Progressive sampling, assumes that the points are sorted by decreasing quality
+	// (Chum & Matas, "Matching with PROSAC - Progressive Sample Consensus")
+	bool prosac = false;
+
+	// Re-estimate the best model from all of its inliers using least squares
+	bool refine = true;
+};
+
+template <class Model>
+struct RansacResult {
+	Model model{};
+	// Zero if no model could be estimated
+	std::size_t inliers{};
+	std::size_t iterations{};
+};
+
+namespace detail
+{
+template <class T>
+struct RansacPlane {
+	using model_type                         = Plane<T>;
+	static constexpr std::size_t sample_size = 3;
+
+	[[nodiscard]] static bool fromSample(std::array<Vec3<T>, 3> const& s, Plane<T>& model)
+	{
+		Vec3<T> e1  = s[1] - s[0];
+		Vec3<T> e2  = s[2] - s[0];
+		Vec3<T> n   = cross(e1, e2);
+		T       len = norm(n);
+		if (!(std::numeric_limits<T>::epsilon() * norm(e1) * norm(e2) < len)) {
+			return false;
+		}
+		model = Plane<T>(n / len, s[0]);
+		return true;
+	}
+
+	template <class RandomIt>
+	[[nodiscard]] static std::size_t count(Plane<T> const& model, RandomIt first,
+	                                       RandomIt last, T threshold)
+	{
+		return countInliers(model, first, last, threshold);
+	}
+
+	[[nodiscard]] static bool isInlier(Plane<T> const& model, Vec3<T> const& p,
+	                                   T threshold)
+	{
+		return std::abs(signedDistance(model, p)) <= threshold;
+	}
+
+	template <class RandomIt>
+	[[nodiscard]] static Plane<T> refit(RandomIt first, RandomIt last)
+	{
+		return fitPlane(first, last);
+	}
+};
+
+template <class T>
+struct RansacLine {
+	using model_type                         = Line<T>;
+	static constexpr std::size_t sample_size = 2;
+
+	[[nodiscard]] static bool fromSample(std::array<Vec3<T>, 2> const& s, Line<T>& model)
+	{
+		Vec3<T> d   = s[1] - s[0];
+		T       len = norm(d);
+		if (!(T(0) < len)) {
+			return false;
+		}
+		model = Line<T>(s[0], d / len);
+		return true;
+	}
+
+	template <class RandomIt>
+	[[nodiscard]] static std::size_t count(Line<T> const& model, RandomIt first,
+	                                       RandomIt last, T threshold)
+	{
+		return countInliers(model, first, last, threshold);
+	}
+
+	[[nodiscard]] static bool isInlier(Line<T> const& model, Vec3<T> const& p, T threshold)
+	{
+		return distanceSquared(model, p) <= threshold * threshold;
+	}
+
+	template <class RandomIt>
+	[[nodiscard]] static Line<T> refit(RandomIt first, RandomIt last)
+	{
+		return fitLine(first, last);
+	}
+};
+
+[[nodiscard]] constexpr std::uint64_t splitMix64(std::uint64_t x) noexcept
+{
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+/*!
+ * @brief Logarithm of the SPRT decision threshold A, from A = t_M C + 1 + ln(A).
+ */
+template <class T>
+[[nodiscard]] T sprtLogThreshold(T delta, T epsilon, T model_cost)
+{
+	if (!(delta < epsilon) || !(T(1) > epsilon)) {
+		return std::numeric_limits<T>::infinity();
+	}
+
+	T const c = (T(1) - delta) * std::log((T(1) - delta) / (T(1) - epsilon)) +
+	            delta * std::log(delta / epsilon);
+	T const k = model_cost * c + T(1);
+
+	T a = k;
+	for (int i{}; 10 > i; ++i) {
+		a = k + std::log(a);
+	}
+	return std::log(a);
+}
+
+/*!
+ * @brief Number of iterations needed to draw an all-inlier sample with probability
+ * `confidence` when the inlier ratio is `w`.
+ */
+template <class T>
+[[nodiscard]] std::size_t ransacIterations(T w, std::size_t sample_size, T confidence,
+                                           std::size_t max_iterations)
+{
+	T const p = std::pow(w, static_cast<T>(sample_size));
+	if (T(1) <= p) {
+		return 1;
+	}
+	if (T(0) >= p) {
+		return max_iterations;
+	}
+	T const k = std::log(T(1) - confidence) / std::log(T(1) - p);
+	return static_cast<T>(max_iterations) < k ? max_iterations
+	                                          : static_cast<std::size_t>(std::ceil(k));
+}
+
+template <class Model, class ForEach, class RandomIt, class T>
+[[nodiscard]] RansacResult<typename Model::model_type> ransac(
+    ForEach for_each, RandomIt first, RandomIt last, RansacParams<T> const& params)
+{
+	using model_type = typename Model::model_type;
+
+	constexpr std::size_t m     = Model::sample_size;
+	constexpr std::size_t chunk = 1024;
+
+	RansacResult<model_type> best;
+
+	std::size_t const n_points = std::distance(first, last);
+	if (m > n_points || 0 == params.max_iterations) {
+		return best;
+	}
+
+	struct Hypothesis {
+		model_type  model;
+		std::size_t inliers;
+		bool        valid;
+	};
+
+	std::size_t const        batch_size = std::max(std::size_t(1), params.batch_size);
+	std::vector<Hypothesis>  hypotheses(batch_size);
+	std::vector<std::size_t> pool(batch_size);
+
+	// PROSAC growth function, see Chum & Matas (2005) section 2.3
+	std::size_t n       = params.prosac ? m : n_points;
+	double      t_n     = static_cast<double>(params.max_iterations);
+	double      t_prime = 1.0;
+	for (std::size_t i{}; m > i; ++i) {
+		t_n *= static_cast<double>(m - i) / static_cast<double>(n_points - i);
+	}
+
+	T epsilon = params.sprt_epsilon;
+	T log_a   = params.sprt ? sprtLogThreshold(params.sprt_delta, epsilon,
+	                                           params.sprt_model_cost)
+	                        : std::numeric_limits<T>::infinity();
+
+	std::size_t required = params.max_iterations;
+	std::size_t it{};
+	while (required > it) {
+		std::size_t const b = std::min(batch_size, params.max_iterations - it);
+
+		for (std::size_t j{}; b > j; ++j) {
+			while (n_points > n && static_cast<double>(it + j + 1) > t_prime) {
+				double const t_n1 = t_n * static_cast<double>(n + 1) / static_cast<double>(n + 1 - m);
+				t_prime += std::ceil(t_n1 - t_n);
+				t_n = t_n1;
+				++n;
+			}
+			pool[j] = n;
+		}
+
+		T const log_inlier  = std::log(params.sprt_delta / epsilon);
+		T const log_outlier = std::log((T(1) - params.sprt_delta) / (T(1) - epsilon));
+
+		for_each(0, b, [&, it](std::size_t j) {
+			std::mt19937_64 gen(splitMix64(params.seed ^ splitMix64(it + j)));
+
+			// Draw a minimal sample, for PROSAC always including the newest point of the pool
+			std::size_t const          size = pool[j];
+			std::array<std::size_t, m> idx{};
+			std::size_t                k{};
+			if (n_points > size) {
+				idx[k++] = size - 1;
+			}
+			std::uniform_int_distribution<std::size_t> dist(0, size - 1 - (n_points > size));
+			while (m > k) {
+				std::size_t i = dist(gen);
+				if (std::find(idx.begin(), idx.begin() + k, i) == idx.begin() + k) {
+					idx[k++] = i;
+				}
+			}
+
+			std::array<Vec3<T>, m> sample;
+			for (std::size_t i{}; m > i; ++i) {
+				sample[i] = first[idx[i]];
+			}
+
+			Hypothesis& h = hypotheses[j];
+			h.inliers     = 0;
+			h.valid       = Model::fromSample(sample, h.model);
+			if (!h.valid) {
+				return;
+			}
+
+			// Verify in chunks starting at a random point, so that spatially ordered
+			// input does not bias the early SPRT decisions
+			std::size_t const start = std::uniform_int_distribution<std::size_t>(
+			    0, n_points - 1)(gen);
+			T log_lambda{};
+			for (std::size_t done{}; n_points > done;) {
+				std::size_t const s = (start + done) % n_points;
+				std::size_t const c = std::min({chunk, n_points - s, n_points - done});
+
+				std::size_t const in = Model::count(h.model, first + s, first + s + c,
+				                                    params.threshold);
+				h.inliers += in;
+				done += c;
+
+				log_lambda += static_cast<T>(in) * log_inlier +
+				              static_cast<T>(c - in) * log_outlier;
+				if (log_lambda > log_a) {
+					h.valid = false;
+					return;
+				}
+			}
+		});
+
+		it += b;
+
+		bool improved = false;
+		for (std::size_t j{}; b > j; ++j) {
+			if (hypotheses[j].valid && hypotheses[j].inliers > best.inliers) {
+				best.model   = hypotheses[j].model;
+				best.inliers = hypotheses[j].inliers;
+				improved     = true;
+			}
+		}
+
+		if (improved) {
+			T const w = static_cast<T>(best.inliers) / static_cast<T>(n_points);
+			required  = ransacIterations(w, m, params.confidence, params.max_iterations);
+
+			if (params.sprt) {
+				epsilon = std::max(epsilon, w);
+				log_a   = sprtLogThreshold(params.sprt_delta, epsilon, params.sprt_model_cost);
+				// Good models are rejected with probability at most 1/A
+				T const alpha = std::exp(-log_a);
+				if (T(1) > alpha) {
+					required = std::min(
+					    params.max_iterations,
+					    static_cast<std::size_t>(std::ceil(static_cast<T>(required) /
+					                                       (T(1) - alpha))));
+				}
+			}
+		}
+	}
+
+	best.iterations = it;
+
+	if (params.refine && m < best.inliers) {
+		std::vector<Vec3<T>> inliers;
+		inliers.reserve(best.inliers);
+		for (auto i = first; last != i; ++i) {
+			if (Model::isInlier(best.model, *i, params.threshold)) {
+				inliers.push_back(*i);
+			}
+		}
+
+		model_type        refined = Model::refit(inliers.begin(), inliers.end());
+		std::size_t const count   = Model::count(refined, first, last, params.threshold);
+		if (count >= best.inliers) {
+			best.model   = refined;
+			best.inliers = count;
+		}
+	}
+
+	return best;
+}
+
+template <class RandomIt>
+using ransac_value_t =
+    typename std::iterator_traits<RandomIt>::value_type::value_type;
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                       RANSAC                                        |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Robustly fits a plane to the points in [`first`, `last`).
+ *
+ * Hypotheses are drawn from deterministic, seeded samples and scored with the vectorized
+ * `countInliers` kernel. Sampling stops as soon as the best model so far is found with
+ * the requested confidence, and with `params.sprt` most bad hypotheses are abandoned
+ * after verifying a fraction of the points.
+ */
+template <class RandomIt>
+[[nodiscard]] RansacResult<Plane<detail::ransac_value_t<RandomIt>>> ransacPlane(
+    RandomIt first, RandomIt last,
+    RansacParams<detail::ransac_value_t<RandomIt>> const& params = {})
+{
+	using T = detail::ransac_value_t<RandomIt>;
+	return detail::ransac<detail::RansacPlane<T>>(detail::SequentialForEach{}, first, last,
+	                                              params);
+}
+
+/*!
+ * @brief Robustly fits a plane, evaluating the hypotheses of each batch in parallel.
+ *
+ * Gives the same result as the sequential version for the same `params.seed`.
+ */
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] RansacResult<Plane<detail::ransac_value_t<RandomIt>>> ransacPlane(
+    ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+    RansacParams<detail::ransac_value_t<RandomIt>> const& params = {})
+{
+	using T = detail::ransac_value_t<RandomIt>;
+	return detail::ransac<detail::RansacPlane<T>>(
+	    detail::PolicyForEach<ExecutionPolicy>{policy}, first, last, params);
+}
+
+/*!
+ * @brief Robustly fits a line to the points in [`first`, `last`).
+ */
+template <class RandomIt>
+[[nodiscard]] RansacResult<Line<detail::ransac_value_t<RandomIt>>> ransacLine(
+    RandomIt first, RandomIt last,
+    RansacParams<detail::ransac_value_t<RandomIt>> const& params = {})
+{
+	using T = detail::ransac_value_t<RandomIt>;
+	return detail::ransac<detail::RansacLine<T>>(detail::SequentialForEach{}, first, last,
+	                                             params);
+}
+
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] RansacResult<Line<detail::ransac_value_t<RandomIt>>> ransacLine(
+    ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+    RansacParams<detail::ransac_value_t<RandomIt>> const& params = {})
+{
+	using T = detail::ransac_value_t<RandomIt>;
+	return detail::ransac<detail::RansacLine<T>>(
+	    detail::PolicyForEach<ExecutionPolicy>{policy}, first, last, params);
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_RANSAC_HPP
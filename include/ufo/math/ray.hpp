@@ -0,0 +1,237 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_RAY_HPP
+#define UFO_MATH_RAY_HPP
+
+// UFO
+#include <ufo/math/aabb.hpp>
+#include <ufo/math/packet.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+
+namespace ufo
+{
+/*!
+ * @brief Half-line starting at `origin` going in `direction`.
+ *
+ * The direction does not have to be normalized; distances along the ray are measured in
+ * multiples of its length.
+ */
+template <class T = float>
+struct Ray {
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	Vec3<T> origin{};
+	Vec3<T> direction = Vec3<T>(T(1), T(0), T(0));
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Ray() noexcept           = default;
+	constexpr Ray(Ray const&) noexcept = default;
+
+	constexpr Ray(Vec3<T> const& origin, Vec3<T> const& direction) noexcept
+	    : origin(origin), direction(direction)
+	{
+	}
+
+	constexpr Ray& operator=(Ray const&) noexcept = default;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Operators                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	/*!
+	 * @brief Point at distance `t` along the ray.
+	 */
+	[[nodiscard]] constexpr Vec3<T> operator()(T t) const noexcept
+	{
+		return origin + direction * t;
+	}
+};
+
+using Rayf = Ray<float>;
+using Rayd = Ray<double>;
+
+template <class T>
+[[nodiscard]] constexpr bool operator==(Ray<T> const& lhs, Ray<T> const& rhs) noexcept
+{
+	return lhs.origin == rhs.origin && lhs.direction == rhs.direction;
+}
+
+template <class T>
+[[nodiscard]] constexpr bool operator!=(Ray<T> const& lhs, Ray<T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, Ray<T> const& ray)
+{
+	return out << "Origin: " << ray.origin << ", Direction: " << ray.direction;
+}
+
+template <class T>
+[[nodiscard]] Ray<T> transform(Transform<3, T> const& t, Ray<T> const& ray)
+{
+	return Ray<T>(t * ray.origin, t.rotation * ray.direction);
+}
+
+/*!
+ * @brief `N` rays in structure-of-arrays layout.
+ */
+template <class T = float, std::size_t N = packet_size_v<T>>
+struct RayPacket {
+	static constexpr std::size_t size = N;
+
+	alignas(N * sizeof(T)) std::array<T, N> ox;
+	alignas(N * sizeof(T)) std::array<T, N> oy;
+	alignas(N * sizeof(T)) std::array<T, N> oz;
+	alignas(N * sizeof(T)) std::array<T, N> dx;
+	alignas(N * sizeof(T)) std::array<T, N> dy;
+	alignas(N * sizeof(T)) std::array<T, N> dz;
+
+	constexpr void set(std::size_t lane, Ray<T> const& ray) noexcept
+	{
+		ox[lane] = ray.origin.x;
+		oy[lane] = ray.origin.y;
+		oz[lane] = ray.origin.z;
+		dx[lane] = ray.direction.x;
+		dy[lane] = ray.direction.y;
+		dz[lane] = ray.direction.z;
+	}
+
+	[[nodiscard]] constexpr Ray<T> get(std::size_t lane) const noexcept
+	{
+		return Ray<T>(Vec3<T>(ox[lane], oy[lane], oz[lane]),
+		              Vec3<T>(dx[lane], dy[lane], dz[lane]));
+	}
+};
+
+/*!
+ * @brief Closest intersection found along a ray.
+ *
+ * `distance` is infinite if nothing was hit. `u` and `v` are the barycentric coordinates
+ * of the hit with respect to the second and third vertex of the triangle, and `index` is
+ * the index of the primitive that was hit (set by the functions that search over several
+ * primitives).
+ */
+template <class T = float>
+struct RayHit {
+	T           distance = std::numeric_limits<T>::infinity();
+	T           u{};
+	T           v{};
+	std::size_t index = std::numeric_limits<std::size_t>::max();
+
+	[[nodiscard]] constexpr explicit operator bool() const noexcept
+	{
+		return std::numeric_limits<T>::infinity() != distance;
+	}
+};
+
+/*!
+ * @brief `N` `RayHit`s in structure-of-arrays layout.
+ */
+template <class T = float, std::size_t N = packet_size_v<T>>
+struct RayHitPacket {
+	static constexpr std::size_t size = N;
+
+	alignas(N * sizeof(T)) std::array<T, N> distance;
+	alignas(N * sizeof(T)) std::array<T, N> u;
+	alignas(N * sizeof(T)) std::array<T, N> v;
+	std::array<std::size_t, N> index;
+
+	constexpr RayHitPacket() noexcept { clear(); }
+
+	constexpr void clear() noexcept
+	{
+		distance.fill(std::numeric_limits<T>::infinity());
+		u.fill(T(0));
+		v.fill(T(0));
+		index.fill(std::numeric_limits<std::size_t>::max());
+	}
+
+	[[nodiscard]] constexpr RayHit<T> get(std::size_t lane) const noexcept
+	{
+		return {distance[lane], u[lane], v[lane], index[lane]};
+	}
+};
+
+/*!
+ * @brief Intersects `ray` with `aabb` using the slab test, reporting where the ray enters
+ * the box (or `t_min` if it starts inside).
+ */
+template <class T>
+[[nodiscard]] constexpr RayHit<T> intersect(
+    Ray<T> const& ray, AABB<3, T> const& aabb, T t_min = T(0),
+    T t_max = std::numeric_limits<T>::infinity()) noexcept
+{
+	for (std::size_t i{}; 3 > i; ++i) {
+		T inv = T(1) / ray.direction[i];
+		T t0  = (aabb.min[i] - ray.origin[i]) * inv;
+		T t1  = (aabb.max[i] - ray.origin[i]) * inv;
+		t_min = std::max(t_min, std::min(t0, t1));
+		t_max = std::min(t_max, std::max(t0, t1));
+	}
+
+	RayHit<T> hit;
+	if (t_min <= t_max) {
+		hit.distance = t_min;
+	}
+	return hit;
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_RAY_HPP
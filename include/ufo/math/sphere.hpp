@@ -0,0 +1,238 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_SPHERE_HPP
+#define UFO_MATH_SPHERE_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/mat4x4.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+#include <ufo/math/vec4.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+template <class T = float>
+struct Sphere {
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	Vec3<T> center{};
+	T       radius{};
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Sphere() noexcept              = default;
+	constexpr Sphere(Sphere const&) noexcept = default;
+
+	constexpr Sphere(Vec3<T> const& center, T radius) noexcept
+	    : center(center), radius(radius)
+	{
+	}
+
+	constexpr Sphere& operator=(Sphere const&) noexcept = default;
+};
+
+using Spheref = Sphere<float>;
+using Sphered = Sphere<double>;
+
+template <class T>
+[[nodiscard]] constexpr bool operator==(Sphere<T> const& lhs, Sphere<T> const& rhs) noexcept
+{
+	return lhs.center == rhs.center && lhs.radius == rhs.radius;
+}
+
+template <class T>
+[[nodiscard]] constexpr bool operator!=(Sphere<T> const& lhs, Sphere<T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, Sphere<T> const& sphere)
+{
+	return out << "Center: " << sphere.center << ", Radius: " << sphere.radius;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Functions                                      |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Signed distance from `point` to the surface of `sphere`, negative inside.
+ */
+template <class T>
+[[nodiscard]] T signedDistance(Sphere<T> const& sphere, Vec3<T> const& point)
+{
+	return distance(sphere.center, point) - sphere.radius;
+}
+
+template <class T>
+[[nodiscard]] constexpr bool contains(Sphere<T> const& sphere, Vec3<T> const& point)
+{
+	return distanceSquared(sphere.center, point) <= sphere.radius * sphere.radius;
+}
+
+/*!
+ * @brief Applies the rigid transform `t` to `sphere`.
+ */
+template <class T>
+[[nodiscard]] Sphere<T> transform(Transform<3, T> const& t, Sphere<T> const& sphere)
+{
+	return Sphere<T>(t * sphere.center, sphere.radius);
+}
+
+/*!
+ * @brief Least squares sphere through the points in [`first`, `last`).
+ *
+ * Minimizes the algebraic distance `|p - c|^2 - r^2`, which is linear in the unknowns and
+ * therefore solved directly from the 4x4 normal equations. The points are centered on
+ * their centroid first to keep the system well conditioned. Requires at least four points
+ * that are not coplanar.
+ */
+template <class ForwardIt>
+[[nodiscard]] auto fitSphere(ForwardIt first, ForwardIt last)
+{
+	using T = typename std::iterator_traits<ForwardIt>::value_type::value_type;
+
+	Vec3<T>     centroid{};
+	std::size_t n{};
+	for (auto it = first; last != it; ++it, ++n) {
+		centroid += *it;
+	}
+	centroid /= static_cast<T>(n);
+
+	// |p|^2 = 2 c.p + (r^2 - |c|^2), unknowns u = (2c, r^2 - |c|^2)
+	Mat4x4<T> a(T(0));
+	Vec4<T>   b{};
+	for (auto it = first; last != it; ++it) {
+		Vec3<T> d = *it - centroid;
+		Vec4<T> row(d.x, d.y, d.z, T(1));
+		T       d2 = dot(d, d);
+		for (std::size_t i{}; 4 > i; ++i) {
+			a[i] += row * row[i];
+		}
+		b += row * d2;
+	}
+
+	Vec4<T> u = inverse(a) * b;
+	Vec3<T> c(u.x / T(2), u.y / T(2), u.z / T(2));
+	return Sphere<T>(centroid + c, std::sqrt(u.w + dot(c, c)));
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Batch                                        |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T, class InputIt, class OutputIt>
+OutputIt signedDistance(Sphere<T> const& sphere, InputIt first, InputIt last,
+                        OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [sphere](auto const& p) { return signedDistance(sphere, p); });
+}
+
+template <
+    class T, class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 signedDistance(ExecutionPolicy&& policy, Sphere<T> const& sphere,
+                         RandomIt1 first, RandomIt1 last, RandomIt2 d_first)
+{
+	return detail::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                         [sphere](auto const& p) { return signedDistance(sphere, p); });
+}
+
+/*!
+ * @brief Number of points in [`first`, `last`) within `threshold` of the surface of
+ * `sphere`.
+ */
+template <class T, class InputIt>
+[[nodiscard]] std::size_t countInliers(Sphere<T> const& sphere, InputIt first,
+                                       InputIt last, T threshold)
+{
+	// |d - r| <= t  <=>  (r - t)^2 <= d^2 <= (r + t)^2, avoiding the square root
+	T const lo = std::max(T(0), sphere.radius - threshold);
+	T const hi = sphere.radius + threshold;
+
+	T const lo2 = lo * lo;
+	T const hi2 = hi * hi;
+
+	std::size_t count{};
+	for (; last != first; ++first) {
+		T d2 = distanceSquared(sphere.center, *first);
+		count += lo2 <= d2 && hi2 >= d2;
+	}
+	return count;
+}
+
+template <
+    class T, class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] std::size_t countInliers(ExecutionPolicy&& policy, Sphere<T> const& sphere,
+                                       RandomIt first, RandomIt last, T threshold)
+{
+	return detail::countInliers(std::forward<ExecutionPolicy>(policy), first, last,
+	                            [&](RandomIt f, RandomIt l) {
+		                            return countInliers(sphere, f, l, threshold);
+	                            });
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_SPHERE_HPP
@@ -0,0 +1,411 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_STRIDED_VIEW_HPP
+#define UFO_MATH_STRIDED_VIEW_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/packet.hpp>
+#include <ufo/math/quat_transform.hpp>
+
+// STL
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief Random access iterator over `T`s that are `stride` bytes apart, such as one
+ * field of every element of an array of structs.
+ */
+template <class T>
+class StridedIterator
+{
+ public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type        = std::remove_cv_t<T>;
+	using difference_type   = std::ptrdiff_t;
+	using pointer           = T*;
+	using reference         = T&;
+
+	StridedIterator() = default;
+
+	StridedIterator(T* ptr, difference_type stride) noexcept : ptr_(ptr), stride_(stride)
+	{
+	}
+
+	// Allows iterator to const_iterator conversion
+	template <class U, std::enable_if_t<std::is_convertible_v<U*, T*>, bool> = true>
+	StridedIterator(StridedIterator<U> const& other) noexcept
+	    : ptr_(other.operator->()), stride_(other.stride())
+	{
+	}
+
+	[[nodiscard]] reference operator*() const noexcept { return *ptr_; }
+
+	[[nodiscard]] pointer operator->() const noexcept { return ptr_; }
+
+	[[nodiscard]] reference operator[](difference_type n) const noexcept
+	{
+		return *advance(ptr_, n * stride_);
+	}
+
+	[[nodiscard]] difference_type stride() const noexcept { return stride_; }
+
+	StridedIterator& operator++() noexcept
+	{
+		ptr_ = advance(ptr_, stride_);
+		return *this;
+	}
+
+	StridedIterator operator++(int) noexcept
+	{
+		auto tmp = *this;
+		++*this;
+		return tmp;
+	}
+
+	StridedIterator& operator--() noexcept
+	{
+		ptr_ = advance(ptr_, -stride_);
+		return *this;
+	}
+
+	StridedIterator operator--(int) noexcept
+	{
+		auto tmp = *this;
+		--*this;
+		return tmp;
+	}
+
+	StridedIterator& operator+=(difference_type n) noexcept
+	{
+		ptr_ = advance(ptr_, n * stride_);
+		return *this;
+	}
+
+	StridedIterator& operator-=(difference_type n) noexcept { return *this += -n; }
+
+	[[nodiscard]] friend StridedIterator operator+(StridedIterator it,
+	                                               difference_type n) noexcept
+	{
+		return it += n;
+	}
+
+	[[nodiscard]] friend StridedIterator operator+(difference_type n,
+	                                               StridedIterator it) noexcept
+	{
+		return it += n;
+	}
+
+	[[nodiscard]] friend StridedIterator operator-(StridedIterator it,
+	                                               difference_type n) noexcept
+	{
+		return it -= n;
+	}
+
+	[[nodiscard]] friend difference_type operator-(StridedIterator const& lhs,
+	                                               StridedIterator const& rhs) noexcept
+	{
+		// Default constructed iterators have no stride
+		return 0 == lhs.stride_ ? 0 : (bytes(lhs.ptr_) - bytes(rhs.ptr_)) / lhs.stride_;
+	}
+
+	[[nodiscard]] friend bool operator==(StridedIterator const& lhs,
+	                                     StridedIterator const& rhs) noexcept
+	{
+		return lhs.ptr_ == rhs.ptr_;
+	}
+
+	[[nodiscard]] friend auto operator<=>(StridedIterator const& lhs,
+	                                      StridedIterator const& rhs) noexcept
+	{
+		// Negative strides walk down in memory
+		return 0 > lhs.stride_ ? rhs.ptr_ <=> lhs.ptr_ : lhs.ptr_ <=> rhs.ptr_;
+	}
+
+ private:
+	using byte_type = std::conditional_t<std::is_const_v<T>, std::byte const, std::byte>;
+
+	[[nodiscard]] static byte_type* bytes(T* p) noexcept
+	{
+		return reinterpret_cast<byte_type*>(p);
+	}
+
+	[[nodiscard]] static T* advance(T* p, difference_type n) noexcept
+	{
+		return reinterpret_cast<T*>(bytes(p) + n);
+	}
+
+ private:
+	T*              ptr_{};
+	difference_type stride_{};
+};
+
+/*!
+ * @brief Non-owning view of `size` `T`s that are `stride` bytes apart.
+ *
+ * Lets the algorithms that take ranges of `Vec`s work directly on a field of an array of
+ * point records, without copying the field out and back in:
+ *
+ * @code
+ * struct Point { Vec3f xyz; float intensity; std::uint16_t ring; double t; };
+ * std::vector<Point> points = ...;
+ * transformInPlace(t, stridedView(points, &Point::xyz));
+ * @endcode
+ */
+template <class T>
+class StridedView
+{
+ public:
+	using value_type      = std::remove_cv_t<T>;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using pointer         = T*;
+	using reference       = T&;
+	using iterator        = StridedIterator<T>;
+	using const_iterator  = StridedIterator<T const>;
+	using void_pointer    = std::conditional_t<std::is_const_v<T>, void const*, void*>;
+	using byte_pointer =
+	    std::conditional_t<std::is_const_v<T>, std::byte const*, std::byte*>;
+
+	StridedView() = default;
+
+	/*!
+	 * @param first The first element.
+	 * @param size The number of elements.
+	 * @param stride The distance between two elements in bytes.
+	 */
+	StridedView(T* first, size_type size, difference_type stride) noexcept
+	    : first_(first, stride), size_(size)
+	{
+	}
+
+	/*!
+	 * @brief View of the `T`s at `offset` bytes into each of `size` records of `stride`
+	 * bytes starting at `base`.
+	 */
+	StridedView(void_pointer base, size_type size, difference_type stride,
+	            size_type offset = 0) noexcept
+	    : StridedView(static_cast<T*>(static_cast<void_pointer>(
+	                      static_cast<byte_pointer>(base) + offset)),
+	                  size, stride)
+	{
+	}
+
+	// Allows view to const view conversion
+	template <class U, std::enable_if_t<std::is_convertible_v<U*, T*>, bool> = true>
+	StridedView(StridedView<U> const& other) noexcept
+	    : first_(other.begin()), size_(other.size())
+	{
+	}
+
+	[[nodiscard]] iterator begin() const noexcept { return first_; }
+
+	[[nodiscard]] iterator end() const noexcept
+	{
+		return first_ + static_cast<difference_type>(size_);
+	}
+
+	[[nodiscard]] reference operator[](size_type pos) const noexcept
+	{
+		return first_[static_cast<difference_type>(pos)];
+	}
+
+	[[nodiscard]] reference front() const noexcept { return *first_; }
+
+	[[nodiscard]] reference back() const noexcept { return (*this)[size_ - 1]; }
+
+	[[nodiscard]] size_type size() const noexcept { return size_; }
+
+	[[nodiscard]] bool empty() const noexcept { return 0 == size_; }
+
+	/*!
+	 * @brief The distance between two elements in bytes.
+	 */
+	[[nodiscard]] difference_type stride() const noexcept { return first_.stride(); }
+
+ private:
+	iterator  first_{};
+	size_type size_{};
+};
+
+/*!
+ * @brief View of `member` of each of the `size` records starting at `first`.
+ */
+template <class S, class M, class C>
+[[nodiscard]] auto stridedView(S* first, std::size_t size, M C::*member) noexcept
+{
+	using T = std::conditional_t<std::is_const_v<S>, M const, M>;
+	if (0 == size) {
+		return StridedView<T>(static_cast<T*>(nullptr), 0, sizeof(S));
+	}
+	return StridedView<T>(&(first->*member), size, sizeof(S));
+}
+
+/*!
+ * @brief View of `member` of each record of the contiguous range `range`.
+ */
+template <class Range, class M, class C>
+[[nodiscard]] auto stridedView(Range& range, M C::*member) noexcept
+{
+	return stridedView(std::data(range), std::size(range), member);
+}
+
+namespace detail
+{
+/*!
+ * @brief Applies `t` to the `size` points starting at `first`.
+ *
+ * Points are gathered a packet at a time into one array per coordinate, transformed with
+ * plain loops over the lanes that the compiler vectorizes, and scattered back. The
+ * transform is copied to locals so the compiler knows the stores cannot change it.
+ */
+template <class T>
+void transformStrided(Transform<3, T> const& t, StridedIterator<Vec<3, T>> first,
+                      std::size_t size)
+{
+	constexpr std::size_t N = packet_size_v<T>;
+
+	Mat<3, 3, T> const r  = t.rotation;
+	Vec<3, T> const    tr = t.translation;
+
+	std::size_t i{};
+	for (; size >= i + N; i += N) {
+		auto const it = first + static_cast<std::ptrdiff_t>(i);
+
+		T x[N], y[N], z[N];
+		for (std::size_t j{}; N > j; ++j) {
+			Vec<3, T> const& p = it[static_cast<std::ptrdiff_t>(j)];
+			x[j]               = p[0];
+			y[j]               = p[1];
+			z[j]               = p[2];
+		}
+
+		T ox[N], oy[N], oz[N];
+		for (std::size_t j{}; N > j; ++j) {
+			ox[j] = r[0][0] * x[j] + r[1][0] * y[j] + r[2][0] * z[j] + tr[0];
+			oy[j] = r[0][1] * x[j] + r[1][1] * y[j] + r[2][1] * z[j] + tr[1];
+			oz[j] = r[0][2] * x[j] + r[1][2] * y[j] + r[2][2] * z[j] + tr[2];
+		}
+
+		for (std::size_t j{}; N > j; ++j) {
+			Vec<3, T>& p = it[static_cast<std::ptrdiff_t>(j)];
+			p[0]         = ox[j];
+			p[1]         = oy[j];
+			p[2]         = oz[j];
+		}
+	}
+
+	Transform<3, T> const local(r, tr);
+	for (; size > i; ++i) {
+		Vec<3, T>& p = first[static_cast<std::ptrdiff_t>(i)];
+		p            = local * p;
+	}
+}
+
+template <class ExecutionPolicy, class T>
+void transformStrided(ExecutionPolicy&& policy, Transform<3, T> const& t,
+                      StridedIterator<Vec<3, T>> first, std::size_t size)
+{
+	if (runSequential(size)) {
+		transformStrided(t, first, size);
+		return;
+	}
+
+	// Whole packets per block, so only the last block has a scalar tail
+	static constexpr std::size_t block  = 256 * packet_size_v<T>;
+	std::size_t const            blocks = (size + block - 1) / block;
+	forEach(std::forward<ExecutionPolicy>(policy), 0, blocks,
+	        [&t, first, size](std::size_t b) {
+		        std::size_t const begin = b * block;
+		        transformStrided(t, first + static_cast<std::ptrdiff_t>(begin),
+		                         std::min(block, size - begin));
+	        });
+}
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Transform                                      |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+void transformInPlace(Transform<3, T> const& t, StridedView<Vec<3, T>> view)
+{
+	detail::transformStrided(t, view.begin(), view.size());
+}
+
+template <class T>
+void transformInPlace(QuatTransform<T> const& t, StridedView<Vec<3, T>> view)
+{
+	detail::transformStrided(Transform<3, T>(t), view.begin(), view.size());
+}
+
+template <
+    class ExecutionPolicy, class T,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+void transformInPlace(ExecutionPolicy&& policy, Transform<3, T> const& t,
+                      StridedView<Vec<3, T>> view)
+{
+	detail::transformStrided(std::forward<ExecutionPolicy>(policy), t, view.begin(),
+	                         view.size());
+}
+
+template <
+    class ExecutionPolicy, class T,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+void transformInPlace(ExecutionPolicy&& policy, QuatTransform<T> const& t,
+                      StridedView<Vec<3, T>> view)
+{
+	detail::transformStrided(std::forward<ExecutionPolicy>(policy), Transform<3, T>(t),
+	                         view.begin(), view.size());
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_STRIDED_VIEW_HPP
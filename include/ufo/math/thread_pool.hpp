@@ -0,0 +1,519 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_THREAD_POOL_HPP
+#define UFO_MATH_THREAD_POOL_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/numa.hpp>
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+class ThreadPool;
+
+/*!
+ * @brief Execution policy that runs on a `ThreadPool`, see `ThreadPool::policy`.
+ *
+ * Accepted by every overload that takes an execution policy.
+ */
+struct ThreadPoolPolicy {
+	ThreadPool* pool;
+	// Smallest number of indices handed out at once, zero picks one from the size
+	std::size_t grain{};
+};
+
+template <class T>
+inline constexpr bool is_thread_pool_policy_v =
+    std::is_same_v<ThreadPoolPolicy, std::remove_cv_t<std::remove_reference_t<T>>>;
+
+namespace detail
+{
+template <class T>
+inline constexpr bool is_execution_policy_v =
+    execution::is_execution_policy_v<T> || is_thread_pool_policy_v<T>;
+}  // namespace detail
+
+/*!
+ * @brief Persistent worker threads running index loops with work stealing.
+ *
+ * A loop over `[first, last)` is split into one contiguous range per thread (the calling
+ * thread takes part as well). Each thread claims chunks from the front of its own range
+ * and, once that is empty, steals chunks from the ranges of the other threads. A chunk
+ * is a quarter of what remains of the range, but never less than the grain size, so the
+ * chunks start large and shrink as the ranges run out, which balances uneven work
+ * without paying for many small claims.
+ *
+ * The workers sleep between loops, so there is no thread start-up per loop. Loops
+ * started from inside a loop run sequentially on the calling thread, and loops from
+ * different threads take turns.
+ *
+ * A pool built from a `NumaTopology` has `threads(node)` threads per node, numbered node
+ * by node with the calling thread first on node 0. The workers are pinned to the CPUs of
+ * their node and steal from the threads of their own node before going to the other
+ * nodes, so chunks stay on the node whose memory they were placed in, see `firstTouch`.
+ */
+class ThreadPool
+{
+ public:
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	/*!
+	 * @param num_threads The number of threads taking part in a loop, including the
+	 * calling thread.
+	 */
+	explicit ThreadPool(std::size_t num_threads = defaultNumThreads())
+	    : ThreadPool(NumaTopology::fake(1, num_threads))
+	{
+	}
+
+	explicit ThreadPool(NumaTopology const& topology)
+	{
+		for (std::size_t node{}; topology.nodes() > node; ++node) {
+			node_.insert(node_.end(), topology.threads(node), node);
+		}
+
+		std::size_t const n = node_.size();
+		ranges_             = std::vector<Range>(n);
+
+		// Own node first, starting from the participant itself, then the other nodes in
+		// order, each starting from its first participant
+		order_.reserve(n * n);
+		for (std::size_t p{}; n > p; ++p) {
+			for (std::size_t k{}; n > k; ++k) {
+				if (node_[p] == node_[(p + k) % n]) {
+					order_.push_back((p + k) % n);
+				}
+			}
+			for (std::size_t k{}; n > k; ++k) {
+				if (node_[p] != node_[(nodeBegin(p) + k) % n]) {
+					order_.push_back((nodeBegin(p) + k) % n);
+				}
+			}
+		}
+
+		workers_.reserve(n - 1);
+		for (std::size_t i = 1; n > i; ++i) {
+			workers_.emplace_back([this, i, topology] {
+				topology.pin(node_[i]);
+				work(i);
+			});
+		}
+	}
+
+	ThreadPool(ThreadPool const&) = delete;
+
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard lock(mutex_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+		for (auto& w : workers_) {
+			w.join();
+		}
+	}
+
+	/*!
+	 * @brief Pool shared by everyone that does not need a dedicated one, created on
+	 * first use from `NumaTopology::detect`.
+	 */
+	[[nodiscard]] static ThreadPool& global()
+	{
+		static ThreadPool pool(NumaTopology::detect());
+		return pool;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Capacity                                       |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] std::size_t size() const noexcept { return ranges_.size(); }
+
+	[[nodiscard]] std::size_t nodes() const noexcept { return node_.back() + 1; }
+
+	/*!
+	 * @brief The node of `participant`, where participant 0 is the calling thread.
+	 */
+	[[nodiscard]] std::size_t node(std::size_t participant) const
+	{
+		return node_[participant];
+	}
+
+	/*!
+	 * @brief The order in which `participant` visits the ranges of a loop, its own first.
+	 */
+	[[nodiscard]] std::vector<std::size_t> stealOrder(std::size_t participant) const
+	{
+		auto first = order_.begin() + static_cast<std::ptrdiff_t>(participant * size());
+		return {first, first + static_cast<std::ptrdiff_t>(size())};
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Execution                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] ThreadPoolPolicy policy(std::size_t grain = 0) noexcept
+	{
+		return {this, grain};
+	}
+
+	/*!
+	 * @brief Calls `f(i)` for every index `i` in [`first`, `last`) and returns once all
+	 * calls have finished.
+	 *
+	 * If a call throws, the remaining chunks are skipped and the first exception is
+	 * rethrown on the calling thread.
+	 */
+	template <class UnaryFunction>
+	void forEach(std::size_t first, std::size_t last, UnaryFunction f,
+	             std::size_t grain = 0)
+	{
+		if (first >= last) {
+			return;
+		}
+
+		std::size_t const size = last - first;
+		std::size_t const n    = this->size();
+		if (1 == n || inside_ || size <= grain) {
+			for (; last != first; ++first) {
+				f(first);
+			}
+			return;
+		}
+
+		std::lock_guard turn(turn_);
+
+		for (std::size_t p{}; n > p; ++p) {
+			ranges_[p].next.store(first + size * p / n, std::memory_order_relaxed);
+			ranges_[p].last = first + size * (p + 1) / n;
+		}
+
+		grain = 0 == grain ? std::max(std::size_t(1), size / (64 * n)) : grain;
+		std::atomic<bool> failed{};
+		broadcast([this, &f, grain, &failed](std::size_t participant) {
+			try {
+				steal(participant, f, grain, failed);
+			} catch (...) {
+				failed.store(true, std::memory_order_relaxed);
+				throw;
+			}
+		});
+	}
+
+	/*!
+	 * @brief Writes one byte to every page of the `bytes` bytes at `data` from the
+	 * participant that a `forEach` over elements stored there starts on.
+	 *
+	 * The OS places a page on the node of the thread that first writes to it, so calling
+	 * this on freshly allocated memory before anything else writes to it puts each part
+	 * of an array on the node that processes it. Does nothing for single thread pools or
+	 * when called from inside a loop.
+	 */
+	void firstTouch(void* data, std::size_t bytes)
+	{
+		std::size_t const n = size();
+		if (1 == n || inside_ || 0 == bytes) {
+			return;
+		}
+
+		std::lock_guard turn(turn_);
+
+		constexpr std::uintptr_t page = 4096;
+		auto const               addr = reinterpret_cast<std::uintptr_t>(data);
+		broadcast([addr, bytes, n](std::size_t participant) {
+			std::uintptr_t first = addr + bytes * participant / n;
+			std::uintptr_t last  = addr + bytes * (participant + 1) / n;
+			// The page holding the start belongs to whoever has its first byte
+			first = 0 == participant ? first : (first + page - 1) / page * page;
+			for (; last > first; first = (first / page + 1) * page) {
+				*reinterpret_cast<unsigned char volatile*>(first) = 0;
+			}
+		});
+	}
+
+ private:
+	struct alignas(64) Range {
+		std::atomic<std::size_t> next{};
+		std::size_t              last{};
+	};
+
+	template <class Function>
+	struct Job {
+		Function*          f;
+		std::mutex         error_mutex{};
+		std::exception_ptr error{};
+
+		static void run(void* data, std::size_t participant)
+		{
+			auto& job = *static_cast<Job*>(data);
+			try {
+				(*job.f)(participant);
+			} catch (...) {
+				std::lock_guard lock(job.error_mutex);
+				if (!job.error) {
+					job.error = std::current_exception();
+				}
+			}
+		}
+	};
+
+	/*!
+	 * @brief Calls `f(participant)` once on every participant, the caller must hold
+	 * `turn_`. The first exception thrown is rethrown once all calls have returned.
+	 */
+	template <class Function>
+	void broadcast(Function f)
+	{
+		Job<Function> job{&f};
+
+		{
+			std::lock_guard lock(mutex_);
+			run_     = &Job<Function>::run;
+			job_     = &job;
+			pending_ = size() - 1;
+			++generation_;
+		}
+		wake_.notify_all();
+
+		inside_ = true;
+		Job<Function>::run(&job, 0);
+		inside_ = false;
+
+		{
+			std::unique_lock lock(mutex_);
+			done_.wait(lock, [this] { return 0 == pending_; });
+		}
+
+		if (job.error) {
+			std::rethrow_exception(job.error);
+		}
+	}
+
+	/*!
+	 * @brief The first participant on the node of `participant`.
+	 */
+	[[nodiscard]] std::size_t nodeBegin(std::size_t participant) const
+	{
+		return static_cast<std::size_t>(
+		    std::find(node_.begin(), node_.end(), node_[participant]) - node_.begin());
+	}
+
+	[[nodiscard]] static std::size_t defaultNumThreads() noexcept
+	{
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	/*!
+	 * @brief Claims the next chunk of `r`, the returned range is empty once `r` is.
+	 */
+	[[nodiscard]] static std::pair<std::size_t, std::size_t> claim(Range&      r,
+	                                                               std::size_t grain)
+	{
+		std::size_t cur = r.next.load(std::memory_order_relaxed);
+		while (r.last > cur) {
+			std::size_t const end = std::min(r.last, cur + std::max(grain, (r.last - cur) / 4));
+			if (r.next.compare_exchange_weak(cur, end, std::memory_order_relaxed)) {
+				return {cur, end};
+			}
+		}
+		return {cur, cur};
+	}
+
+	template <class UnaryFunction>
+	void steal(std::size_t participant, UnaryFunction& f, std::size_t grain,
+	           std::atomic<bool> const& failed)
+	{
+		std::size_t const  n     = size();
+		std::size_t const* order = order_.data() + participant * n;
+		for (std::size_t k{}; n > k; ++k) {
+			Range& r = ranges_[order[k]];
+			for (auto [first, last] = claim(r, grain); first != last;
+			     std::tie(first, last) = claim(r, grain)) {
+				if (failed.load(std::memory_order_relaxed)) {
+					return;
+				}
+				for (; last != first; ++first) {
+					f(first);
+				}
+			}
+		}
+	}
+
+	void work(std::size_t participant)
+	{
+		inside_ = true;
+
+		std::size_t seen{};
+		for (;;) {
+			void (*run)(void*, std::size_t);
+			void* job;
+			{
+				std::unique_lock lock(mutex_);
+				wake_.wait(lock, [this, seen] { return stop_ || seen != generation_; });
+				if (stop_) {
+					return;
+				}
+				seen = generation_;
+				run  = run_;
+				job  = job_;
+			}
+
+			run(job, participant);
+
+			{
+				std::lock_guard lock(mutex_);
+				if (0 == --pending_) {
+					done_.notify_one();
+				}
+			}
+		}
+	}
+
+ private:
+	std::vector<Range>       ranges_;
+	std::vector<std::thread> workers_;
+	// Node of each participant
+	std::vector<std::size_t> node_;
+	// Steal order of each participant, `size()` entries per participant
+	std::vector<std::size_t> order_;
+
+	// Serializes loops started from different threads
+	std::mutex turn_;
+
+	std::mutex              mutex_;
+	std::condition_variable wake_;
+	std::condition_variable done_;
+	std::size_t             generation_{};
+	std::size_t             pending_{};
+	bool                    stop_{};
+	void (*run_)(void*, std::size_t){};
+	void* job_{};
+
+	// Whether the current thread is running a loop of any pool
+	static inline thread_local bool inside_{};
+};
+
+/*!
+ * @brief Allocator that places new arrays with `ThreadPool::firstTouch`.
+ *
+ * Used for the output of a transform on a NUMA pool, so that every thread writes to and
+ * later reads from memory on its own node, here with `t` a `Transform3f`:
+ *
+ * @code
+ * using Allocator = FirstTouchAllocator<Vec3f>;
+ * std::vector<Vec3f, Allocator> out(n, Allocator(pool));
+ * transform(pool.policy(), t, in.begin(), in.end(), out.begin());
+ * @endcode
+ */
+template <class T>
+class FirstTouchAllocator
+{
+ public:
+	using value_type = T;
+
+	explicit FirstTouchAllocator(ThreadPool& pool) noexcept : pool_(&pool) {}
+
+	template <class U>
+	FirstTouchAllocator(FirstTouchAllocator<U> const& other) noexcept : pool_(other.pool_)
+	{
+	}
+
+	[[nodiscard]] T* allocate(std::size_t n)
+	{
+		T* p = std::allocator<T>{}.allocate(n);
+		pool_->firstTouch(p, n * sizeof(T));
+		return p;
+	}
+
+	void deallocate(T* p, std::size_t n) noexcept { std::allocator<T>{}.deallocate(p, n); }
+
+	[[nodiscard]] ThreadPool& pool() const noexcept { return *pool_; }
+
+	template <class U>
+	friend bool operator==(FirstTouchAllocator const& lhs,
+	                       FirstTouchAllocator<U> const& rhs) noexcept
+	{
+		return &lhs.pool() == &rhs.pool();
+	}
+
+	template <class U>
+	friend bool operator!=(FirstTouchAllocator const& lhs,
+	                       FirstTouchAllocator<U> const& rhs) noexcept
+	{
+		return !(lhs == rhs);
+	}
+
+ private:
+	template <class U>
+	friend class FirstTouchAllocator;
+
+	ThreadPool* pool_;
+};
+}  // namespace ufo
+
+#endif  // UFO_MATH_THREAD_POOL_HPP
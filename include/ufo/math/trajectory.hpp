@@ -0,0 +1,755 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_TRAJECTORY_HPP
+#define UFO_MATH_TRAJECTORY_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/algorithm.hpp>
+#include <ufo/math/chars.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/mapped_file.hpp>
+#include <ufo/math/mat3x3.hpp>
+#include <ufo/math/point_io.hpp>
+#include <ufo/math/quat.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+#include <ufo/math/vec4.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Poses of a sensor over time. `stamps` is empty for formats without timestamps,
+ * such as KITTI, and has one timestamp in seconds per pose otherwise.
+ */
+template <class T = double>
+struct Trajectory {
+	std::vector<double>          stamps;
+	std::vector<Transform<3, T>> poses;
+
+	[[nodiscard]] std::size_t size() const noexcept { return poses.size(); }
+
+	[[nodiscard]] bool empty() const noexcept { return poses.empty(); }
+};
+
+/*!
+ * @brief Summary of a set of non-negative errors.
+ */
+template <class T>
+struct ErrorStats {
+	std::size_t count{};
+	T           rmse{};
+	T           mean{};
+	T           std{};
+	T           min{};
+	T           max{};
+};
+
+/*!
+ * @brief The similarity transform `p -> scale * (transform.rotation * p) +
+ * transform.translation` that best aligns one set of points to another.
+ */
+template <class T>
+struct UmeyamaResult {
+	Transform<3, T> transform{};
+	T               scale{1};
+};
+
+/*!
+ * @brief Absolute trajectory error, the distances between the ground truth positions and
+ * the aligned estimated positions.
+ */
+template <class T>
+struct AteResult {
+	UmeyamaResult<T> alignment{};
+	ErrorStats<T>    error{};
+};
+
+/*!
+ * @brief Relative pose error, the drift of the estimate over a fixed number of poses.
+ * Translations are in the unit of the poses, rotations in radians.
+ */
+template <class T>
+struct RpeResult {
+	ErrorStats<T> translation{};
+	ErrorStats<T> rotation{};
+};
+
+namespace detail
+{
+/**************************************************************************************
+|                                                                                     |
+|                                       Parsing                                       |
+|                                                                                     |
+**************************************************************************************/
+
+// Lines are parsed in blocks of about this many bytes
+inline constexpr std::size_t parse_block_size = std::size_t(1) << 16;
+
+/*!
+ * @brief Parses the lines of `text` that are not blank or comments with `parse(line, v)`,
+ * in blocks of whole lines using `for_each`.
+ *
+ * A block does not throw but remembers its first bad line, so the error reported is that
+ * of the first bad line in the file whatever the execution policy.
+ */
+template <class V, class ForEach, class Parse>
+[[nodiscard]] std::vector<V> parseLines(ForEach for_each, std::string_view text,
+                                        char const* format, Parse parse)
+{
+	std::size_t const blocks = std::clamp<std::size_t>(text.size() / parse_block_size, 1,
+	                                                   reduce_max_blocks);
+
+	// Every block but the first starts after a line ending
+	std::vector<std::size_t> begin(blocks + 1, text.size());
+	begin[0] = 0;
+	for (std::size_t b = 1; blocks > b; ++b) {
+		std::size_t const from = std::max(begin[b - 1], text.size() * b / blocks);
+		std::size_t const nl   = text.find('\n', from);
+		begin[b]               = std::string_view::npos == nl ? text.size() : nl + 1;
+	}
+
+	std::vector<std::vector<V>>   parts(blocks);
+	std::vector<std::size_t>      bad_number(blocks);
+	std::vector<std::string_view> bad_line(blocks);
+	for_each(0, blocks, [&](std::size_t b) {
+		LineReader       lines(text.substr(begin[b], begin[b + 1] - begin[b]));
+		std::string_view line;
+		parts[b].reserve((begin[b + 1] - begin[b]) / 64);
+		while (lines.next(line)) {
+			if (isBlankOrComment(line)) {
+				continue;
+			}
+			if (!parse(line, parts[b].emplace_back())) {
+				bad_number[b] = lines.number();
+				bad_line[b]   = line;
+				return;
+			}
+		}
+	});
+
+	std::size_t size{};
+	for (std::size_t b{}; blocks > b; ++b) {
+		if (0 != bad_number[b]) {
+			auto const before = std::count(
+			    text.begin(), text.begin() + static_cast<std::ptrdiff_t>(begin[b]), '\n');
+			parseError(format, static_cast<std::size_t>(before) + bad_number[b], bad_line[b]);
+		}
+		size += parts[b].size();
+	}
+
+	std::vector<V> values;
+	values.reserve(size);
+	for (auto& part : parts) {
+		values.insert(values.end(), part.begin(), part.end());
+	}
+	return values;
+}
+
+/*!
+ * @brief Reads `timestamp tx ty tz qx qy qz qw`.
+ */
+template <class T>
+[[nodiscard]] bool parseTumLine(std::string_view                    line,
+                                std::pair<double, Transform<3, T>>& pose)
+{
+	char const* first = line.data();
+	char const* last  = line.data() + line.size();
+
+	auto res = std::from_chars(skipSeparators(first, last), last, pose.first);
+	if (std::errc() != res.ec) {
+		return false;
+	}
+
+	std::array<T, 7> v;
+	res = fromCharsSequence(res.ptr, last, 7, [&v](std::size_t i) -> T& { return v[i]; });
+	if (std::errc() != res.ec) {
+		return false;
+	}
+
+	pose.second = Transform<3, T>(normalize(Quat<T>(v[6], v[3], v[4], v[5])),
+	                              Vec<3, T>(v[0], v[1], v[2]));
+	return true;
+}
+
+template <class T, class ForEach>
+[[nodiscard]] Trajectory<T> parseTUM(ForEach for_each, std::string_view text)
+{
+	auto const stamped = parseLines<std::pair<double, Transform<3, T>>>(
+	    for_each, text, "TUM", parseTumLine<T>);
+
+	Trajectory<T> trajectory;
+	trajectory.stamps.reserve(stamped.size());
+	trajectory.poses.reserve(stamped.size());
+	for (auto const& [stamp, pose] : stamped) {
+		trajectory.stamps.push_back(stamp);
+		trajectory.poses.push_back(pose);
+	}
+	return trajectory;
+}
+
+template <class T, class ForEach>
+[[nodiscard]] Trajectory<T> parseKITTI(ForEach for_each, std::string_view text)
+{
+	Trajectory<T> trajectory;
+	trajectory.poses = parseLines<Transform<3, T>>(
+	    for_each, text, "KITTI", [](std::string_view line, Transform<3, T>& pose) {
+		    return std::errc() == fromChars(line.data(), line.data() + line.size(), pose).ec;
+	    });
+	return trajectory;
+}
+
+/*!
+ * @brief Writes `size` lines formatted by `format(first, last, i)`, which returns the end
+ * of what it wrote and writes at most `max_line` characters.
+ */
+template <class Format>
+void writeLines(std::filesystem::path const& path, std::size_t size, std::size_t max_line,
+                Format format)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Cannot open '" + path.string() + "' for writing");
+	}
+
+	std::vector<char> buffer(std::max(std::size_t(1) << 16, 2 * max_line));
+	char*             first = buffer.data();
+	char* const       last  = buffer.data() + buffer.size();
+	for (std::size_t i{}; size > i; ++i) {
+		if (max_line > static_cast<std::size_t>(last - first)) {
+			file.write(buffer.data(), first - buffer.data());
+			first = buffer.data();
+		}
+		first    = format(first, last, i);
+		*first++ = '\n';
+	}
+	file.write(buffer.data(), first - buffer.data());
+
+	if (!file) {
+		throw std::runtime_error("Failed writing '" + path.string() + "'");
+	}
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Evaluation                                     |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+struct ErrorSum {
+	std::size_t count{};
+	T           sum{};
+	T           sum_squared{};
+	T           min = std::numeric_limits<T>::max();
+	T           max{};
+
+	[[nodiscard]] static ErrorSum of(T error) noexcept
+	{
+		return {1, error, error * error, error, error};
+	}
+
+	[[nodiscard]] friend ErrorSum operator+(ErrorSum const& lhs,
+	                                        ErrorSum const& rhs) noexcept
+	{
+		return {lhs.count + rhs.count, lhs.sum + rhs.sum, lhs.sum_squared + rhs.sum_squared,
+		        std::min(lhs.min, rhs.min), std::max(lhs.max, rhs.max)};
+	}
+
+	[[nodiscard]] ErrorStats<T> stats() const noexcept
+	{
+		if (0 == count) {
+			return {};
+		}
+		T const n    = static_cast<T>(count);
+		T const mean = sum / n;
+		return {count, std::sqrt(sum_squared / n), mean,
+		        std::sqrt(std::max(T(0), sum_squared / n - mean * mean)), min, max};
+	}
+};
+
+/*!
+ * @brief Summarizes `error(i)` for `i` in [0, `size`).
+ */
+template <class T, class ForEach, class Error>
+[[nodiscard]] ErrorStats<T> errorStats(ForEach for_each, std::size_t size, Error error)
+{
+	auto const of = [&error](std::size_t i) { return ErrorSum<T>::of(error(i)); };
+	return transformReduceIndices(for_each, size, ErrorSum<T>{}, std::plus<>{}, of).stats();
+}
+
+template <class T>
+struct Moments {
+	Vec<3, T>    source{};
+	Vec<3, T>    target{};
+	Mat<3, 3, T> covariance{T(0)};
+	T            variance{};
+
+	[[nodiscard]] friend Moments operator+(Moments const& lhs, Moments const& rhs) noexcept
+	{
+		return {lhs.source + rhs.source, lhs.target + rhs.target,
+		        lhs.covariance + rhs.covariance, lhs.variance + rhs.variance};
+	}
+};
+
+/*!
+ * @brief Umeyama's least-squares similarity transform mapping `source(i)` onto
+ * `target(i)` for `i` in [0, `size`).
+ *
+ * The SVD of the cross-covariance `C = U D V^T` comes from the eigen decomposition of
+ * `C^T C`. Only the two largest singular vectors are used, completing both bases with
+ * cross products, which gives Umeyama's reflection-free rotation `U S V^T` also for
+ * planar trajectories where the smallest singular value is zero.
+ */
+template <class T, class ForEach, class Source, class Target>
+[[nodiscard]] UmeyamaResult<T> umeyama(ForEach for_each, std::size_t size, Source source,
+                                       Target target, bool with_scale)
+{
+	if (0 == size) {
+		throw std::invalid_argument("Umeyama alignment of no points");
+	}
+
+	T const n = static_cast<T>(size);
+
+	Moments<T> const sums = transformReduceIndices(
+	    for_each, size, Moments<T>{}, std::plus<>{},
+	    [&](std::size_t i) { return Moments<T>{source(i), target(i)}; });
+	Vec<3, T> const mean_source = sums.source / n;
+	Vec<3, T> const mean_target = sums.target / n;
+
+	Moments<T> const m = transformReduceIndices(
+	    for_each, size, Moments<T>{}, std::plus<>{},
+	    [&](std::size_t i) {
+		    Vec<3, T> const s = source(i) - mean_source;
+		    Vec<3, T> const t = target(i) - mean_target;
+		    return Moments<T>{{}, {}, Mat<3, 3, T>(t * s[0], t * s[1], t * s[2]), dot(s, s)};
+	    });
+	Mat<3, 3, T> const c = m.covariance / n;
+
+	Mat<3, 3, T> const v = eigenSymmetric(transpose(c) * c).second;
+
+	// Singular vectors of the two largest singular values, `u = C v / sigma`
+	Vec<3, T> const v1 = v[2];
+	Vec<3, T> const v2 = v[1];
+	Vec<3, T> const cv1 = c * v1;
+	Vec<3, T> const cv2 = c * v2;
+	Vec<3, T> const u1  = T(0) < norm(cv1) ? normalize(cv1) : Vec<3, T>(1, 0, 0);
+	Vec<3, T>       u2  = cv2 - dot(cv2, u1) * u1;
+	if (std::sqrt(std::numeric_limits<T>::epsilon()) * norm(cv1) >= norm(u2)) {
+		// Collinear, the rotation about the line is arbitrary
+		u2 = cross(u1, std::abs(u1[0]) < T(0.9) ? Vec<3, T>(1, 0, 0) : Vec<3, T>(0, 1, 0));
+	}
+	u2 = normalize(u2);
+
+	Vec<3, T> const u3 = cross(u1, u2);
+	Vec<3, T> const v3 = cross(v1, v2);
+
+	// R = u1 v1^T + u2 v2^T + u3 v3^T, column j is u1 v1[j] + u2 v2[j] + u3 v3[j]
+	Mat<3, 3, T> r;
+	for (std::size_t j{}; 3 > j; ++j) {
+		r[j] = u1 * v1[j] + u2 * v2[j] + u3 * v3[j];
+	}
+
+	UmeyamaResult<T> result;
+	if (with_scale && T(0) < m.variance) {
+		// trace(R^T C) / variance of the source
+		T trace{};
+		for (std::size_t j{}; 3 > j; ++j) {
+			trace += dot(r[j], c[j]);
+		}
+		result.scale = trace / (m.variance / n);
+	}
+	result.transform = Transform<3, T>(r, mean_target - result.scale * (r * mean_source));
+	return result;
+}
+
+template <class ForEach, class RandomIt1, class RandomIt2>
+[[nodiscard]] auto ate(ForEach for_each, RandomIt1 first, RandomIt1 last,
+                       RandomIt2 ground_truth, bool with_scale)
+{
+	using T = typename std::iterator_traits<RandomIt1>::value_type::value_type;
+
+	std::size_t const size = static_cast<std::size_t>(std::distance(first, last));
+
+	AteResult<T> result;
+	result.alignment = umeyama<T>(
+	    for_each, size, [first](std::size_t i) { return first[i].translation; },
+	    [ground_truth](std::size_t i) { return ground_truth[i].translation; }, with_scale);
+
+	auto const& a = result.alignment;
+	result.error  = errorStats<T>(for_each, size, [&](std::size_t i) {
+		Vec<3, T> const p = a.scale * (a.transform.rotation * first[i].translation) +
+		                    a.transform.translation;
+		return distance(p, ground_truth[i].translation);
+	});
+	return result;
+}
+
+template <class ForEach, class RandomIt1, class RandomIt2>
+[[nodiscard]] auto rpe(ForEach for_each, RandomIt1 first, RandomIt1 last,
+                       RandomIt2 ground_truth, std::size_t delta)
+{
+	using T = typename std::iterator_traits<RandomIt1>::value_type::value_type;
+
+	if (0 == delta) {
+		throw std::invalid_argument("Relative pose error over a delta of 0 poses");
+	}
+
+	std::size_t const size  = static_cast<std::size_t>(std::distance(first, last));
+	std::size_t const pairs = delta < size ? size - delta : 0;
+
+	using Sums = std::pair<ErrorSum<T>, ErrorSum<T>>;
+
+	auto const sums = transformReduceIndices(
+	    for_each, pairs, Sums{},
+	    [](Sums const& lhs, Sums const& rhs) {
+		    return Sums{lhs.first + rhs.first, lhs.second + rhs.second};
+	    },
+	    [&](std::size_t i) {
+		    auto const& e0 = first[i];
+		    auto const& e1 = first[i + delta];
+		    auto const& g0 = ground_truth[i];
+		    auto const& g1 = ground_truth[i + delta];
+
+		    // The error `inverse(inverse(g0) * g1) * (inverse(e0) * e1)` without forming
+		    // it. Its translation has the length of the difference of the two relative
+		    // translations, and the trace of its rotation `A^T B` is the sum of the
+		    // element-wise product of `A` and `B`.
+		    Mat<3, 3, T> const e0_inv = transpose(e0.rotation);
+		    Mat<3, 3, T> const g0_inv = transpose(g0.rotation);
+		    Mat<3, 3, T> const re     = e0_inv * e1.rotation;
+		    Mat<3, 3, T> const rg     = g0_inv * g1.rotation;
+		    Vec<3, T> const    te     = e0_inv * (e1.translation - e0.translation);
+		    Vec<3, T> const    tg     = g0_inv * (g1.translation - g0.translation);
+
+		    T trace{};
+		    for (std::size_t c{}; 3 > c; ++c) {
+			    trace += dot(re[c], rg[c]);
+		    }
+		    // Clamped against rounding
+		    T const cos_angle = std::clamp((trace - T(1)) / T(2), T(-1), T(1));
+		    return Sums{ErrorSum<T>::of(distance(te, tg)),
+		                ErrorSum<T>::of(std::acos(cos_angle))};
+	    });
+
+	RpeResult<T> result;
+	result.translation = sums.first.stats();
+	result.rotation    = sums.second.stats();
+	return result;
+}
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                         TUM                                         |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Parses a TUM RGB-D trajectory, lines of `timestamp tx ty tz qx qy qz qw`.
+ * Blank lines and lines starting with `#` are ignored, quaternions are normalized.
+ *
+ * @throws std::runtime_error On a line that does not start with eight numbers.
+ */
+template <class T = double>
+[[nodiscard]] Trajectory<T> parseTUM(std::string_view text)
+{
+	return detail::parseTUM<T>(detail::SequentialForEach{}, text);
+}
+
+/*!
+ * @brief Like `parseTUM(text)`, but blocks of lines are parsed using `policy`.
+ */
+template <class T = double, class ExecutionPolicy,
+          std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] Trajectory<T> parseTUM(ExecutionPolicy&& policy, std::string_view text)
+{
+	return detail::parseTUM<T>(detail::PolicyForEach<ExecutionPolicy>{policy}, text);
+}
+
+template <class T = double>
+[[nodiscard]] Trajectory<T> readTUM(std::filesystem::path const& path)
+{
+	MappedFile const file(path);
+	return parseTUM<T>(file.view());
+}
+
+template <class T = double, class ExecutionPolicy,
+          std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] Trajectory<T> readTUM(ExecutionPolicy&&            policy,
+                                    std::filesystem::path const& path)
+{
+	MappedFile const file(path);
+	return parseTUM<T>(std::forward<ExecutionPolicy>(policy), file.view());
+}
+
+/*!
+ * @throws std::invalid_argument If `trajectory` does not have one timestamp per pose.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+template <class T>
+void writeTUM(std::filesystem::path const& path, Trajectory<T> const& trajectory)
+{
+	if (trajectory.stamps.size() != trajectory.poses.size()) {
+		throw std::invalid_argument("TUM trajectories need one timestamp per pose");
+	}
+
+	// Eight numbers in their shortest form
+	constexpr std::size_t max_line = 8 * 32;
+
+	detail::writeLines(path, trajectory.size(), max_line,
+	                   [&trajectory](char* first, char* last, std::size_t i) {
+		                   auto const& pose = trajectory.poses[i];
+		                   Quat<T> const q(pose.rotation);
+
+		                   first    = std::to_chars(first, last, trajectory.stamps[i]).ptr;
+		                   *first++ = ' ';
+		                   first    = toChars(first, last, pose.translation).ptr;
+		                   *first++ = ' ';
+		                   return toChars(first, last, Vec<4, T>(q.x, q.y, q.z, q.w)).ptr;
+	                   });
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        KITTI                                        |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Parses a KITTI odometry trajectory, one pose per line as the 12 elements of the
+ * 3x4 matrix `[R|t]` row by row. Blank lines and lines starting with `#` are ignored.
+ *
+ * @throws std::runtime_error On a line that does not start with twelve numbers.
+ */
+template <class T = double>
+[[nodiscard]] Trajectory<T> parseKITTI(std::string_view text)
+{
+	return detail::parseKITTI<T>(detail::SequentialForEach{}, text);
+}
+
+/*!
+ * @brief Like `parseKITTI(text)`, but blocks of lines are parsed using `policy`.
+ */
+template <class T = double, class ExecutionPolicy,
+          std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] Trajectory<T> parseKITTI(ExecutionPolicy&& policy, std::string_view text)
+{
+	return detail::parseKITTI<T>(detail::PolicyForEach<ExecutionPolicy>{policy}, text);
+}
+
+template <class T = double>
+[[nodiscard]] Trajectory<T> readKITTI(std::filesystem::path const& path)
+{
+	MappedFile const file(path);
+	return parseKITTI<T>(file.view());
+}
+
+template <class T = double, class ExecutionPolicy,
+          std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] Trajectory<T> readKITTI(ExecutionPolicy&&            policy,
+                                      std::filesystem::path const& path)
+{
+	MappedFile const file(path);
+	return parseKITTI<T>(std::forward<ExecutionPolicy>(policy), file.view());
+}
+
+/*!
+ * @brief Writes the poses of `trajectory`, its timestamps are not part of the format.
+ *
+ * @throws std::runtime_error If the file cannot be written.
+ */
+template <class T>
+void writeKITTI(std::filesystem::path const& path, Trajectory<T> const& trajectory)
+{
+	// Twelve numbers in their shortest form
+	constexpr std::size_t max_line = 12 * 32;
+
+	detail::writeLines(path, trajectory.size(), max_line,
+	                   [&trajectory](char* first, char* last, std::size_t i) {
+		                   return toChars(first, last, trajectory.poses[i]).ptr;
+	                   });
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                     Association                                     |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Matches the ascending timestamps `a` and `b`. Every timestamp of `a` is matched
+ * to the closest timestamp of `b` if they differ by at most `max_difference`, with every
+ * timestamp of `b` used at most once.
+ *
+ * @return Pairs of indices into `a` and `b`, both ascending.
+ */
+[[nodiscard]] inline std::vector<std::pair<std::size_t, std::size_t>> associate(
+    std::vector<double> const& a, std::vector<double> const& b, double max_difference)
+{
+	std::vector<std::pair<std::size_t, std::size_t>> matches;
+	std::size_t                                      j{};
+	for (std::size_t i{}; a.size() > i && b.size() > j; ++i) {
+		while (b.size() > j + 1 && std::abs(b[j + 1] - a[i]) <= std::abs(b[j] - a[i])) {
+			++j;
+		}
+		if (std::abs(b[j] - a[i]) > max_difference) {
+			continue;
+		}
+		if (!matches.empty() && matches.back().second == j) {
+			// Keep the closer of the two
+			if (std::abs(b[j] - a[matches.back().first]) <= std::abs(b[j] - a[i])) {
+				continue;
+			}
+			matches.pop_back();
+		}
+		matches.emplace_back(i, j);
+	}
+	return matches;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Evaluation                                     |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Umeyama's least-squares alignment of the points [`first`, `last`) to the points
+ * starting at `target`, a rigid transform or, with `with_scale`, a similarity transform.
+ *
+ * @throws std::invalid_argument If [`first`, `last`) is empty.
+ */
+template <class RandomIt1, class RandomIt2>
+[[nodiscard]] auto umeyama(RandomIt1 first, RandomIt1 last, RandomIt2 target,
+                           bool with_scale = false)
+{
+	using T = typename std::iterator_traits<RandomIt1>::value_type::value_type;
+	return detail::umeyama<T>(
+	    detail::SequentialForEach{}, static_cast<std::size_t>(std::distance(first, last)),
+	    [first](std::size_t i) { return first[i]; },
+	    [target](std::size_t i) { return target[i]; }, with_scale);
+}
+
+template <
+    class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] auto umeyama(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                           RandomIt2 target, bool with_scale = false)
+{
+	using T = typename std::iterator_traits<RandomIt1>::value_type::value_type;
+	return detail::umeyama<T>(
+	    detail::PolicyForEach<ExecutionPolicy>{policy},
+	    static_cast<std::size_t>(std::distance(first, last)),
+	    [first](std::size_t i) { return first[i]; },
+	    [target](std::size_t i) { return target[i]; }, with_scale);
+}
+
+/*!
+ * @brief Absolute trajectory error of the estimated poses [`first`, `last`) against the
+ * associated poses starting at `ground_truth`, after aligning the estimated positions to
+ * the true ones with `umeyama`.
+ *
+ * @throws std::invalid_argument If [`first`, `last`) is empty.
+ */
+template <class RandomIt1, class RandomIt2>
+[[nodiscard]] auto ate(RandomIt1 first, RandomIt1 last, RandomIt2 ground_truth,
+                       bool with_scale = false)
+{
+	return detail::ate(detail::SequentialForEach{}, first, last, ground_truth, with_scale);
+}
+
+template <
+    class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] auto ate(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                       RandomIt2 ground_truth, bool with_scale = false)
+{
+	return detail::ate(detail::PolicyForEach<ExecutionPolicy>{policy}, first, last,
+	                   ground_truth, with_scale);
+}
+
+/*!
+ * @brief Relative pose error of the estimated poses [`first`, `last`) against the
+ * associated poses starting at `ground_truth`, comparing the motion from every pose `i`
+ * to pose `i + delta`. Needs no alignment.
+ *
+ * @throws std::invalid_argument If `delta` is 0.
+ */
+template <class RandomIt1, class RandomIt2>
+[[nodiscard]] auto rpe(RandomIt1 first, RandomIt1 last, RandomIt2 ground_truth,
+                       std::size_t delta = 1)
+{
+	return detail::rpe(detail::SequentialForEach{}, first, last, ground_truth, delta);
+}
+
+template <
+    class ExecutionPolicy, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] auto rpe(ExecutionPolicy&& policy, RandomIt1 first, RandomIt1 last,
+                       RandomIt2 ground_truth, std::size_t delta = 1)
+{
+	return detail::rpe(detail::PolicyForEach<ExecutionPolicy>{policy}, first, last,
+	                   ground_truth, delta);
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_TRAJECTORY_HPP
@@ -43,6 +43,7 @@
 #define UFO_MATH_TRANSFORM_HPP
 
 // UFO
+#include <ufo/math/quat_transform.hpp>
 #include <ufo/math/transform2.hpp>
 #include <ufo/math/transform3.hpp>
 
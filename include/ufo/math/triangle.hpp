@@ -0,0 +1,463 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_TRIANGLE_HPP
+#define UFO_MATH_TRIANGLE_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/aabb.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/packet.hpp>
+#include <ufo/math/ray.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+template <class T = float>
+struct Triangle {
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	Vec3<T> v0{};
+	Vec3<T> v1{};
+	Vec3<T> v2{};
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Triangle() noexcept                = default;
+	constexpr Triangle(Triangle const&) noexcept = default;
+
+	constexpr Triangle(Vec3<T> const& v0, Vec3<T> const& v1, Vec3<T> const& v2) noexcept
+	    : v0(v0), v1(v1), v2(v2)
+	{
+	}
+
+	constexpr Triangle& operator=(Triangle const&) noexcept = default;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Accessors                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] constexpr Vec3<T>& operator[](size_type pos) noexcept
+	{
+		return 0 == pos ? v0 : (1 == pos ? v1 : v2);
+	}
+
+	[[nodiscard]] constexpr Vec3<T> const& operator[](size_type pos) const noexcept
+	{
+		return 0 == pos ? v0 : (1 == pos ? v1 : v2);
+	}
+};
+
+using Trianglef = Triangle<float>;
+using Triangled = Triangle<double>;
+
+template <class T>
+[[nodiscard]] constexpr bool operator==(Triangle<T> const& lhs,
+                                        Triangle<T> const& rhs) noexcept
+{
+	return lhs.v0 == rhs.v0 && lhs.v1 == rhs.v1 && lhs.v2 == rhs.v2;
+}
+
+template <class T>
+[[nodiscard]] constexpr bool operator!=(Triangle<T> const& lhs,
+                                        Triangle<T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, Triangle<T> const& t)
+{
+	return out << "V0: " << t.v0 << ", V1: " << t.v1 << ", V2: " << t.v2;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Functions                                      |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Unit normal, pointing to the side from which the vertices appear
+ * counter-clockwise.
+ */
+template <class T>
+[[nodiscard]] Vec3<T> normal(Triangle<T> const& t)
+{
+	return normalize(cross(t.v1 - t.v0, t.v2 - t.v0));
+}
+
+template <class T>
+[[nodiscard]] T area(Triangle<T> const& t)
+{
+	return norm(cross(t.v1 - t.v0, t.v2 - t.v0)) / T(2);
+}
+
+template <class T>
+[[nodiscard]] constexpr Vec3<T> centroid(Triangle<T> const& t) noexcept
+{
+	return (t.v0 + t.v1 + t.v2) / T(3);
+}
+
+template <class T>
+[[nodiscard]] constexpr AABB<3, T> bounds(Triangle<T> const& t) noexcept
+{
+	return AABB<3, T>(min(min(t.v0, t.v1), t.v2), max(max(t.v0, t.v1), t.v2));
+}
+
+/*!
+ * @brief Point on `t` closest to `p` (Ericson, "Real-Time Collision Detection" 5.1.5).
+ */
+template <class T>
+[[nodiscard]] constexpr Vec3<T> closestPoint(Triangle<T> const& t, Vec3<T> const& p)
+{
+	Vec3<T> ab = t.v1 - t.v0;
+	Vec3<T> ac = t.v2 - t.v0;
+	Vec3<T> ap = p - t.v0;
+
+	T d1 = dot(ab, ap);
+	T d2 = dot(ac, ap);
+	if (T(0) >= d1 && T(0) >= d2) {
+		return t.v0;
+	}
+
+	Vec3<T> bp = p - t.v1;
+	T       d3 = dot(ab, bp);
+	T       d4 = dot(ac, bp);
+	if (T(0) <= d3 && d4 <= d3) {
+		return t.v1;
+	}
+
+	T vc = d1 * d4 - d3 * d2;
+	if (T(0) >= vc && T(0) <= d1 && T(0) >= d3) {
+		return t.v0 + ab * (d1 / (d1 - d3));
+	}
+
+	Vec3<T> cp = p - t.v2;
+	T       d5 = dot(ab, cp);
+	T       d6 = dot(ac, cp);
+	if (T(0) <= d6 && d5 <= d6) {
+		return t.v2;
+	}
+
+	T vb = d5 * d2 - d1 * d6;
+	if (T(0) >= vb && T(0) <= d2 && T(0) >= d6) {
+		return t.v0 + ac * (d2 / (d2 - d6));
+	}
+
+	T va = d3 * d6 - d5 * d4;
+	if (T(0) >= va && T(0) <= d4 - d3 && T(0) <= d5 - d6) {
+		return t.v1 + (t.v2 - t.v1) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+	}
+
+	T denom = T(1) / (va + vb + vc);
+	return t.v0 + ab * (vb * denom) + ac * (vc * denom);
+}
+
+template <class T>
+[[nodiscard]] Triangle<T> transform(Transform<3, T> const& tf, Triangle<T> const& t)
+{
+	return Triangle<T>(tf * t.v0, tf * t.v1, tf * t.v2);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                    Intersection                                     |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief `N` triangles in structure-of-arrays layout, stored as the first vertex and the
+ * two edges leaving it, which is what the intersection test needs.
+ *
+ * Unused lanes should be left degenerate (the default), they are never hit.
+ */
+template <class T = float, std::size_t N = packet_size_v<T>>
+struct TrianglePacket {
+	static constexpr std::size_t size = N;
+
+	alignas(N * sizeof(T)) std::array<T, N> x{};
+	alignas(N * sizeof(T)) std::array<T, N> y{};
+	alignas(N * sizeof(T)) std::array<T, N> z{};
+	alignas(N * sizeof(T)) std::array<T, N> e1x{};
+	alignas(N * sizeof(T)) std::array<T, N> e1y{};
+	alignas(N * sizeof(T)) std::array<T, N> e1z{};
+	alignas(N * sizeof(T)) std::array<T, N> e2x{};
+	alignas(N * sizeof(T)) std::array<T, N> e2y{};
+	alignas(N * sizeof(T)) std::array<T, N> e2z{};
+	std::array<std::size_t, N> index{};
+
+	constexpr void set(std::size_t lane, Triangle<T> const& t,
+	                   std::size_t i = std::numeric_limits<std::size_t>::max()) noexcept
+	{
+		Vec3<T> e1 = t.v1 - t.v0;
+		Vec3<T> e2 = t.v2 - t.v0;
+		x[lane]    = t.v0.x;
+		y[lane]    = t.v0.y;
+		z[lane]    = t.v0.z;
+		e1x[lane]  = e1.x;
+		e1y[lane]  = e1.y;
+		e1z[lane]  = e1.z;
+		e2x[lane]  = e2.x;
+		e2y[lane]  = e2.y;
+		e2z[lane]  = e2.z;
+		index[lane] = i;
+	}
+};
+
+namespace detail
+{
+/*!
+ * @brief Möller–Trumbore for a single ray and triangle (given by `v0` and its edges).
+ *
+ * Returns `t` if the ray hits the triangle in (`t_min`, `t_max`) and infinity otherwise.
+ * Written without branches so that it vectorizes when called in a loop over lanes.
+ */
+template <class T>
+[[nodiscard]] constexpr T mollerTrumbore(Vec3<T> const& o, Vec3<T> const& d,
+                                         Vec3<T> const& v0, Vec3<T> const& e1,
+                                         Vec3<T> const& e2, T t_min, T t_max, T& u,
+                                         T& v) noexcept
+{
+	Vec3<T> p   = cross(d, e2);
+	T       det = dot(e1, p);
+	// Degenerate triangles and rays parallel to the triangle give det = 0 and inv = inf,
+	// which makes the comparisons below fail
+	T       inv = T(1) / det;
+	Vec3<T> s   = o - v0;
+	Vec3<T> q   = cross(s, e1);
+
+	u   = dot(s, p) * inv;
+	v   = dot(d, q) * inv;
+	T t = dot(e2, q) * inv;
+
+	// Bitwise and to keep the test free of branches
+	bool hit = (T(0) <= u) & (T(0) <= v) & (T(1) >= u + v) & (t_min < t) & (t_max > t);
+	return hit ? t : std::numeric_limits<T>::infinity();
+}
+}  // namespace detail
+
+/*!
+ * @brief Intersects `ray` with `tri`, reporting hits with distance in (`t_min`, `t_max`).
+ */
+template <class T>
+[[nodiscard]] constexpr RayHit<T> intersect(
+    Ray<T> const& ray, Triangle<T> const& tri, T t_min = T(0),
+    T t_max = std::numeric_limits<T>::infinity()) noexcept
+{
+	RayHit<T> hit;
+	hit.distance = detail::mollerTrumbore(ray.origin, ray.direction, tri.v0,
+	                                      tri.v1 - tri.v0, tri.v2 - tri.v0, t_min, t_max,
+	                                      hit.u, hit.v);
+	if (!hit) {
+		hit.u = hit.v = T(0);
+	}
+	return hit;
+}
+
+/*!
+ * @brief Intersects the `N` rays of `rays` with `tri`, updating the lanes of `hits` where
+ * `tri` is closer than the current hit.
+ *
+ * Call it for every candidate triangle to find the closest hits.
+ *
+ * @return Whether any lane was updated.
+ */
+template <class T, std::size_t N>
+bool intersect(RayPacket<T, N> const& rays, Triangle<T> const& tri,
+               RayHitPacket<T, N>& hits,
+               std::size_t index = std::numeric_limits<std::size_t>::max(),
+               T           t_min = T(0)) noexcept
+{
+	Vec3<T> const e1 = tri.v1 - tri.v0;
+	Vec3<T> const e2 = tri.v2 - tri.v0;
+
+	std::array<T, N> ts, us, vs;
+	for (std::size_t i{}; N > i; ++i) {
+		ts[i] = detail::mollerTrumbore(Vec3<T>(rays.ox[i], rays.oy[i], rays.oz[i]),
+		                               Vec3<T>(rays.dx[i], rays.dy[i], rays.dz[i]), tri.v0,
+		                               e1, e2, t_min, hits.distance[i], us[i], vs[i]);
+	}
+
+	bool any = false;
+	for (std::size_t i{}; N > i; ++i) {
+		bool closer   = hits.distance[i] > ts[i];
+		any           = any || closer;
+		hits.index[i] = closer ? index : hits.index[i];
+	}
+	for (std::size_t i{}; N > i; ++i) {
+		bool closer      = hits.distance[i] > ts[i];
+		hits.u[i]        = closer ? us[i] : hits.u[i];
+		hits.v[i]        = closer ? vs[i] : hits.v[i];
+		hits.distance[i] = closer ? ts[i] : hits.distance[i];
+	}
+	return any;
+}
+
+/*!
+ * @brief Intersects `ray` with the `N` triangles of `tris`, updating `hit` if one of them
+ * is closer.
+ *
+ * @return Whether `hit` was updated.
+ */
+template <class T, std::size_t N>
+bool intersect(Ray<T> const& ray, TrianglePacket<T, N> const& tris, RayHit<T>& hit,
+               T t_min = T(0)) noexcept
+{
+	std::array<T, N> ts, us, vs;
+	for (std::size_t i{}; N > i; ++i) {
+		ts[i] = detail::mollerTrumbore(ray.origin, ray.direction,
+		                               Vec3<T>(tris.x[i], tris.y[i], tris.z[i]),
+		                               Vec3<T>(tris.e1x[i], tris.e1y[i], tris.e1z[i]),
+		                               Vec3<T>(tris.e2x[i], tris.e2y[i], tris.e2z[i]), t_min,
+		                               hit.distance, us[i], vs[i]);
+	}
+
+	std::size_t best = N;
+	for (std::size_t i{}; N > i; ++i) {
+		if (hit.distance > ts[i]) {
+			hit.distance = ts[i];
+			best         = i;
+		}
+	}
+
+	if (N == best) {
+		return false;
+	}
+
+	hit.u     = us[best];
+	hit.v     = vs[best];
+	hit.index = tris.index[best];
+	return true;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Batch                                        |
+|                                                                                     |
+**************************************************************************************/
+
+namespace detail
+{
+template <class T, std::size_t N, class RandomIt1, class RandomIt2, class RandomIt3>
+void intersectBlock(RandomIt1 ray_first, std::size_t count, RandomIt2 tri_first,
+                    RandomIt2 tri_last, RandomIt3 d_first, T t_min)
+{
+	RayPacket<T, N> rays{};
+	for (std::size_t i{}; count > i; ++i) {
+		rays.set(i, ray_first[i]);
+	}
+
+	RayHitPacket<T, N> hits;
+	for (std::size_t j{}; tri_last != tri_first; ++tri_first, ++j) {
+		intersect(rays, *tri_first, hits, j, t_min);
+	}
+
+	for (std::size_t i{}; count > i; ++i) {
+		d_first[i] = hits.get(i);
+	}
+}
+}  // namespace detail
+
+/*!
+ * @brief Finds the closest of the triangles in [`tri_first`, `tri_last`) hit by each of the
+ * rays in [`ray_first`, `ray_last`), testing a packet of rays at a time, and writes
+ * the `RayHit`s to `d_first`.
+ *
+ * Tests every ray against every triangle, use a `BVH` for larger meshes.
+ */
+template <class RandomIt1, class RandomIt2, class RandomIt3,
+          class T = typename std::iterator_traits<RandomIt1>::value_type::value_type>
+RandomIt3 intersect(RandomIt1 ray_first, RandomIt1 ray_last, RandomIt2 tri_first,
+                    RandomIt2 tri_last, RandomIt3 d_first, T t_min = T(0))
+{
+	constexpr std::size_t N = packet_size_v<T>;
+
+	std::size_t const size = std::distance(ray_first, ray_last);
+	for (std::size_t i{}; size > i; i += N) {
+		detail::intersectBlock<T, N>(ray_first + i, std::min(N, size - i), tri_first,
+		                             tri_last, d_first + i, t_min);
+	}
+	return d_first + size;
+}
+
+template <
+    class ExecutionPolicy, class RandomIt1, class RandomIt2, class RandomIt3,
+    class T = typename std::iterator_traits<RandomIt1>::value_type::value_type,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt3 intersect(ExecutionPolicy&& policy, RandomIt1 ray_first, RandomIt1 ray_last,
+                    RandomIt2 tri_first, RandomIt2 tri_last, RandomIt3 d_first,
+                    T t_min = T(0))
+{
+	constexpr std::size_t N = packet_size_v<T>;
+
+	std::size_t const size   = std::distance(ray_first, ray_last);
+	std::size_t const blocks = (size + N - 1) / N;
+	detail::forEach(std::forward<ExecutionPolicy>(policy), 0, blocks, [&](std::size_t b) {
+		std::size_t const i = b * N;
+		detail::intersectBlock<T, N>(ray_first + i, std::min(N, size - i), tri_first,
+		                             tri_last, d_first + i, t_min);
+	});
+	return d_first + size;
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_TRIANGLE_HPP
@@ -47,5 +47,6 @@
 #include <ufo/math/vec2.hpp>
 #include <ufo/math/vec3.hpp>
 #include <ufo/math/vec4.hpp>
+#include <ufo/math/vecn.hpp>
 
 #endif  // UFO_MATH_VEC_HPP
\ No newline at end of file
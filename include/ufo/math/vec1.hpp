@@ -125,6 +125,10 @@ struct Vec<1, T> {
 		return x;
 	}
 
+	[[nodiscard]] constexpr T* data() noexcept { return &x; }
+
+	[[nodiscard]] constexpr T const* data() const noexcept { return &x; }
+
 	/**************************************************************************************
 	|                                                                                     |
 	|                              Unary arithmetic operator                              |
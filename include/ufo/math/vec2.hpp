@@ -154,6 +154,10 @@ struct Vec<2, T> {
 		return (&x)[pos];
 	}
 
+	[[nodiscard]] constexpr T* data() noexcept { return &x; }
+
+	[[nodiscard]] constexpr T const* data() const noexcept { return &x; }
+
 	/**************************************************************************************
 	|                                                                                     |
 	|                              Unary arithmetic operator                              |
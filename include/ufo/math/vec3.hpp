@@ -201,6 +201,10 @@ struct Vec<3, T> {
 		return (&x)[pos];
 	}
 
+	[[nodiscard]] constexpr T* data() noexcept { return &x; }
+
+	[[nodiscard]] constexpr T const* data() const noexcept { return &x; }
+
 	/**************************************************************************************
 	|                                                                                     |
 	|                              Unary arithmetic operator                              |
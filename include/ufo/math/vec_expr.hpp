@@ -0,0 +1,363 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_VEC_EXPR_HPP
+#define UFO_MATH_VEC_EXPR_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+
+// STL
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+template <class E>
+class VecExpr;
+
+namespace detail
+{
+template <class T>
+struct is_vec_expr : std::false_type {
+};
+
+template <class E>
+struct is_vec_expr<VecExpr<E>> : std::true_type {
+};
+
+template <class T>
+inline constexpr bool is_vec_expr_v = is_vec_expr<std::decay_t<T>>::value;
+
+/*!
+ * @brief Leaf over `[first, first + size)`.
+ */
+template <class RandomIt>
+struct ExprRange {
+	RandomIt    first;
+	std::size_t count;
+
+	[[nodiscard]] constexpr decltype(auto) operator[](std::size_t i) const
+	{
+		return first[i];
+	}
+
+	[[nodiscard]] constexpr std::size_t size() const noexcept { return count; }
+};
+
+/*!
+ * @brief Leaf that broadcasts a single value, a scalar or a `Vec`, to every element.
+ */
+template <class V>
+struct ExprValue {
+	V value;
+
+	[[nodiscard]] constexpr V const& operator[](std::size_t) const noexcept
+	{
+		return value;
+	}
+
+	[[nodiscard]] static constexpr std::size_t size() noexcept
+	{
+		return std::numeric_limits<std::size_t>::max();
+	}
+};
+
+template <class Op, class E>
+struct ExprUnary {
+	Op op;
+	E  e;
+
+	[[nodiscard]] constexpr auto operator[](std::size_t i) const { return op(e[i]); }
+
+	[[nodiscard]] constexpr std::size_t size() const noexcept { return e.size(); }
+};
+
+template <class Op, class L, class R>
+struct ExprBinary {
+	Op op;
+	L  l;
+	R  r;
+
+	constexpr ExprBinary(Op op, L l, R r) : op(op), l(std::move(l)), r(std::move(r))
+	{
+		assert(this->l.size() == this->r.size() ||
+		       std::numeric_limits<std::size_t>::max() == this->l.size() ||
+		       std::numeric_limits<std::size_t>::max() == this->r.size());
+	}
+
+	[[nodiscard]] constexpr auto operator[](std::size_t i) const { return op(l[i], r[i]); }
+
+	[[nodiscard]] constexpr std::size_t size() const noexcept
+	{
+		return std::min(l.size(), r.size());
+	}
+};
+
+template <class Op, class L, class R>
+[[nodiscard]] constexpr auto makeExpr(Op op, VecExpr<L> const& lhs, VecExpr<R> const& rhs)
+{
+	return VecExpr<ExprBinary<Op, L, R>>({op, lhs.expr(), rhs.expr()});
+}
+
+template <class Op, class L, class U>
+[[nodiscard]] constexpr auto makeExpr(Op op, VecExpr<L> const& lhs, U const& rhs)
+{
+	return VecExpr<ExprBinary<Op, L, ExprValue<U>>>({op, lhs.expr(), {rhs}});
+}
+
+template <class Op, class U, class R>
+[[nodiscard]] constexpr auto makeExpr(Op op, U const& lhs, VecExpr<R> const& rhs)
+{
+	return VecExpr<ExprBinary<Op, ExprValue<U>, R>>({op, {lhs}, rhs.expr()});
+}
+}  // namespace detail
+
+/*!
+ * @brief Lazily evaluated element-wise expression over ranges of `Vec`s (or anything
+ * else with arithmetic operators).
+ *
+ * Nothing is computed when the expression is built, only when it is passed to
+ * `evaluate`, which runs a single loop computing `expr[i]` for every element. A chain
+ * like `a + (b - a) * t` over three ranges therefore reads each input once and writes
+ * the output once, with no intermediate ranges. The ranges must outlive the
+ * expression.
+ *
+ * This is opt-in: the operators below only apply to `VecExpr`, which is created with
+ * `lazy`, so arithmetic on plain `Vec`s is unaffected.
+ */
+template <class E>
+class VecExpr
+{
+ public:
+	using value_type = std::decay_t<decltype(std::declval<E const&>()[std::size_t{}])>;
+	using size_type  = std::size_t;
+
+	constexpr explicit VecExpr(E e) : e_(std::move(e)) {}
+
+	[[nodiscard]] constexpr value_type operator[](size_type i) const { return e_[i]; }
+
+	[[nodiscard]] constexpr size_type size() const noexcept { return e_.size(); }
+
+	[[nodiscard]] constexpr E const& expr() const noexcept { return e_; }
+
+ private:
+	E e_;
+};
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Leaves                                        |
+|                                                                                     |
+**************************************************************************************/
+
+template <class RandomIt>
+[[nodiscard]] constexpr VecExpr<detail::ExprRange<RandomIt>> lazy(RandomIt first,
+                                                                  RandomIt last)
+{
+	return VecExpr<detail::ExprRange<RandomIt>>(
+	    {first, static_cast<std::size_t>(std::distance(first, last))});
+}
+
+template <class Range>
+[[nodiscard]] constexpr auto lazy(Range const& range)
+{
+	using std::begin;
+	using std::end;
+	return lazy(begin(range), end(range));
+}
+
+/*!
+ * @brief Applies `f` to every element of `e`, e.g. `map(lazy(v), normalize<3, float>)`.
+ */
+template <class E, class UnaryOp>
+[[nodiscard]] constexpr VecExpr<detail::ExprUnary<UnaryOp, E>> map(VecExpr<E> const& e,
+                                                                   UnaryOp           f)
+{
+	return VecExpr<detail::ExprUnary<UnaryOp, E>>({f, e.expr()});
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Operators                                      |
+|                                                                                     |
+**************************************************************************************/
+
+template <class E>
+[[nodiscard]] constexpr auto operator-(VecExpr<E> const& e)
+{
+	return map(e, std::negate<>{});
+}
+
+template <class L, class R>
+[[nodiscard]] constexpr auto operator+(VecExpr<L> const& lhs, VecExpr<R> const& rhs)
+{
+	return detail::makeExpr(std::plus<>{}, lhs, rhs);
+}
+
+template <class L, class U, std::enable_if_t<!detail::is_vec_expr_v<U>, bool> = true>
+[[nodiscard]] constexpr auto operator+(VecExpr<L> const& lhs, U const& rhs)
+{
+	return detail::makeExpr(std::plus<>{}, lhs, rhs);
+}
+
+template <class U, class R, std::enable_if_t<!detail::is_vec_expr_v<U>, bool> = true>
+[[nodiscard]] constexpr auto operator+(U const& lhs, VecExpr<R> const& rhs)
+{
+	return detail::makeExpr(std::plus<>{}, lhs, rhs);
+}
+
+template <class L, class R>
+[[nodiscard]] constexpr auto operator-(VecExpr<L> const& lhs, VecExpr<R> const& rhs)
+{
+	return detail::makeExpr(std::minus<>{}, lhs, rhs);
+}
+
+template <class L, class U, std::enable_if_t<!detail::is_vec_expr_v<U>, bool> = true>
+[[nodiscard]] constexpr auto operator-(VecExpr<L> const& lhs, U const& rhs)
+{
+	return detail::makeExpr(std::minus<>{}, lhs, rhs);
+}
+
+template <class U, class R, std::enable_if_t<!detail::is_vec_expr_v<U>, bool> = true>
+[[nodiscard]] constexpr auto operator-(U const& lhs, VecExpr<R> const& rhs)
+{
+	return detail::makeExpr(std::minus<>{}, lhs, rhs);
+}
+
+template <class L, class R>
+[[nodiscard]] constexpr auto operator*(VecExpr<L> const& lhs, VecExpr<R> const& rhs)
+{
+	return detail::makeExpr(std::multiplies<>{}, lhs, rhs);
+}
+
+template <class L, class U, std::enable_if_t<!detail::is_vec_expr_v<U>, bool> = true>
+[[nodiscard]] constexpr auto operator*(VecExpr<L> const& lhs, U const& rhs)
+{
+	return detail::makeExpr(std::multiplies<>{}, lhs, rhs);
+}
+
+template <class U, class R, std::enable_if_t<!detail::is_vec_expr_v<U>, bool> = true>
+[[nodiscard]] constexpr auto operator*(U const& lhs, VecExpr<R> const& rhs)
+{
+	return detail::makeExpr(std::multiplies<>{}, lhs, rhs);
+}
+
+template <class L, class R>
+[[nodiscard]] constexpr auto operator/(VecExpr<L> const& lhs, VecExpr<R> const& rhs)
+{
+	return detail::makeExpr(std::divides<>{}, lhs, rhs);
+}
+
+template <class L, class U, std::enable_if_t<!detail::is_vec_expr_v<U>, bool> = true>
+[[nodiscard]] constexpr auto operator/(VecExpr<L> const& lhs, U const& rhs)
+{
+	return detail::makeExpr(std::divides<>{}, lhs, rhs);
+}
+
+template <class U, class R, std::enable_if_t<!detail::is_vec_expr_v<U>, bool> = true>
+[[nodiscard]] constexpr auto operator/(U const& lhs, VecExpr<R> const& rhs)
+{
+	return detail::makeExpr(std::divides<>{}, lhs, rhs);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                     Evaluation                                      |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Writes `e[i]` to `d_first[i]` for every element in a single loop.
+ *
+ * Element `i` only reads element `i` of the inputs, so `d_first` may be the beginning of
+ * one of them.
+ */
+template <class E, class RandomIt>
+RandomIt evaluate(VecExpr<E> const& e, RandomIt d_first)
+{
+	std::size_t const size = e.size();
+	for (std::size_t i{}; size > i; ++i) {
+		d_first[i] = e[i];
+	}
+	return d_first + size;
+}
+
+template <class E>
+[[nodiscard]] std::vector<typename VecExpr<E>::value_type> evaluate(VecExpr<E> const& e)
+{
+	std::vector<typename VecExpr<E>::value_type> res(e.size());
+	evaluate(e, res.begin());
+	return res;
+}
+
+template <
+    class ExecutionPolicy, class E, class RandomIt,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt evaluate(ExecutionPolicy&& policy, VecExpr<E> const& e, RandomIt d_first)
+{
+	std::size_t const size = e.size();
+	detail::forEach(std::forward<ExecutionPolicy>(policy), 0, size,
+	                [&e, d_first](std::size_t i) { d_first[i] = e[i]; });
+	return d_first + size;
+}
+
+template <
+    class ExecutionPolicy, class E,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+[[nodiscard]] std::vector<typename VecExpr<E>::value_type> evaluate(
+    ExecutionPolicy&& policy, VecExpr<E> const& e)
+{
+	std::vector<typename VecExpr<E>::value_type> res(e.size());
+	evaluate(std::forward<ExecutionPolicy>(policy), e, res.begin());
+	return res;
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_VEC_EXPR_HPP
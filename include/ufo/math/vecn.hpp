@@ -0,0 +1,366 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_VECN_HPP
+#define UFO_MATH_VECN_HPP
+
+// UFO
+#include <ufo/math/detail/vec.hpp>
+#include <ufo/math/detail/vec_fun.hpp>
+
+// STL
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief Vector of any compile-time size above 4, the sizes 1 to 4 are specialized with
+ * named components.
+ *
+ * The elements live in a `std::array` on the stack and every loop runs over a
+ * compile-time bound, so the compiler can unroll them.
+ */
+template <std::size_t Dim, class T>
+struct Vec {
+	static_assert(4 < Dim, "Vec is specialized for the sizes 1 to 4");
+
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Vec() noexcept           = default;
+	constexpr Vec(Vec const&) noexcept = default;
+
+	constexpr explicit Vec(T value) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] = value;
+		}
+	}
+
+	template <class... Args,
+	          std::enable_if_t<Dim == sizeof...(Args) &&
+	                               (std::is_convertible_v<Args, T> && ...),
+	                           bool> = true>
+	constexpr Vec(Args... args) noexcept : value_{static_cast<T>(args)...}
+	{
+	}
+
+	template <class U>
+	constexpr explicit Vec(Vec<Dim, U> const& v) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] = static_cast<T>(v[i]);
+		}
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                 Assignment operator                                 |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Vec& operator=(Vec const&) noexcept = default;
+
+	template <class U>
+	constexpr Vec& operator=(Vec<Dim, U> const& rhs) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] = static_cast<T>(rhs[i]);
+		}
+		return *this;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                   Element access                                    |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] constexpr T& operator[](size_type pos) noexcept
+	{
+		assert(size() > pos);
+		return value_[pos];
+	}
+
+	[[nodiscard]] constexpr T operator[](size_type pos) const noexcept
+	{
+		assert(size() > pos);
+		return value_[pos];
+	}
+
+	[[nodiscard]] constexpr T* data() noexcept { return value_.data(); }
+
+	[[nodiscard]] constexpr T const* data() const noexcept { return value_.data(); }
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                              Unary arithmetic operator                              |
+	|                                                                                     |
+	**************************************************************************************/
+
+	constexpr Vec operator+() const noexcept { return *this; }
+
+	constexpr Vec operator-() const noexcept
+	{
+		Vec res;
+		for (size_type i{}; Dim > i; ++i) {
+			res[i] = -value_[i];
+		}
+		return res;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                            Compound assignment operator                             |
+	|                                                                                     |
+	**************************************************************************************/
+
+	template <class U>
+	constexpr Vec& operator+=(U value) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] += static_cast<T>(value);
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Vec& operator+=(Vec<Dim, U> const& v) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] += static_cast<T>(v[i]);
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Vec& operator-=(U value) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] -= static_cast<T>(value);
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Vec& operator-=(Vec<Dim, U> const& v) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] -= static_cast<T>(v[i]);
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Vec& operator*=(U value) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] *= static_cast<T>(value);
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Vec& operator*=(Vec<Dim, U> const& v) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] *= static_cast<T>(v[i]);
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Vec& operator/=(U value) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] /= static_cast<T>(value);
+		}
+		return *this;
+	}
+
+	template <class U>
+	constexpr Vec& operator/=(Vec<Dim, U> const& v) noexcept
+	{
+		for (size_type i{}; Dim > i; ++i) {
+			value_[i] /= static_cast<T>(v[i]);
+		}
+		return *this;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Capacity                                       |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] static constexpr size_type size() noexcept { return Dim; }
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                     Operations                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	void swap(Vec& other) noexcept { value_.swap(other.value_); }
+
+ private:
+	std::array<T, Dim> value_{};
+};
+
+/**************************************************************************************
+|                                                                                     |
+|                                  Binary operators                                   |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator+(Vec<Dim, T> v, T value) noexcept
+{
+	return v += value;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator+(T value, Vec<Dim, T> v) noexcept
+{
+	return v += value;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator+(Vec<Dim, T> v1,
+                                              Vec<Dim, T> const& v2) noexcept
+{
+	return v1 += v2;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator-(Vec<Dim, T> v, T value) noexcept
+{
+	return v -= value;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator-(T value, Vec<Dim, T> const& v) noexcept
+{
+	return Vec<Dim, T>(value) -= v;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator-(Vec<Dim, T> v1,
+                                              Vec<Dim, T> const& v2) noexcept
+{
+	return v1 -= v2;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator*(Vec<Dim, T> v, T value) noexcept
+{
+	return v *= value;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator*(T value, Vec<Dim, T> v) noexcept
+{
+	return v *= value;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator*(Vec<Dim, T> v1,
+                                              Vec<Dim, T> const& v2) noexcept
+{
+	return v1 *= v2;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator/(Vec<Dim, T> v, T value) noexcept
+{
+	return v /= value;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator/(T value, Vec<Dim, T> const& v) noexcept
+{
+	return Vec<Dim, T>(value) /= v;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr Vec<Dim, T> operator/(Vec<Dim, T> v1,
+                                              Vec<Dim, T> const& v2) noexcept
+{
+	return v1 /= v2;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Compare                                       |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr bool operator==(Vec<Dim, T> const& lhs,
+                                        Vec<Dim, T> const& rhs) noexcept
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		if (lhs[i] != rhs[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T, std::enable_if_t<(4 < Dim), bool> = true>
+[[nodiscard]] constexpr bool operator!=(Vec<Dim, T> const& lhs,
+                                        Vec<Dim, T> const& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_VECN_HPP
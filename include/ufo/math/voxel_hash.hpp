@@ -0,0 +1,549 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the
+ * Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomath
+ * @version 2.0
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024, Daniel Duberg
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2024, Daniel Duberg
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_MATH_VOXEL_HASH_HPP
+#define UFO_MATH_VOXEL_HASH_HPP
+
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/vec3.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace ufo
+{
+/*!
+ * @brief The voxels searched by `VoxelHash::nearest`: the voxel of the query, also its 6
+ * face neighbours, or the full 3x3x3 block.
+ */
+enum class VoxelStencil : std::uint8_t { VOXEL = 1, FACES = 7, CUBE = 27 };
+
+inline std::ostream& operator<<(std::ostream& out, VoxelStencil s)
+{
+	switch (s) {
+		case VoxelStencil::VOXEL: return out << "VOXEL";
+		case VoxelStencil::FACES: return out << "FACES";
+		case VoxelStencil::CUBE: return out << "CUBE";
+	}
+	return out;
+}
+
+namespace detail
+{
+inline void prefetch(void const* p) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_prefetch(static_cast<char const*>(p), _MM_HINT_T0);
+#else
+	(void)p;
+#endif
+}
+
+// The voxel itself, its 6 face neighbours and then the remaining 20
+inline constexpr std::array<std::array<int, 3>, 27> voxel_stencil{{
+    {0, 0, 0},                                                                   //
+    {-1, 0, 0},   {1, 0, 0},   {0, -1, 0},  {0, 1, 0},  {0, 0, -1},  {0, 0, 1},  //
+    {-1, -1, 0},  {-1, 1, 0},  {1, -1, 0},  {1, 1, 0},                           //
+    {-1, 0, -1},  {-1, 0, 1},  {1, 0, -1},  {1, 0, 1},                           //
+    {0, -1, -1},  {0, -1, 1},  {0, 1, -1},  {0, 1, 1},                           //
+    {-1, -1, -1}, {-1, -1, 1}, {-1, 1, -1}, {-1, 1, 1},                          //
+    {1, -1, -1},  {1, -1, 1},  {1, 1, -1},  {1, 1, 1},                           //
+}};
+}  // namespace detail
+
+/*!
+ * @brief Approximate nearest neighbour search over a point cloud that is updated as a
+ * sensor moves.
+ *
+ * Points are bucketed by the voxel `floor(p / voxel_size)` they fall in. The voxels live
+ * in an open addressing (linear probing) hash table and each owns a block of at most
+ * `max_points_per_voxel` points, so the memory stays bounded however dense the input is.
+ * Points arriving in a full voxel are dropped.
+ *
+ * `nearest` only looks at the voxels of a stencil around the query, skipping those that
+ * are farther away than the best point found so far, and is therefore exact only within
+ * one voxel of it. Nothing is allocated by a query.
+ */
+template <class T = float>
+class VoxelHash
+{
+	static_assert(std::is_floating_point_v<T>);
+
+ public:
+	/**************************************************************************************
+	|                                                                                     |
+	|                                        Types                                        |
+	|                                                                                     |
+	**************************************************************************************/
+
+	using value_type = T;
+	using point_type = Vec3<T>;
+	using key_type   = Vec3i;
+	using size_type  = std::size_t;
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                    Constructors                                     |
+	|                                                                                     |
+	**************************************************************************************/
+
+	explicit VoxelHash(T voxel_size = T(1), size_type max_points_per_voxel = 20)
+	    : voxel_size_(voxel_size)
+	    , inv_voxel_size_(T(1) / voxel_size)
+	    , max_points_(max_points_per_voxel)
+	{
+		assert(T(0) < voxel_size);
+		assert(0 < max_points_per_voxel &&
+		       std::numeric_limits<std::uint32_t>::max() > max_points_per_voxel);
+		rehash(64);
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Capacity                                       |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] T voxelSize() const noexcept { return voxel_size_; }
+
+	[[nodiscard]] size_type maxPointsPerVoxel() const noexcept { return max_points_; }
+
+	/*!
+	 * @brief Number of points.
+	 */
+	[[nodiscard]] size_type size() const noexcept { return size_; }
+
+	/*!
+	 * @brief Number of non-empty voxels.
+	 */
+	[[nodiscard]] size_type numVoxels() const noexcept { return voxels_; }
+
+	[[nodiscard]] bool empty() const noexcept { return 0 == size_; }
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                        Keys                                         |
+	|                                                                                     |
+	**************************************************************************************/
+
+	[[nodiscard]] key_type key(point_type const& p) const noexcept
+	{
+		return key_type(static_cast<int>(std::floor(p.x * inv_voxel_size_)),
+		                static_cast<int>(std::floor(p.y * inv_voxel_size_)),
+		                static_cast<int>(std::floor(p.z * inv_voxel_size_)));
+	}
+
+	[[nodiscard]] point_type center(key_type const& key) const noexcept
+	{
+		return point_type((static_cast<T>(key.x) + T(0.5)) * voxel_size_,
+		                  (static_cast<T>(key.y) + T(0.5)) * voxel_size_,
+		                  (static_cast<T>(key.z) + T(0.5)) * voxel_size_);
+	}
+
+	/*!
+	 * @brief Number of points in the voxel `key`.
+	 */
+	[[nodiscard]] size_type count(key_type const& key) const noexcept
+	{
+		size_type const i = find(key);
+		return npos == i ? 0 : slots_[i].count;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                      Modifiers                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	/*!
+	 * @return Whether `p` was added, `false` if its voxel is full.
+	 */
+	bool insert(point_type const& p)
+	{
+		key_type const k = key(p);
+		size_type      i = find(k);
+		if (npos == i) {
+			if (2 * (voxels_ + 1) > slots_.size()) {
+				rehash(2 * slots_.size());
+			}
+			i = home(k);
+			while (!slots_[i].empty()) {
+				i = (i + 1) & mask_;
+			}
+			slots_[i] = Slot{k, allocateBlock(), 0};
+			++voxels_;
+		}
+
+		Slot& s = slots_[i];
+		if (max_points_ == s.count) {
+			return false;
+		}
+		points_[s.block * max_points_ + s.count++] = p;
+		++size_;
+		return true;
+	}
+
+	/*!
+	 * @return The number of points added.
+	 */
+	template <class InputIt>
+	size_type insert(InputIt first, InputIt last)
+	{
+		size_type n{};
+		for (; last != first; ++first) {
+			n += insert(*first) ? 1 : 0;
+		}
+		return n;
+	}
+
+	/*!
+	 * @brief Removes the voxel `key` and its points.
+	 *
+	 * @return Whether the voxel existed.
+	 */
+	bool erase(key_type const& key)
+	{
+		size_type const i = find(key);
+		if (npos == i) {
+			return false;
+		}
+		eraseSlot(i);
+		return true;
+	}
+
+	/*!
+	 * @brief Removes every voxel whose center is farther than `max_distance` from `center`,
+	 * typically the current sensor position.
+	 *
+	 * @return The number of voxels removed.
+	 */
+	size_type eraseFar(point_type const& center, T max_distance)
+	{
+		T const   max_sq = max_distance * max_distance;
+		size_type n{};
+		for (size_type i{}; slots_.size() > i; ++i) {
+			// Erasing shifts a later voxel into `i`, so look at it again
+			while (!slots_[i].empty() &&
+			       max_sq < distanceSquared(this->center(slots_[i].key), center)) {
+				eraseSlot(i);
+				++n;
+			}
+		}
+		return n;
+	}
+
+	void clear()
+	{
+		std::fill(slots_.begin(), slots_.end(), Slot{});
+		points_.clear();
+		free_blocks_.clear();
+		size_   = 0;
+		voxels_ = 0;
+	}
+
+	/**************************************************************************************
+	|                                                                                     |
+	|                                       Queries                                       |
+	|                                                                                     |
+	**************************************************************************************/
+
+	/*!
+	 * @brief Finds the closest point to `query` in the voxels of `stencil` around it.
+	 *
+	 * @return The point and its squared distance, the distance is infinite if the voxels
+	 * are empty.
+	 */
+	[[nodiscard]] std::pair<point_type, T> nearest(
+	    point_type const& query, VoxelStencil stencil = VoxelStencil::CUBE) const noexcept
+	{
+		point_type const v = query * inv_voxel_size_;
+		key_type const   k(static_cast<int>(std::floor(v.x)), static_cast<int>(std::floor(v.y)),
+		                   static_cast<int>(std::floor(v.z)));
+
+		// Squared distance from the query to the lower and upper neighbour along each axis
+		point_type const lo    = (v - point_type(k)) * voxel_size_;
+		point_type const hi    = point_type(voxel_size_) - lo;
+		point_type const lo_sq = lo * lo;
+		point_type const hi_sq = hi * hi;
+
+		point_type best;
+		T          best_sq = std::numeric_limits<T>::infinity();
+		for (std::size_t s{}; static_cast<std::size_t>(stencil) > s; ++s) {
+			auto const& o = detail::voxel_stencil[s];
+
+			T const box_sq = (0 > o[0] ? lo_sq.x : (0 < o[0] ? hi_sq.x : T(0))) +
+			                 (0 > o[1] ? lo_sq.y : (0 < o[1] ? hi_sq.y : T(0))) +
+			                 (0 > o[2] ? lo_sq.z : (0 < o[2] ? hi_sq.z : T(0)));
+			if (best_sq <= box_sq) {
+				continue;
+			}
+
+			size_type const i = find(key_type(k.x + o[0], k.y + o[1], k.z + o[2]));
+			if (npos == i) {
+				continue;
+			}
+
+			point_type const* p = points_.data() + slots_[i].block * max_points_;
+			for (std::uint32_t j{}; slots_[i].count > j; ++j) {
+				T const d = distanceSquared(p[j], query);
+				if (best_sq > d) {
+					best_sq = d;
+					best    = p[j];
+				}
+			}
+		}
+		return {best, best_sq};
+	}
+
+	/*!
+	 * @brief Hints that `query` will be searched soon by fetching the table slot of its
+	 * voxel.
+	 */
+	void prefetchSlot(point_type const& query) const noexcept
+	{
+		detail::prefetch(slots_.data() + home(key(query)));
+	}
+
+	/*!
+	 * @brief Hints that `query` will be searched soon by fetching the points of its voxel.
+	 * Probes the table, so issue `prefetchSlot` some time before.
+	 */
+	void prefetchPoints(point_type const& query) const noexcept
+	{
+		if (size_type const i = find(key(query)); npos != i) {
+			detail::prefetch(points_.data() + slots_[i].block * max_points_);
+		}
+	}
+
+ private:
+	/**************************************************************************************
+	|                                                                                     |
+	|                                     Hash table                                      |
+	|                                                                                     |
+	**************************************************************************************/
+
+	static constexpr size_type     npos        = std::numeric_limits<size_type>::max();
+	static constexpr std::uint32_t empty_block = std::numeric_limits<std::uint32_t>::max();
+
+	struct Slot {
+		key_type      key;
+		std::uint32_t block = empty_block;
+		std::uint32_t count{};
+
+		[[nodiscard]] bool empty() const noexcept { return empty_block == block; }
+	};
+
+	[[nodiscard]] size_type home(key_type const& k) const noexcept
+	{
+		std::uint64_t const h =
+		    (std::uint64_t(static_cast<std::uint32_t>(k.x)) * 73856093u) ^
+		    (std::uint64_t(static_cast<std::uint32_t>(k.y)) * 19349669u) ^
+		    (std::uint64_t(static_cast<std::uint32_t>(k.z)) * 83492791u);
+		return static_cast<size_type>((h * 0x9E3779B97F4A7C15ull) >> shift_);
+	}
+
+	[[nodiscard]] size_type find(key_type const& k) const noexcept
+	{
+		for (size_type i = home(k);; i = (i + 1) & mask_) {
+			Slot const& s = slots_[i];
+			if (s.empty()) {
+				return npos;
+			}
+			if (s.key == k) {
+				return i;
+			}
+		}
+	}
+
+	void rehash(size_type capacity)
+	{
+		std::vector<Slot> old(capacity);
+		old.swap(slots_);
+		mask_  = capacity - 1;
+		shift_ = 64;
+		for (size_type c = capacity; 1 < c; c >>= 1) {
+			--shift_;
+		}
+
+		for (Slot const& s : old) {
+			if (!s.empty()) {
+				size_type i = home(s.key);
+				while (!slots_[i].empty()) {
+					i = (i + 1) & mask_;
+				}
+				slots_[i] = s;
+			}
+		}
+	}
+
+	/*!
+	 * @brief Backward shift deletion, keeps the probe sequences intact without tombstones.
+	 */
+	void eraseSlot(size_type i)
+	{
+		free_blocks_.push_back(slots_[i].block);
+		size_ -= slots_[i].count;
+		--voxels_;
+
+		for (size_type j = (i + 1) & mask_; !slots_[j].empty(); j = (j + 1) & mask_) {
+			size_type const h = home(slots_[j].key);
+			// Stays if its home lies cyclically in (i, j]
+			bool const stays = i < j ? (i < h && h <= j) : (i < h || h <= j);
+			if (!stays) {
+				slots_[i] = slots_[j];
+				i         = j;
+			}
+		}
+		slots_[i] = Slot{};
+	}
+
+	[[nodiscard]] std::uint32_t allocateBlock()
+	{
+		if (!free_blocks_.empty()) {
+			std::uint32_t const b = free_blocks_.back();
+			free_blocks_.pop_back();
+			return b;
+		}
+		size_type const b = points_.size() / max_points_;
+		assert(empty_block > b);
+		points_.resize(points_.size() + max_points_);
+		return static_cast<std::uint32_t>(b);
+	}
+
+ private:
+	T         voxel_size_;
+	T         inv_voxel_size_;
+	size_type max_points_;
+
+	std::vector<Slot>          slots_;
+	size_type                  mask_{};
+	unsigned                   shift_{};
+	std::vector<point_type>    points_;
+	std::vector<std::uint32_t> free_blocks_;
+	size_type                  size_{};
+	size_type                  voxels_{};
+};
+
+namespace detail
+{
+/*!
+ * @brief Searches `size` queries with the table slot fetched `2 * D` and the points `D`
+ * queries ahead.
+ */
+template <class T, class RandomIt1, class RandomIt2>
+void nearestBlock(VoxelHash<T> const& map, RandomIt1 first, std::size_t size,
+                  RandomIt2 d_first, VoxelStencil stencil)
+{
+	constexpr std::size_t D = 8;
+
+	for (std::size_t i{}; std::min(2 * D, size) > i; ++i) {
+		map.prefetchSlot(first[i]);
+	}
+	for (std::size_t i{}; std::min(D, size) > i; ++i) {
+		map.prefetchPoints(first[i]);
+	}
+
+	for (std::size_t i{}; size > i; ++i) {
+		if (size > i + 2 * D) {
+			map.prefetchSlot(first[i + 2 * D]);
+		}
+		if (size > i + D) {
+			map.prefetchPoints(first[i + D]);
+		}
+		d_first[i] = map.nearest(first[i], stencil);
+	}
+}
+
+inline constexpr std::size_t voxel_hash_query_block = 1024;
+}  // namespace detail
+
+/*!
+ * @brief `VoxelHash::nearest` for each query in `[first, last)`, with the table and the
+ * points prefetched ahead of the search.
+ */
+template <class T, class RandomIt1, class RandomIt2>
+RandomIt2 nearest(VoxelHash<T> const& map, RandomIt1 first, RandomIt1 last,
+                  RandomIt2 d_first, VoxelStencil stencil = VoxelStencil::CUBE)
+{
+	std::size_t const size = std::distance(first, last);
+	detail::nearestBlock(map, first, size, d_first, stencil);
+	return d_first + size;
+}
+
+template <
+    class ExecutionPolicy, class T, class RandomIt1, class RandomIt2,
+    std::enable_if_t<detail::is_execution_policy_v<ExecutionPolicy>, bool> = true>
+RandomIt2 nearest(ExecutionPolicy&& policy, VoxelHash<T> const& map, RandomIt1 first,
+                  RandomIt1 last, RandomIt2 d_first,
+                  VoxelStencil stencil = VoxelStencil::CUBE)
+{
+	constexpr std::size_t B = detail::voxel_hash_query_block;
+
+	std::size_t const size   = std::distance(first, last);
+	std::size_t const blocks = (size + B - 1) / B;
+	detail::forEach(std::forward<ExecutionPolicy>(policy), 0, blocks, [&](std::size_t b) {
+		std::size_t const i = b * B;
+		detail::nearestBlock(map, first + i, std::min(B, size - i), d_first + i, stencil);
+	});
+	return d_first + size;
+}
+}  // namespace ufo
+
+#endif  // UFO_MATH_VOXEL_HASH_HPP
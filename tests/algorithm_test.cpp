@@ -0,0 +1,136 @@
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/algorithm.hpp>
+#include <ufo/math/quat.hpp>
+#include <ufo/math/thread_pool.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+std::vector<Vec3f> randomPoints(std::size_t n)
+{
+	std::mt19937                          gen(42);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	std::vector<Vec3f> points;
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(dist(gen), dist(gen), dist(gen));
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[Algorithm] Reductions do not depend on the execution policy")
+{
+	ThreadPool pool(4);
+
+	for (std::size_t n : {1, 7, 1000, 100'003}) {
+		auto const points = randomPoints(n);
+
+		Vec3f const sum = ufo::reduce(points.begin(), points.end(), Vec3f());
+		REQUIRE(sum == ufo::reduce(execution::par, points.begin(), points.end(), Vec3f()));
+		REQUIRE(sum == ufo::reduce(pool.policy(), points.begin(), points.end(), Vec3f()));
+
+		Vec3d expected_sum;
+		for (auto const& p : points) {
+			expected_sum += Vec3d(p);
+		}
+		for (std::size_t i{}; 3 > i; ++i) {
+			REQUIRE(sum[i] == Catch::Approx(expected_sum[i]).epsilon(1e-4).margin(1e-2));
+		}
+
+		Vec3f const c = centroid(points.begin(), points.end());
+		REQUIRE(c == centroid(execution::par, points.begin(), points.end()));
+		for (std::size_t i{}; 3 > i; ++i) {
+			REQUIRE(c[i] == Catch::Approx(sum[i] / static_cast<float>(n)).margin(1e-4));
+		}
+
+		auto const [lo, hi] = ufo::minmax(points.begin(), points.end());
+		REQUIRE(std::make_pair(lo, hi) ==
+		        ufo::minmax(pool.policy(), points.begin(), points.end()));
+		for (std::size_t i{}; 3 > i; ++i) {
+			auto const [mn, mx] = std::minmax_element(
+			    points.begin(), points.end(),
+			    [i](Vec3f const& a, Vec3f const& b) { return a[i] < b[i]; });
+			REQUIRE((*mn)[i] == lo[i]);
+			REQUIRE((*mx)[i] == hi[i]);
+		}
+
+		auto const        above = [](Vec3f const& p) { return 0.0f < p.z; };
+		std::size_t const count = countIf(points.begin(), points.end(), above);
+		REQUIRE(static_cast<std::size_t>(std::count_if(points.begin(), points.end(),
+		                                               above)) == count);
+		REQUIRE(count == countIf(execution::omp::par, points.begin(), points.end(), above));
+
+		auto const  length = [](Vec3f const& p) { return norm(p); };
+		float const norms =
+		    transformReduce(points.begin(), points.end(), 0.0f, std::plus<>{}, length);
+		REQUIRE(norms == transformReduce(pool.policy(), points.begin(), points.end(), 0.0f,
+		                                 std::plus<>{}, length));
+	}
+
+	std::vector<Vec3f> const empty;
+	REQUIRE(Vec3f(1) == ufo::reduce(execution::par, empty.begin(), empty.end(), Vec3f(1)));
+	REQUIRE(0u == countIf(execution::par, empty.begin(), empty.end(),
+	                      [](Vec3f const&) { return true; }));
+}
+
+TEST_CASE("[Algorithm] Non-commutative reduction keeps the order")
+{
+	std::mt19937                          gen(7);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	std::vector<Transform3f> poses;
+	for (std::size_t i{}; 5000 > i; ++i) {
+		Quatf q(1.0f, 0.01f * dist(gen), 0.01f * dist(gen), 0.01f * dist(gen));
+		poses.emplace_back(normalize(q), Vec3f(dist(gen), dist(gen), dist(gen)));
+	}
+
+	Transform3f expected;
+	for (auto const& p : poses) {
+		expected = expected * p;
+	}
+
+	Transform3f const seq =
+	    ufo::reduce(poses.begin(), poses.end(), Transform3f(), std::multiplies<>{});
+	Transform3f const par = ufo::reduce(execution::par, poses.begin(), poses.end(),
+	                                    Transform3f(), std::multiplies<>{});
+	REQUIRE(seq == par);
+
+	Vec3f const p(1, 2, 3);
+	for (std::size_t i{}; 3 > i; ++i) {
+		REQUIRE(seq(p)[i] == Catch::Approx(expected(p)[i]).margin(1e-2));
+	}
+}
+
+TEST_CASE("[Algorithm] Stable partition")
+{
+	ThreadPool pool(3);
+
+	for (std::size_t n : {0, 5, 2048, 100'000}) {
+		auto       points   = randomPoints(n);
+		auto       expected = points;
+		auto const pred     = [](Vec3f const& p) { return p.x < p.y; };
+
+		auto const expected_mid =
+		    std::stable_partition(expected.begin(), expected.end(), pred);
+		auto const mid = ufo::partition(pool.policy(), points.begin(), points.end(), pred);
+
+		REQUIRE(expected_mid - expected.begin() == mid - points.begin());
+		REQUIRE(expected == points);
+	}
+}
@@ -0,0 +1,188 @@
+// UFO
+#include <ufo/math/array_file.hpp>
+#include <ufo/math/transform.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+std::filesystem::path tempFile(char const* name)
+{
+	return std::filesystem::temp_directory_path() / name;
+}
+
+std::vector<Vec3f> points(std::size_t size)
+{
+	std::vector<Vec3f> v;
+	for (std::size_t i{}; size > i; ++i) {
+		float const f = static_cast<float>(i);
+		v.emplace_back(f, 0.5f * f, -f);
+	}
+	return v;
+}
+
+template <class T>
+void patch(std::filesystem::path const& path, std::size_t offset, T value)
+{
+	std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+	file.seekp(static_cast<std::streamoff>(offset));
+	file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+}  // namespace
+
+TEST_CASE("[ArrayFile] AoS Vec3f")
+{
+	auto const path = tempFile("ufomath_array_file_aos.ufoa");
+	auto const v    = points(1'000);
+	writeArray(path, v);
+
+	MappedArray const a(path);
+	REQUIRE(1'000 == a.size());
+	REQUIRE(ArrayKind::VEC == a.header().kind);
+	REQUIRE(ScalarType::FLOAT == a.header().scalar);
+	REQUIRE(ArrayLayout::AOS == a.header().layout);
+	REQUIRE(3 == a.header().rows);
+	REQUIRE(1 == a.header().cols);
+	REQUIRE(a.holds<Vec3f>());
+	REQUIRE_FALSE(a.holds<Vec3d>());
+	REQUIRE_FALSE(a.holds<Vec4f>());
+
+	auto const s = a.span<Vec3f>();
+	REQUIRE(0 == reinterpret_cast<std::uintptr_t>(s.data()) % ArrayHeader::ALIGNMENT);
+	REQUIRE(std::vector<Vec3f>(s.begin(), s.end()) == v);
+	REQUIRE(v == a.read<Vec3f>());
+
+	// Usable directly with the transforms
+	Transform3f const t(Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1), Vec3f(1, 2, 3));
+	REQUIRE(transform(t, v) == transform(t, s));
+
+	REQUIRE_THROWS_AS(a.span<Vec3d>(), std::runtime_error);
+	REQUIRE_THROWS_AS(a.component<float>(0), std::runtime_error);
+
+	// Mutable spans are written as well
+	auto const span_path = tempFile("ufomath_array_file_span.ufoa");
+	auto       w         = points(10);
+	writeArray(span_path, std::span<Vec3f>(w));
+	REQUIRE(w == MappedArray(span_path).read<Vec3f>());
+
+	std::filesystem::remove(span_path);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("[ArrayFile] SoA Vec3f")
+{
+	auto const path = tempFile("ufomath_array_file_soa.ufoa");
+	auto const v    = points(1'001);
+	writeArray(path, v, ArrayLayout::SOA);
+
+	MappedArray const a(path);
+	REQUIRE(ArrayLayout::SOA == a.header().layout);
+	REQUIRE(0 == a.header().stride % ArrayHeader::ALIGNMENT);
+
+	for (std::size_t c{}; 3 > c; ++c) {
+		auto const s = a.component<float>(c);
+		REQUIRE(v.size() == s.size());
+		REQUIRE(0 == reinterpret_cast<std::uintptr_t>(s.data()) % ArrayHeader::ALIGNMENT);
+		for (std::size_t i{}; v.size() > i; ++i) {
+			REQUIRE(v[i][c] == s[i]);
+		}
+	}
+	REQUIRE(v == a.read<Vec3f>());
+
+	REQUIRE_THROWS_AS(a.component<float>(3), std::runtime_error);
+	REQUIRE_THROWS_AS(a.component<double>(0), std::runtime_error);
+	REQUIRE_THROWS_AS(a.span<Vec3f>(), std::runtime_error);
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("[ArrayFile] Transforms and scalars")
+{
+	auto const path = tempFile("ufomath_array_file_transform.ufoa");
+
+	std::vector<Transform3d> poses;
+	for (int i{}; 10 > i; ++i) {
+		poses.emplace_back(Quatd(1.0, 0.0, 0.1 * i, 0.0), Vec3d(i, 2 * i, 3 * i));
+	}
+
+	for (auto layout : {ArrayLayout::AOS, ArrayLayout::SOA}) {
+		writeArray(path, poses, layout);
+		MappedArray const a(path);
+		REQUIRE(ArrayKind::TRANSFORM == a.header().kind);
+		REQUIRE(3 == a.header().rows);
+		REQUIRE(4 == a.header().cols);
+		REQUIRE(poses == a.read<Transform3d>());
+	}
+
+	std::vector<QuatTransform<float>> qt(3, QuatTransform<float>(Quatf(1, 0, 0, 0),
+	                                                             Vec3f(1, 2, 3)));
+	writeArray(path, qt);
+	REQUIRE(qt == MappedArray(path).read<QuatTransform<float>>());
+
+	std::vector<std::uint16_t> const rings{1, 2, 3, 65'535};
+	writeArray(path, rings);
+	REQUIRE(rings == MappedArray(path).read<std::uint16_t>());
+
+	std::vector<Vec3f> const empty;
+	writeArray(path, empty, ArrayLayout::SOA);
+	REQUIRE(MappedArray(path).read<Vec3f>().empty());
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("[ArrayFile] Invalid files")
+{
+	auto const path = tempFile("ufomath_array_file_invalid.ufoa");
+
+	REQUIRE_THROWS_AS(MappedArray(tempFile("ufomath_array_file_missing.ufoa")),
+	                  std::runtime_error);
+
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << "not an array file";
+	}
+	REQUIRE_THROWS_AS(MappedArray(path), std::runtime_error);
+
+	// Truncated data
+	writeArray(path, points(100));
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+	REQUIRE_THROWS_AS(MappedArray(path), std::runtime_error);
+
+	// A size so large that the byte count of the data overflows
+	for (auto layout : {ArrayLayout::AOS, ArrayLayout::SOA}) {
+		writeArray(path, points(100), layout);
+		patch(path, offsetof(ArrayHeader, size), std::uint64_t(1) << 62);
+		REQUIRE_THROWS_AS(MappedArray(path), std::runtime_error);
+	}
+
+	// Elements without components, and an AoS stride of zero with them
+	for (auto layout : {ArrayLayout::AOS, ArrayLayout::SOA}) {
+		writeArray(path, points(100), layout);
+		patch(path, offsetof(ArrayHeader, rows), std::uint32_t(0));
+		REQUIRE_THROWS_AS(MappedArray(path), std::runtime_error);
+	}
+	writeArray(path, points(100));
+	patch(path, offsetof(ArrayHeader, rows), std::uint32_t(0));
+	patch(path, offsetof(ArrayHeader, stride), std::uint64_t(0));
+	REQUIRE_THROWS_AS(MappedArray(path), std::runtime_error);
+
+	// Version 0 was never written
+	writeArray(path, points(100));
+	patch(path, offsetof(ArrayHeader, version), std::uint32_t(0));
+	REQUIRE_THROWS_AS(MappedArray(path), std::runtime_error);
+
+	std::filesystem::remove(path);
+}
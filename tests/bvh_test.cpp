@@ -0,0 +1,174 @@
+// UFO
+#include <ufo/math/bvh.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+std::vector<Trianglef> randomTriangles(std::size_t n)
+{
+	std::mt19937                          gen(21);
+	std::uniform_real_distribution<float> uni(-1.0f, 1.0f);
+
+	std::vector<Trianglef> tris;
+	for (std::size_t i{}; n > i; ++i) {
+		Vec3f c(uni(gen) * 20.0f, uni(gen) * 20.0f, uni(gen) * 20.0f);
+		tris.emplace_back(c + Vec3f(uni(gen), uni(gen), uni(gen)),
+		                  c + Vec3f(uni(gen), uni(gen), uni(gen)),
+		                  c + Vec3f(uni(gen), uni(gen), uni(gen)));
+	}
+	return tris;
+}
+
+std::vector<Rayf> randomRays(std::size_t n)
+{
+	std::mt19937                          gen(22);
+	std::uniform_real_distribution<float> uni(-1.0f, 1.0f);
+
+	std::vector<Rayf> rays;
+	for (std::size_t i{}; n > i; ++i) {
+		rays.emplace_back(Vec3f(uni(gen), uni(gen), uni(gen)) * 30.0f,
+		                  Vec3f(uni(gen), uni(gen), uni(gen)));
+	}
+	return rays;
+}
+}  // namespace
+
+TEST_CASE("[BVH] Build")
+{
+	auto tris = randomTriangles(5'000);
+
+	BVH<Trianglef> bvh(tris.begin(), tris.end());
+	REQUIRE(tris.size() == bvh.size());
+
+	std::size_t leaf_prims{};
+	for (auto const& node : bvh.nodes()) {
+		if (node.isLeaf()) {
+			leaf_prims += node.count;
+			for (std::size_t i = node.offset; node.offset + node.count > i; ++i) {
+				AABB3f b = bounds(bvh.primitives()[i]);
+				REQUIRE(all(lessThanEqual(node.min, b.min)));
+				REQUIRE(all(lessThanEqual(b.max, node.max)));
+				REQUIRE(tris[bvh.indices()[i]] == bvh.primitives()[i]);
+			}
+		}
+	}
+	REQUIRE(tris.size() == leaf_prims);
+
+	BVH<Trianglef> par(execution::par, tris.begin(), tris.end());
+	REQUIRE(bvh.nodes().size() == par.nodes().size());
+	REQUIRE(bvh.indices() == par.indices());
+
+	BVH<Trianglef> none;
+	REQUIRE(none.empty());
+	REQUIRE_FALSE(none.intersect(Rayf()));
+	REQUIRE_FALSE(none.nearest(Vec3f()));
+}
+
+TEST_CASE("[BVH] Ray queries")
+{
+	auto tris = randomTriangles(5'000);
+	auto rays = randomRays(2'000);
+
+	BVH<Trianglef> bvh(execution::par, tris.begin(), tris.end());
+
+	std::vector<RayHit<float>> expected(rays.size());
+	intersect(execution::par, rays.begin(), rays.end(), tris.begin(), tris.end(),
+	          expected.begin());
+
+	std::vector<RayHit<float>> packets(rays.size());
+	intersect(bvh, rays.begin(), rays.end(), packets.begin());
+
+	std::vector<RayHit<float>> par(rays.size());
+	intersect(execution::par, bvh, rays.begin(), rays.end(), par.begin());
+
+	std::size_t hits{};
+	for (std::size_t i{}; rays.size() > i; ++i) {
+		RayHit<float> single = bvh.intersect(rays[i]);
+		REQUIRE(expected[i].index == single.index);
+		REQUIRE(expected[i].index == packets[i].index);
+		REQUIRE(expected[i].index == par[i].index);
+		if (expected[i]) {
+			++hits;
+			REQUIRE(expected[i].distance == Catch::Approx(single.distance));
+			REQUIRE(expected[i].distance == Catch::Approx(packets[i].distance));
+			REQUIRE(expected[i].u == Catch::Approx(single.u).margin(1e-5));
+		}
+	}
+	REQUIRE(0 < hits);
+}
+
+TEST_CASE("[BVH] Closest point")
+{
+	auto tris = randomTriangles(2'000);
+
+	BVH<Trianglef> bvh(tris.begin(), tris.end());
+
+	std::mt19937                          gen(23);
+	std::uniform_real_distribution<float> uni(-25.0f, 25.0f);
+
+	std::vector<Vec3f> queries;
+	for (std::size_t i{}; 500 > i; ++i) {
+		queries.emplace_back(uni(gen), uni(gen), uni(gen));
+	}
+
+	std::vector<NearestHit<float>> res(queries.size());
+	nearest(execution::par, bvh, queries.begin(), queries.end(), res.begin());
+
+	for (std::size_t q{}; queries.size() > q; ++q) {
+		float best = std::numeric_limits<float>::infinity();
+		for (auto const& t : tris) {
+			best = std::min(best, distance(closestPoint(t, queries[q]), queries[q]));
+		}
+		REQUIRE(res[q]);
+		REQUIRE(best == Catch::Approx(res[q].distance));
+		REQUIRE(best == Catch::Approx(distance(closestPoint(tris[res[q].index], queries[q]),
+		                                      queries[q])));
+	}
+
+	REQUIRE_FALSE(bvh.nearest(Vec3f(1000.0f), 1.0f));
+}
+
+TEST_CASE("[BVH] Points and boxes")
+{
+	std::mt19937                          gen(24);
+	std::uniform_real_distribution<float> uni(-10.0f, 10.0f);
+
+	std::vector<Vec3f> points;
+	for (std::size_t i{}; 3'000 > i; ++i) {
+		points.emplace_back(uni(gen), uni(gen), uni(gen));
+	}
+	// Duplicates exercise the coincident centroid fallback
+	points.insert(points.end(), 100, Vec3f(1, 2, 3));
+
+	BVH<Vec3f> pbvh(points.begin(), points.end());
+	for (std::size_t i{}; 100 > i; ++i) {
+		Vec3f       q(uni(gen), uni(gen), uni(gen));
+		std::size_t best{};
+		for (std::size_t j{}; points.size() > j; ++j) {
+			best = distanceSquared(points[j], q) < distanceSquared(points[best], q) ? j : best;
+		}
+		REQUIRE(distance(points[best], q) == Catch::Approx(pbvh.nearest(q).distance));
+	}
+
+	std::vector<AABB3f> boxes;
+	for (auto const& p : points) {
+		boxes.emplace_back(p - Vec3f(0.1f), p + Vec3f(0.1f));
+	}
+	BVH<AABB3f> bbvh(boxes.begin(), boxes.end());
+
+	Rayf          ray(Vec3f(1, 2, -20), Vec3f(0, 0, 1));
+	RayHit<float> hit = bbvh.intersect(ray);
+	REQUIRE(hit);
+	REQUIRE(hit.distance <= 22.9f + 1e-4f);
+	REQUIRE(contains(boxes[hit.index], ray(hit.distance + 1e-4f)));
+}
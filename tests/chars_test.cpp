@@ -0,0 +1,90 @@
+// UFO
+#include <ufo/math/chars.hpp>
+#include <ufo/math/mat.hpp>
+#include <ufo/math/quat.hpp>
+#include <ufo/math/transform.hpp>
+#include <ufo/math/vec.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <array>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+using namespace ufo;
+
+namespace
+{
+template <class T>
+T roundTrip(T const& value)
+{
+	std::string const s = toString(value);
+	T                 res{};
+	auto const        r = fromChars(s.data(), s.data() + s.size(), res);
+	REQUIRE(std::errc() == r.ec);
+	REQUIRE(s.data() + s.size() == r.ptr);
+	return res;
+}
+}  // namespace
+
+TEST_CASE("[Chars] Vec")
+{
+	REQUIRE("1 2.5 -3" == toString(Vec3f(1.0f, 2.5f, -3.0f)));
+	REQUIRE("1 -2" == toString(Vec2i(1, -2)));
+
+	Vec3d const v(0.1, 1.0 / 3.0, -1e-300);
+	REQUIRE(v == roundTrip(v));
+
+	Vec<6, float> const v6(1, 2, 3, 4, 5, 6);
+	REQUIRE(v6 == roundTrip(v6));
+
+	// Spaces, tabs and commas between components
+	std::string const csv = " 1,\t2 ,3 rest";
+	Vec3f             p;
+	auto const        r = fromChars(csv.data(), csv.data() + csv.size(), p);
+	REQUIRE(std::errc() == r.ec);
+	REQUIRE(Vec3f(1, 2, 3) == p);
+	REQUIRE(std::string(" rest") == r.ptr);
+
+	// Errors leave the value alone
+	std::string const bad = "1 2 x";
+	auto const        e   = fromChars(bad.data(), bad.data() + bad.size(), p);
+	REQUIRE(std::errc::invalid_argument == e.ec);
+	REQUIRE(Vec3f(1, 2, 3) == p);
+
+	std::array<char, 4> small;
+	REQUIRE(std::errc::value_too_large ==
+	        toChars(small.data(), small.data() + small.size(), Vec3f(1, 2, 3)).ec);
+}
+
+TEST_CASE("[Chars] Mat, Quat and Transform")
+{
+	Mat<2, 3, float> m;  // 2 columns, 3 rows
+	m[0] = Vec3f(1, 3, 5);
+	m[1] = Vec3f(2, 4, 6);
+	REQUIRE("1 2 3 4 5 6" == toString(m));
+	REQUIRE(m == roundTrip(m));
+
+	Quatd const q(0.5, -0.5, 0.25, 0.125);
+	REQUIRE("0.5 -0.5 0.25 0.125" == toString(q));
+	REQUIRE(q == roundTrip(q));
+
+	// A KITTI pose line
+	Transform3d const t(Mat3d(1, 0, 0, 0, 0, 1, 0, -1, 0), Vec3d(4, 5, 6));
+	REQUIRE("1 0 0 4 0 0 -1 5 0 1 0 6" == toString(t));
+	REQUIRE(t == roundTrip(t));
+}
+
+TEST_CASE("[Chars] Mat stream output")
+{
+	Mat2x2f m;
+	m[0] = Vec2f(1.0f, -10.5f);
+	m[1] = Vec2f(100.0f, 2.0f);
+
+	std::ostringstream ss;
+	ss << m;
+	REQUIRE("    1 100\n-10.5   2" == ss.str());
+}
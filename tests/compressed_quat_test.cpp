@@ -0,0 +1,69 @@
+// UFO
+#include <ufo/math/compressed_quat.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+template <std::size_t Bits>
+void checkRoundTrip(double max_angle_deg)
+{
+	std::mt19937                     gen(11);
+	std::normal_distribution<double> dist;
+
+	std::vector<ufo::Quatd> quats;
+	for (int i{}; 20000 > i; ++i) {
+		quats.push_back(normalize(ufo::Quatd(dist(gen), dist(gen), dist(gen), dist(gen))));
+	}
+	quats.emplace_back(1.0, 0.0, 0.0, 0.0);
+	quats.emplace_back(0.0, 0.0, -1.0, 0.0);
+	quats.push_back(normalize(ufo::Quatd(0.5, -0.5, 0.5, -0.5)));
+
+	std::vector<ufo::CompressedQuat<Bits>> compressed(quats.size());
+	std::vector<ufo::Quatd>                decompressed(quats.size());
+	ufo::compress<Bits>(ufo::execution::par, quats.begin(), quats.end(),
+	                    compressed.begin());
+	ufo::decompress<double>(compressed.begin(), compressed.end(), decompressed.begin());
+
+	double max_angle{};
+	for (std::size_t i{}; quats.size() > i; ++i) {
+		REQUIRE(compressed[i] == ufo::compress<Bits>(quats[i]));
+		REQUIRE(norm(decompressed[i]) == Catch::Approx(1.0));
+
+		// Canonical sign: the dropped (largest) component is never negative
+		auto const& r = decompressed[i];
+		REQUIRE(0.0 <= (&r.w)[compressed[i].largest()]);
+
+		max_angle = std::max(max_angle,
+		                     2.0 * std::acos(std::min(1.0, std::abs(dot(quats[i], r)))));
+	}
+	REQUIRE(ufo::degrees(max_angle) < max_angle_deg);
+}
+
+TEST_CASE("[CompressedQuat] Round trip")
+{
+	SECTION("32 bits") { checkRoundTrip<32>(0.25); }
+	SECTION("48 bits") { checkRoundTrip<48>(0.0076); }
+	SECTION("64 bits") { checkRoundTrip<64>(0.00024); }
+}
+
+TEST_CASE("[CompressedQuat] Rotation is preserved")
+{
+	ufo::Quatf q = ufo::angleAxis(2.5f, normalize(ufo::Vec3f(1.0f, -2.0f, 0.5f)));
+	ufo::Vec3f v(1.0f, 2.0f, 3.0f);
+
+	// -q is the same rotation and must compress identically
+	REQUIRE(ufo::compress<48>(q) == ufo::compress<48>(-q));
+
+	ufo::Vec3f a = q * v;
+	ufo::Vec3f b = ufo::decompress<float>(ufo::compress<48>(q)) * v;
+	REQUIRE(a.x == Catch::Approx(b.x).margin(1e-3));
+	REQUIRE(a.y == Catch::Approx(b.y).margin(1e-3));
+	REQUIRE(a.z == Catch::Approx(b.z).margin(1e-3));
+}
@@ -0,0 +1,120 @@
+// UFO
+#include <ufo/math/frustum.hpp>
+#include <ufo/math/mat4x4.hpp>
+#include <ufo/math/numbers.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <random>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+// Camera at (0, 0, 5) looking down -z, 90 degree vertical field of view, depth [1, 100]
+template <bool ZeroToOne>
+Mat4x4f viewProjection()
+{
+	return perspective<float, true, ZeroToOne>(numbers::pi_v<float> / 2.0f, 1.0f, 1.0f,
+	                                           100.0f) *
+	       lookAt(Vec3f(0, 0, 5), Vec3f(0, 0, 0), Vec3f(0, 1, 0));
+}
+}  // namespace
+
+TEST_CASE("[Frustum] Planes")
+{
+	Frustumf f = frustum<float>(viewProjection<true>());
+
+	REQUIRE(f[Frustumf::NEAR_PLANE].x == Catch::Approx(0.0f).margin(1e-5));
+	REQUIRE(f[Frustumf::NEAR_PLANE].z == Catch::Approx(-1.0f));
+	REQUIRE(f[Frustumf::NEAR_PLANE].w == Catch::Approx(4.0f));
+	REQUIRE(f[Frustumf::FAR_PLANE].z == Catch::Approx(1.0f));
+	REQUIRE(f[Frustumf::FAR_PLANE].w == Catch::Approx(95.0f));
+
+	Frustumf g = frustum<float, true, false>(viewProjection<false>());
+	for (std::size_t i{}; Frustumf::size() > i; ++i) {
+		for (std::size_t j{}; 4 > j; ++j) {
+			REQUIRE(f[i][j] == Catch::Approx(g[i][j]).margin(1e-4));
+		}
+	}
+}
+
+TEST_CASE("[Frustum] Infinite far plane")
+{
+	Frustumf f(infinitePerspective(numbers::pi_v<float> / 2.0f, 1.0f, 1.0f));
+	REQUIRE(f[Frustumf::FAR_PLANE] == Vec4f(0, 0, 0, 1));
+	REQUIRE(contains(f, Vec3f(0, 0, -1e6f)));
+	REQUIRE_FALSE(contains(f, Vec3f(0, 0, 0)));
+}
+
+TEST_CASE("[Frustum] Classify")
+{
+	Frustumf f(viewProjection<true>());
+
+	REQUIRE(contains(f, Vec3f(0, 0, 0)));
+	REQUIRE_FALSE(contains(f, Vec3f(0, 0, 6)));
+
+	REQUIRE(Containment::INSIDE == classify(f, AABB3f(Vec3f(-1), Vec3f(1))));
+	REQUIRE(Containment::INTERSECTS == classify(f, AABB3f(Vec3f(-1), Vec3f(1, 1, 5))));
+	REQUIRE(Containment::OUTSIDE == classify(f, AABB3f(Vec3f(50, -1, -1), Vec3f(51, 1, 1))));
+	REQUIRE(Containment::OUTSIDE ==
+	        classify(f, AABB3f(Vec3f(-1, -1, -200), Vec3f(1, 1, -150))));
+
+	REQUIRE(Containment::INSIDE == classify(f, Vec3f(0, 0, -10), 1.0f));
+	REQUIRE(Containment::INTERSECTS == classify(f, Vec3f(0, 0, 4), 0.5f));
+	REQUIRE(Containment::OUTSIDE == classify(f, Vec3f(0, 0, 7), 1.0f));
+}
+
+TEST_CASE("[Frustum] Packets match scalar")
+{
+	Frustumf f(viewProjection<true>());
+
+	std::mt19937                          gen(42);
+	std::uniform_real_distribution<float> pos(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> ext(0.0f, 5.0f);
+
+	std::vector<AABB3f> boxes;
+	for (std::size_t i{}; 1001 > i; ++i) {
+		Vec3f c(pos(gen), pos(gen), pos(gen) - 50.0f);
+		Vec3f h(ext(gen), ext(gen), ext(gen));
+		boxes.emplace_back(c - h, c + h);
+	}
+
+	std::vector<Containment> expected;
+	for (auto const& b : boxes) {
+		expected.push_back(classify(f, b));
+	}
+
+	std::vector<Containment> res(boxes.size());
+	classify(f, boxes.begin(), boxes.end(), res.begin());
+	REQUIRE(expected == res);
+
+	std::vector<Containment> res16(boxes.size());
+	classify<float, 16>(execution::par, f, boxes.begin(), boxes.end(), res16.begin());
+	REQUIRE(expected == res16);
+
+	SpherePacket<float, 8> spheres;
+	for (std::size_t i{}; 8 > i; ++i) {
+		spheres.set(i, boxes[i].center(), ext(gen));
+	}
+	auto sres = classify(f, spheres);
+	for (std::size_t i{}; 8 > i; ++i) {
+		REQUIRE(sres[i] ==
+		        classify(f, boxes[i].center(), spheres.radius[i]));
+	}
+
+	std::vector<Spheref> sv;
+	for (auto const& b : boxes) {
+		sv.emplace_back(b.center(), norm(b.halfSize()));
+	}
+	std::vector<Containment> sexp;
+	for (auto const& s : sv) {
+		sexp.push_back(classify(f, s));
+	}
+	classify(execution::par, f, sv.begin(), sv.end(), res.begin());
+	REQUIRE(sexp == res);
+}
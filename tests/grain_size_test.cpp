@@ -0,0 +1,90 @@
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/detail/transform_fun.hpp>
+#include <ufo/math/grain_size.hpp>
+#include <ufo/math/thread_pool.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+// Number of distinct threads that ran `transform(policy, ...)` over `n` elements
+template <detail::ElementCost Cost = detail::ElementCost::CHEAP, class ExecutionPolicy>
+std::size_t transformThreads(ExecutionPolicy&& policy, std::size_t n)
+{
+	std::vector<Vec3f>        in(n, Vec3f(1, 2, 3));
+	std::vector<Vec3f>        out(n);
+	std::mutex                mutex;
+	std::set<std::thread::id> ids;
+	detail::transform<Cost>(policy, in.begin(), in.end(), out.begin(), [&](Vec3f const& v) {
+		if constexpr (detail::ElementCost::EXPENSIVE == Cost) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		std::lock_guard lock(mutex);
+		ids.insert(std::this_thread::get_id());
+		return 2.0f * v;
+	});
+	for (auto const& v : out) {
+		REQUIRE(Vec3f(2, 4, 6) == v);
+	}
+	return ids.size();
+}
+}  // namespace
+
+TEST_CASE("[GrainSize] Small inputs run sequentially")
+{
+	GrainSize const defaults = grainSize();
+	ThreadPool      pool(4);
+
+	setGrainSize({1000, 100});
+	REQUIRE(1000u == grainSize().sequential_below);
+	REQUIRE(100u == grainSize().min_per_thread);
+
+	REQUIRE(1u == transformThreads(pool.policy(), 16));
+	REQUIRE(1u == transformThreads(pool.policy(), 999));
+	REQUIRE(1u == transformThreads(execution::par, 999));
+	REQUIRE(1u == transformThreads(execution::omp::par, 999));
+	REQUIRE(4u >= transformThreads(pool.policy(), 100'000));
+
+	// Expensive operations ignore the cost model
+	REQUIRE(1u < transformThreads<detail::ElementCost::EXPENSIVE>(pool.policy(), 64));
+
+	std::size_t const hw = std::max(1u, std::thread::hardware_concurrency());
+	REQUIRE(1u == detail::parallelThreads(150));
+	REQUIRE(std::min(std::size_t(3), hw) == detail::parallelThreads(300));
+	REQUIRE(hw == detail::parallelThreads(100 * hw + 99));
+
+	setGrainSize(defaults);
+}
+
+TEST_CASE("[GrainSize] Calibration")
+{
+	GrainSize const defaults = grainSize();
+
+	GrainSize const grain = calibrateGrainSize(execution::omp::par);
+	REQUIRE(0u < grain.sequential_below);
+	REQUIRE(0u < grain.min_per_thread);
+	REQUIRE(grain.sequential_below == grainSize().sequential_below);
+	REQUIRE(grain.min_per_thread == grainSize().min_per_thread);
+
+	// Whatever was measured, the results must not change
+	std::vector<Vec3f> points(10'000, Vec3f(1, 0, 0));
+	Transform3f const  t(Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1), Vec3f(1, 2, 3));
+	REQUIRE(transform(t, points) == transform(execution::par, t, points));
+
+	setGrainSize(defaults);
+}
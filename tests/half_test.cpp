@@ -0,0 +1,148 @@
+// UFO
+#include <ufo/math/half.hpp>
+#include <ufo/math/vec3.hpp>
+#include <ufo/math/vecn.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+TEST_CASE("[Half] Conversion")
+{
+	SECTION("Exactly representable values round trip")
+	{
+		for (float f : {0.0f, -0.0f, 1.0f, -2.5f, 0.5f, 1024.0f, 65504.0f, 0.000061035156f}) {
+			REQUIRE(static_cast<float>(ufo::Half(f)) == f);
+		}
+	}
+
+	SECTION("Round to nearest even")
+	{
+		// 2049 lies exactly between 2048 and 2050
+		REQUIRE(static_cast<float>(ufo::Half(2049.0f)) == 2048.0f);
+		REQUIRE(static_cast<float>(ufo::Half(2051.0f)) == 2052.0f);
+	}
+
+	SECTION("Overflow, infinity and NaN")
+	{
+		REQUIRE(std::isinf(static_cast<float>(ufo::Half(1.0e6f))));
+		REQUIRE(std::isinf(static_cast<float>(ufo::Half(-std::numeric_limits<float>::infinity()))));
+		REQUIRE(std::isnan(static_cast<float>(ufo::Half(std::numeric_limits<float>::quiet_NaN()))));
+	}
+
+	SECTION("Subnormals")
+	{
+		float smallest = std::ldexp(1.0f, -24);
+		REQUIRE(static_cast<float>(ufo::Half(smallest)) == smallest);
+		REQUIRE(static_cast<float>(ufo::Half(smallest * 0.25f)) == 0.0f);
+	}
+
+	SECTION("All half values round trip through float")
+	{
+		for (std::uint32_t b{}; 0x10000u > b; ++b) {
+			ufo::Half h = ufo::Half::fromBits(static_cast<std::uint16_t>(b));
+			float     f = h;
+			if (std::isnan(f)) {
+				continue;
+			}
+			REQUIRE(ufo::Half(f).bits == h.bits);
+		}
+	}
+}
+
+TEST_CASE("[BFloat16] Conversion")
+{
+	REQUIRE(static_cast<float>(ufo::BFloat16(1.0f)) == 1.0f);
+	REQUIRE(static_cast<float>(ufo::BFloat16(-3.0e38f)) == Catch::Approx(-3.0e38f).epsilon(0.01));
+	REQUIRE(std::isnan(static_cast<float>(ufo::BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+	// 1 + 2^-8 lies exactly between 1 and 1 + 2^-7
+	REQUIRE(static_cast<float>(ufo::BFloat16(1.00390625f)) == 1.0f);
+	REQUIRE(static_cast<float>(ufo::BFloat16(1.01171875f)) == 1.015625f);
+}
+
+TEST_CASE("[Vec3h] Storage and arithmetic")
+{
+	REQUIRE(6 == sizeof(ufo::Vec3h));
+	REQUIRE(6 == sizeof(ufo::Vec3bf));
+
+	ufo::Vec3h a(1.0f, 2.0f, 3.0f);
+	ufo::Vec3h b(0.5f, -1.0f, 4.0f);
+
+	ufo::Vec3h c = a + b;
+	REQUIRE(static_cast<float>(c.x) == 1.5f);
+	REQUIRE(static_cast<float>(c.y) == 1.0f);
+	REQUIRE(static_cast<float>(c.z) == 7.0f);
+
+	c *= 2.0f;
+	REQUIRE(static_cast<float>(c.z) == 14.0f);
+
+	ufo::Vec3f f(a);
+	REQUIRE(f == ufo::Vec3f(1.0f, 2.0f, 3.0f));
+	REQUIRE(dot(ufo::Vec3f(a), ufo::Vec3f(b)) == Catch::Approx(10.5f));
+}
+
+TEST_CASE("[Half] [convert] Bulk conversion")
+{
+	std::vector<ufo::Vec3f> in;
+	for (int i{}; 1000 > i; ++i) {
+		float v = static_cast<float>(i) * 0.37f - 100.0f;
+		in.emplace_back(v, -v * 0.5f, v * v * 0.01f);
+	}
+
+	SECTION("Half")
+	{
+		std::vector<ufo::Vec3h> h(in.size());
+		std::vector<ufo::Vec3f> out(in.size());
+		convert(in.data(), in.data() + in.size(), h.data());
+		convert(h.data(), h.data() + h.size(), out.data());
+
+		for (std::size_t i{}; in.size() > i; ++i) {
+			for (std::size_t j{}; 3 > j; ++j) {
+				REQUIRE(h[i][j].bits == ufo::Half(in[i][j]).bits);
+				REQUIRE(out[i][j] == static_cast<float>(h[i][j]));
+			}
+		}
+	}
+
+	SECTION("BFloat16")
+	{
+		std::vector<ufo::Vec3bf> b(in.size());
+		std::vector<ufo::Vec3f>  out(in.size());
+		convert(in.data(), in.data() + in.size(), b.data());
+		convert(b.data(), b.data() + b.size(), out.data());
+
+		for (std::size_t i{}; in.size() > i; ++i) {
+			for (std::size_t j{}; 3 > j; ++j) {
+				REQUIRE(b[i][j].bits == ufo::BFloat16(in[i][j]).bits);
+				REQUIRE(out[i][j] == Catch::Approx(in[i][j]).epsilon(1.0 / 256.0).margin(1e-30));
+			}
+		}
+	}
+
+	SECTION("More than four components")
+	{
+		std::vector<ufo::Vec<6, float>>     v(in.size());
+		std::vector<ufo::Vec<6, ufo::Half>> h(in.size());
+		std::vector<ufo::Vec<6, float>>     out(in.size());
+		for (std::size_t i{}; in.size() > i; ++i) {
+			for (std::size_t j{}; 6 > j; ++j) {
+				v[i][j] = in[i][j % 3];
+			}
+		}
+		convert(v.data(), v.data() + v.size(), h.data());
+		convert(h.data(), h.data() + h.size(), out.data());
+
+		for (std::size_t i{}; in.size() > i; ++i) {
+			for (std::size_t j{}; 6 > j; ++j) {
+				REQUIRE(h[i][j].bits == ufo::Half(v[i][j]).bits);
+				REQUIRE(out[i][j] == static_cast<float>(h[i][j]));
+			}
+		}
+	}
+}
@@ -0,0 +1,150 @@
+// UFO
+#include <ufo/math/icp.hpp>
+#include <ufo/math/numbers.hpp>
+#include <ufo/math/quat.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+// Floor, two walls and a slanted roof of a 10 m room, with their normals
+void room(std::size_t n, unsigned seed, std::vector<Vec3d>& points,
+          std::vector<Vec3d>& normals)
+{
+	std::mt19937                           gen(seed);
+	std::uniform_real_distribution<double> uni(0.0, 10.0);
+
+	Vec3d const roof = normalize(Vec3d(0.2, 0.1, 1.0));
+	for (std::size_t i{}; n > i; ++i) {
+		double const a = uni(gen);
+		double const b = uni(gen);
+		switch (i % 4) {
+			case 0:
+				points.emplace_back(a, b, 0.0);
+				normals.emplace_back(0.0, 0.0, 1.0);
+				break;
+			case 1:
+				points.emplace_back(0.0, a, b);
+				normals.emplace_back(1.0, 0.0, 0.0);
+				break;
+			case 2:
+				points.emplace_back(a, 0.0, b);
+				normals.emplace_back(0.0, 1.0, 0.0);
+				break;
+			default:
+				points.emplace_back(a, b, 12.0 - 0.2 * a - 0.1 * b);
+				normals.push_back(roof);
+		}
+	}
+}
+}  // namespace
+
+TEST_CASE("[ICP] SE(3) exponential map")
+{
+	Transform3d const identity = se3Exp(Vec3d(0.0), Vec3d(1, 2, 3));
+	REQUIRE(Vec3d(1, 2, 3) == identity.translation);
+	REQUIRE(Mat3x3d() == identity.rotation);
+
+	Vec3d const axis = normalize(Vec3d(1, -2, 0.5));
+	for (double angle : {1e-6, 0.3, 2.5}) {
+		Transform3d const t = se3Exp(angle * axis, Vec3d(0.0));
+		Mat3x3d const     R(angleAxis(angle, axis));
+		for (std::size_t i{}; 3 > i; ++i) {
+			for (std::size_t j{}; 3 > j; ++j) {
+				REQUIRE(R[i][j] == Catch::Approx(t.rotation[i][j]).margin(1e-12));
+			}
+		}
+		REQUIRE(0.0 == Catch::Approx(norm(t.translation)).margin(1e-12));
+	}
+
+	// A screw motion: rotation about z with translation along it stays on the axis
+	Transform3d const screw = se3Exp(Vec3d(0, 0, numbers::pi), Vec3d(0, 0, 2));
+	REQUIRE(0.0 == Catch::Approx(screw.translation.x).margin(1e-12));
+	REQUIRE(0.0 == Catch::Approx(screw.translation.y).margin(1e-12));
+	REQUIRE(2.0 == Catch::Approx(screw.translation.z));
+}
+
+TEST_CASE("[ICP] Robust kernels")
+{
+	REQUIRE(1.0 == robustWeight(RobustKernel::NONE, 5.0, 1.0));
+	REQUIRE(1.0 == robustWeight(RobustKernel::HUBER, 0.5, 1.0));
+	REQUIRE(0.25 == robustWeight(RobustKernel::HUBER, -4.0, 1.0));
+	REQUIRE(0.5 == robustWeight(RobustKernel::CAUCHY, 1.0, 1.0));
+	REQUIRE(0.2 == Catch::Approx(robustWeight(RobustKernel::CAUCHY, 2.0, 1.0)));
+}
+
+TEST_CASE("[ICP] Point-to-plane")
+{
+	std::vector<Vec3d> target, normals;
+	room(20'000, 61, target, normals);
+	KDTree<3, double> tree(execution::par, target.begin(), target.end());
+
+	std::vector<Vec3d> source, source_normals;
+	room(5'000, 62, source, source_normals);
+
+	Transform3d const truth(angleAxis(0.05, normalize(Vec3d(1, 2, 3))), Vec3d(0.2, -0.1, 0.15));
+	Transform3d const inv(transpose(truth.rotation), -(transpose(truth.rotation) * truth.translation));
+	for (auto& p : source) {
+		p = inv(p);
+	}
+
+	IcpParams<double> params;
+	params.max_correspondence_distance = 1.0;
+
+	auto eq = pointToPlaneEquations(Transform3d(), source.begin(), source.end(), tree,
+	                                normals.begin(), params);
+	auto par_eq = pointToPlaneEquations(execution::par, Transform3d(), source.begin(),
+	                                    source.end(), tree, normals.begin(), params);
+	REQUIRE(eq.h == par_eq.h);
+	REQUIRE(eq.b == par_eq.b);
+	REQUIRE(source.size() == eq.count);
+
+	for (auto kernel : {RobustKernel::NONE, RobustKernel::HUBER, RobustKernel::CAUCHY}) {
+		params.kernel = kernel;
+
+		auto res = icp(execution::par, source.begin(), source.end(), tree, normals.begin(),
+		               Transform3d(), params);
+		REQUIRE(res.converged);
+		// Corner points find their closest point on the neighbouring plane
+		REQUIRE(0.01 > res.rmse);
+		REQUIRE(source.size() == res.correspondences);
+		for (std::size_t i{}; 3 > i; ++i) {
+			REQUIRE(truth.translation[i] ==
+			        Catch::Approx(res.transform.translation[i]).margin(1e-3));
+			for (std::size_t j{}; 3 > j; ++j) {
+				REQUIRE(truth.rotation[i][j] ==
+				        Catch::Approx(res.transform.rotation[i][j]).margin(1e-3));
+			}
+		}
+
+		auto seq = icp(source.begin(), source.end(), tree, normals.begin(), Transform3d(),
+		               params);
+		REQUIRE(res.iterations == seq.iterations);
+		REQUIRE(res.transform.translation == seq.transform.translation);
+	}
+}
+
+TEST_CASE("[ICP] Degenerate")
+{
+	// A single plane leaves three directions unconstrained
+	std::vector<Vec3d> target, normals;
+	for (std::size_t i{}; 100 > i; ++i) {
+		target.emplace_back(static_cast<double>(i % 10), static_cast<double>(i / 10), 0.0);
+		normals.emplace_back(0.0, 0.0, 1.0);
+	}
+	KDTree<3, double> tree(target.begin(), target.end());
+
+	auto res = icp(target.begin(), target.end(), tree, normals.begin());
+	REQUIRE_FALSE(res.converged);
+	REQUIRE(0 == res.iterations);
+	REQUIRE(target.size() == res.correspondences);
+}
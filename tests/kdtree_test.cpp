@@ -0,0 +1,184 @@
+// UFO
+#include <ufo/math/kdtree.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+std::vector<Vec3f> randomPoints(std::size_t n, unsigned seed)
+{
+	std::mt19937                          gen(seed);
+	std::uniform_real_distribution<float> uni(-10.0f, 10.0f);
+
+	std::vector<Vec3f> points;
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(uni(gen), uni(gen), uni(gen));
+	}
+	return points;
+}
+
+std::vector<float> sortedDistances(std::vector<Vec3f> const& points, Vec3f const& q)
+{
+	std::vector<float> d;
+	for (auto const& p : points) {
+		d.push_back(distanceSquared(p, q));
+	}
+	std::sort(d.begin(), d.end());
+	return d;
+}
+}  // namespace
+
+TEST_CASE("[KDTree] Build")
+{
+	auto points = randomPoints(10'000, 31);
+	// Duplicates exercise the tie breaking
+	points.insert(points.end(), 100, Vec3f(1, 2, 3));
+
+	KDTree<3> tree(points.begin(), points.end());
+	REQUIRE(points.size() == tree.size());
+	for (std::size_t i{}; tree.size() > i; ++i) {
+		REQUIRE(points[tree.indices()[i]] == tree.points()[i]);
+		REQUIRE(points[i] == tree.point(i));
+	}
+
+	KDTree<3> par(execution::par, points.begin(), points.end());
+	REQUIRE(tree.indices() == par.indices());
+
+	KDTree<3> none;
+	REQUIRE(none.empty());
+	REQUIRE(std::numeric_limits<std::size_t>::max() == none.nearest(Vec3f()).first);
+}
+
+TEST_CASE("[KDTree] k-nearest neighbours")
+{
+	auto points  = randomPoints(5'000, 32);
+	auto queries = randomPoints(200, 33);
+
+	KDTree<3> tree(points.begin(), points.end());
+
+	constexpr std::size_t    k = 10;
+	std::vector<std::size_t> indices(k);
+	std::vector<float>       distances(k);
+	for (auto const& q : queries) {
+		auto expected = sortedDistances(points, q);
+
+		REQUIRE(k == tree.knn(q, k, indices.begin(), distances.begin()));
+		for (std::size_t i{}; k > i; ++i) {
+			REQUIRE(expected[i] == distances[i]);
+			REQUIRE(distanceSquared(points[indices[i]], q) == distances[i]);
+		}
+
+		auto [index, d] = tree.nearest(q);
+		REQUIRE(expected[0] == d);
+		REQUIRE(expected[0] == distanceSquared(points[index], q));
+
+		float const r = std::sqrt((expected[3] + expected[4]) / 2);
+		REQUIRE(4 == tree.knn(q, k, indices.begin(), distances.begin(), r));
+	}
+
+	std::vector<std::uint32_t> few_indices(k);
+	KDTree<3>                  small(points.begin(), points.begin() + 3);
+	REQUIRE(3 == small.knn(queries[0], k, few_indices.begin(), distances.begin()));
+}
+
+TEST_CASE("[KDTree] Radius")
+{
+	auto points  = randomPoints(5'000, 34);
+	auto queries = randomPoints(200, 35);
+
+	KDTree<3> tree(points.begin(), points.end());
+
+	float const              r = 1.5f;
+	std::vector<std::size_t> indices(64);
+	std::vector<float>       distances(64);
+	for (auto const& q : queries) {
+		auto              expected = sortedDistances(points, q);
+		std::size_t const count    = static_cast<std::size_t>(
+        std::upper_bound(expected.begin(), expected.end(), r * r) - expected.begin());
+
+		REQUIRE(count == tree.radius(q, r, indices.size(), indices.begin(), distances.begin()));
+		for (std::size_t i{}; std::min(count, indices.size()) > i; ++i) {
+			REQUIRE(distanceSquared(points[indices[i]], q) == distances[i]);
+			REQUIRE(r * r >= distances[i]);
+		}
+		REQUIRE(count == tree.radius(q, r, 0, indices.begin(), distances.begin()));
+	}
+}
+
+TEST_CASE("[KDTree] Batch queries")
+{
+	auto points  = randomPoints(5'000, 36);
+	auto queries = randomPoints(1'000, 37);
+
+	KDTree<3> tree(points.begin(), points.end());
+
+	constexpr std::size_t    k = 8;
+	std::vector<std::size_t> indices(queries.size() * k);
+	std::vector<float>       distances(queries.size() * k);
+	std::vector<std::size_t> par_indices(queries.size() * k);
+	std::vector<float>       par_distances(queries.size() * k);
+
+	knn(tree, queries.begin(), queries.end(), k, indices.begin(), distances.begin());
+	knn(execution::par, tree, queries.begin(), queries.end(), k, par_indices.begin(),
+	    par_distances.begin());
+	REQUIRE(distances == par_distances);
+
+	std::vector<std::size_t> single(k);
+	std::vector<float>       single_distances(k);
+	for (std::size_t q{}; queries.size() > q; ++q) {
+		tree.knn(queries[q], k, single.begin(), single_distances.begin());
+		for (std::size_t i{}; k > i; ++i) {
+			REQUIRE(single_distances[i] == distances[q * k + i]);
+		}
+	}
+
+	constexpr std::size_t    capacity = 32;
+	std::vector<std::size_t> counts(queries.size());
+	std::vector<std::size_t> r_indices(queries.size() * capacity);
+	std::vector<float>       r_distances(queries.size() * capacity);
+	radius(execution::par, tree, queries.begin(), queries.end(), 1.0f, capacity,
+	       r_indices.begin(), r_distances.begin(), counts.begin());
+	for (std::size_t q{}; queries.size() > q; ++q) {
+		REQUIRE(counts[q] == tree.radius(queries[q], 1.0f, 0, r_indices.begin(),
+		                                 r_distances.begin()));
+	}
+
+	KDTree<3>                small(points.begin(), points.begin() + 3);
+	std::vector<std::size_t> few(k);
+	std::vector<float>       few_distances(k);
+	knn(small, queries.begin(), queries.begin() + 1, k, few.begin(), few_distances.begin());
+	REQUIRE(std::numeric_limits<std::size_t>::max() == few[3]);
+	REQUIRE(std::numeric_limits<float>::infinity() == few_distances[k - 1]);
+}
+
+TEST_CASE("[KDTree] Two dimensions")
+{
+	std::mt19937                          gen(38);
+	std::uniform_real_distribution<float> uni(-10.0f, 10.0f);
+
+	std::vector<Vec2f> points;
+	for (std::size_t i{}; 2'000 > i; ++i) {
+		points.emplace_back(uni(gen), uni(gen));
+	}
+
+	KDTree<2> tree(points.begin(), points.end());
+	for (std::size_t i{}; 100 > i; ++i) {
+		Vec2f q(uni(gen), uni(gen));
+		float best = std::numeric_limits<float>::infinity();
+		for (auto const& p : points) {
+			best = std::min(best, distanceSquared(p, q));
+		}
+		REQUIRE(best == tree.nearest(q).second);
+	}
+}
@@ -0,0 +1,33 @@
+// UFO
+#include <ufo/math/mat3x3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ufo;
+
+TEST_CASE("[Mat3x3] Eigen decomposition of symmetric matrix")
+{
+	Mat3x3d m(4, 1, 2, 1, 3, 0, 2, 0, 5);
+
+	auto [values, vectors] = eigenSymmetric(m);
+
+	REQUIRE(values[0] <= values[1]);
+	REQUIRE(values[1] <= values[2]);
+	REQUIRE(values[0] + values[1] + values[2] == Catch::Approx(12.0));
+
+	for (std::size_t i{}; 3 > i; ++i) {
+		Vec3d v  = vectors[i];
+		Vec3d mv = m * v;
+		REQUIRE(norm(v) == Catch::Approx(1.0));
+		for (std::size_t j{}; 3 > j; ++j) {
+			REQUIRE(mv[j] == Catch::Approx(values[i] * v[j]).margin(1e-12));
+		}
+	}
+
+	auto [dv, dvec] = eigenSymmetric(Mat3x3d(3, 0, 0, 0, 1, 0, 0, 0, 2));
+	REQUIRE(Vec3d(1, 2, 3) == dv);
+	REQUIRE(Vec3d(0, 1, 0) == dvec[0]);
+}
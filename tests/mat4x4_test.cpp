@@ -0,0 +1,25 @@
+// UFO
+#include <ufo/math/mat4x4.hpp>
+#include <ufo/math/vec3.hpp>
+#include <ufo/math/vec4.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ufo;
+
+TEST_CASE("[Mat4x4] Multiplication")
+{
+	Mat4x4f a(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+	Mat4x4f b(0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0);
+
+	// b reverses the order of the columns of a
+	REQUIRE(a * b == Mat4x4f(13, 14, 15, 16, 9, 10, 11, 12, 5, 6, 7, 8, 1, 2, 3, 4));
+	REQUIRE(a * Mat4x4f() == a);
+}
+
+TEST_CASE("[Mat4x4] Look at")
+{
+	Mat4x4f v = lookAt(Vec3f(0, 0, 5), Vec3f(0, 0, 0), Vec3f(0, 1, 0));
+	REQUIRE(v == Mat4x4f(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, -5, 1));
+}
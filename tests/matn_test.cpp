@@ -0,0 +1,161 @@
+// UFO
+#include <ufo/math/mat.hpp>
+#include <ufo/math/vec.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+
+using namespace ufo;
+
+namespace
+{
+// Symmetric positive definite: B * transpose(B) + 6 * I
+Mat6d spd()
+{
+	Mat6d b(0.0);
+	for (std::size_t col{}; 6 > col; ++col) {
+		for (std::size_t row{}; 6 > row; ++row) {
+			b[col][row] = static_cast<double>((3 * col + 5 * row) % 7) - 3.0;
+		}
+	}
+	Mat6d m = Mat6d() * 6.0;
+	rankUpdate(m, b);
+	return m;
+}
+}  // namespace
+
+TEST_CASE("[MatN] Construction and arithmetic")
+{
+	Mat6d i;
+	for (std::size_t col{}; 6 > col; ++col) {
+		for (std::size_t row{}; 6 > row; ++row) {
+			REQUIRE((col == row ? 1.0 : 0.0) == i[col][row]);
+		}
+	}
+
+	Vec6d v(1, 2, 3, 4, 5, 6);
+	REQUIRE(v == i * v);
+	REQUIRE(v == v * i);
+	REQUIRE(Vec6d(2, 4, 6, 8, 10, 12) == (i + i) * v);
+	REQUIRE(21.0 == sum(v));
+	REQUIRE(6.0 == max(v));
+	REQUIRE(5u == maxIndex(v));
+	REQUIRE(0u == minIndex(v));
+
+	// 2x3 (2 columns, 3 rows) times 4x2 is 4x3
+	Mat<2, 3, double> a(Vec3d(1, 2, 3), Vec3d(4, 5, 6));
+	Mat<4, 2, double> b(Vec2d(1, 0), Vec2d(0, 1), Vec2d(1, 1), Vec2d(2, -1));
+	Mat<4, 3, double> c = a * b;
+	REQUIRE(Vec3d(1, 2, 3) == c[0]);
+	REQUIRE(Vec3d(4, 5, 6) == c[1]);
+	REQUIRE(Vec3d(5, 7, 9) == c[2]);
+	REQUIRE(Vec3d(-2, -1, 0) == c[3]);
+	REQUIRE(a == transpose(transpose(a)));
+	REQUIRE(Vec2d(14, 32) == Vec3d(1, 2, 3) * a);
+
+	std::ostringstream ss;
+	ss << v;
+	REQUIRE("1 2 3 4 5 6" == ss.str());
+}
+
+TEST_CASE("[MatN] Inverse and determinant")
+{
+	Mat6d m   = spd();
+	Mat6d inv = inverse(m);
+	Mat6d id  = m * inv;
+	for (std::size_t col{}; 6 > col; ++col) {
+		for (std::size_t row{}; 6 > row; ++row) {
+			REQUIRE(id[col][row] == Catch::Approx(col == row ? 1.0 : 0.0).margin(1e-12));
+		}
+	}
+
+	// The determinant of a triangular matrix is the product of its diagonal
+	Mat6d t;
+	t[3][1] = 7.0;
+	t[5][0] = -2.0;
+	t[2][2] = 3.0;
+	t[4][4] = -0.5;
+	REQUIRE(determinant(t) == Catch::Approx(-1.5));
+
+	// Swapping two columns flips the sign
+	Mat6d s = m;
+	s[0].swap(s[4]);
+	REQUIRE(determinant(s) == Catch::Approx(-determinant(m)));
+	REQUIRE(determinant(m) * determinant(inv) == Catch::Approx(1.0));
+	REQUIRE(0.0 == determinant(Mat6d(1.0)));
+
+	// Singular matrices have no inverse, small but regular ones do
+	REQUIRE(std::isnan(inverse(Mat6d(1.0))[2][3]));
+	REQUIRE(std::isnan(inverse(Mat6d(0.0))[0][0]));
+	REQUIRE(inverse(Mat6d() * 1e-17)[4][4] == Catch::Approx(1e17));
+}
+
+TEST_CASE("[MatN] Cholesky and LDLT")
+{
+	Mat6d const m = spd();
+	Vec6d const x(1, -2, 3, -4, 5, -6);
+	Vec6d const b = m * x;
+
+	Mat6d l = m;
+	REQUIRE(cholesky(l));
+	Mat6d llt = l * transpose(l);
+	for (std::size_t col{}; 6 > col; ++col) {
+		for (std::size_t row{}; 6 > row; ++row) {
+			REQUIRE(llt[col][row] == Catch::Approx(m[col][row]));
+			if (row < col) {
+				REQUIRE(0.0 == l[col][row]);
+			}
+		}
+	}
+
+	Vec6d y = b;
+	choleskySolve(l, y);
+	for (std::size_t i{}; 6 > i; ++i) {
+		REQUIRE(y[i] == Catch::Approx(x[i]));
+	}
+
+	Mat6d ld = m;
+	REQUIRE(ldlt(ld));
+	Vec6d z = b;
+	ldltSolve(ld, z);
+	for (std::size_t i{}; 6 > i; ++i) {
+		REQUIRE(z[i] == Catch::Approx(x[i]));
+	}
+
+	// Indefinite: LDLT succeeds where Cholesky fails
+	Mat6d n = -m;
+	n[0][0] = m[0][0];
+	Mat6d nl = n;
+	REQUIRE_FALSE(cholesky(nl));
+	REQUIRE(ldlt(n));
+
+	Mat6d zero(0.0);
+	REQUIRE_FALSE(ldlt(zero));
+
+	// The pivot test is relative to the scale of the matrix
+	Mat6f small_f = Mat6f() * 1e-8f;
+	Mat6f small_l = small_f;
+	REQUIRE(cholesky(small_f));
+	REQUIRE(ldlt(small_l));
+	Mat6d small_d = m * 1e-17;
+	REQUIRE(cholesky(small_d));
+}
+
+TEST_CASE("[MatN] Rank updates")
+{
+	Mat3d m(0.0);
+	rankUpdate(m, Vec3d(1, 2, 3), 2.0);
+	REQUIRE(Mat3d(2, 4, 6, 4, 8, 12, 6, 12, 18) == m);
+
+	Mat<2, 3, double> a(Vec3d(1, 0, 1), Vec3d(0, 1, 1));
+	Mat3d             k(0.0);
+	rankUpdate(k, a);
+	REQUIRE(Mat3d(1, 0, 1, 0, 1, 1, 1, 1, 2) == k);
+	REQUIRE(a * transpose(a) == k);
+}
@@ -0,0 +1,96 @@
+// UFO
+#include <ufo/math/numa.hpp>
+#include <ufo/math/thread_pool.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+using namespace ufo;
+
+TEST_CASE("[NumaTopology] Detect and fake")
+{
+	NumaTopology detected;
+	REQUIRE(1 <= detected.nodes());
+	for (std::size_t node{}; detected.nodes() > node; ++node) {
+		REQUIRE(1 <= detected.threads(node));
+	}
+
+	NumaTopology fake = NumaTopology::fake(2, 3);
+	REQUIRE(2 == fake.nodes());
+	REQUIRE(3 == fake.threads(0));
+	REQUIRE(3 == fake.threads(1));
+	REQUIRE(fake.cpus(1).empty());
+	REQUIRE_FALSE(fake.pin(1));
+}
+
+TEST_CASE("[ThreadPool] NUMA participants and steal order")
+{
+	ThreadPool pool(NumaTopology::fake(2, 3));
+	REQUIRE(6 == pool.size());
+	REQUIRE(2 == pool.nodes());
+
+	for (std::size_t p{}; pool.size() > p; ++p) {
+		REQUIRE(p / 3 == pool.node(p));
+	}
+
+	REQUIRE(std::vector<std::size_t>{0, 1, 2, 3, 4, 5} == pool.stealOrder(0));
+	REQUIRE(std::vector<std::size_t>{2, 0, 1, 3, 4, 5} == pool.stealOrder(2));
+	REQUIRE(std::vector<std::size_t>{4, 5, 3, 0, 1, 2} == pool.stealOrder(4));
+
+	ThreadPool flat(4);
+	REQUIRE(1 == flat.nodes());
+	REQUIRE(std::vector<std::size_t>{1, 2, 3, 0} == flat.stealOrder(1));
+}
+
+TEST_CASE("[ThreadPool] NUMA every index exactly once")
+{
+	ThreadPool pool(NumaTopology::fake(3, 2));
+
+	for (std::size_t size : {0, 1, 5, 100, 10'007}) {
+		std::vector<std::atomic<int>> count(size);
+		pool.forEach(0, size, [&count](std::size_t i) { ++count[i]; });
+		for (auto const& c : count) {
+			REQUIRE(1 == c);
+		}
+	}
+}
+
+TEST_CASE("[ThreadPool] First touch allocation")
+{
+	ThreadPool pool(NumaTopology::fake(2, 2));
+
+	std::size_t const size = 100'000;
+
+	std::vector<Vec3f> in(size);
+	for (std::size_t i{}; size > i; ++i) {
+		in[i] = Vec3f(static_cast<float>(i), 1.0f, -2.0f);
+	}
+
+	Transform3f const t(Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1), Vec3f(1, 2, 3));
+
+	std::vector<Vec3f, FirstTouchAllocator<Vec3f>> out(size,
+	                                                   FirstTouchAllocator<Vec3f>(pool));
+	transform(pool.policy(), t, in.begin(), in.end(), out.begin());
+
+	for (std::size_t i{}; size > i; ++i) {
+		REQUIRE(t(in[i]) == out[i]);
+	}
+
+	// Unaligned and tiny ranges
+	std::vector<unsigned char> bytes(3 * 4096 + 17, 1);
+	pool.firstTouch(bytes.data() + 5, bytes.size() - 5);
+	pool.firstTouch(bytes.data() + 1, 0);
+	for (std::size_t i{}; 5 > i; ++i) {
+		REQUIRE(1 == bytes[i]);
+	}
+	REQUIRE(0 == bytes[5]);
+
+	REQUIRE(FirstTouchAllocator<Vec3f>(pool) == FirstTouchAllocator<float>(pool));
+}
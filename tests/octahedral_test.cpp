@@ -0,0 +1,78 @@
+// UFO
+#include <ufo/math/octahedral.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+template <std::size_t Bits>
+void checkMaxAngularError(double fast_bound_deg, double precise_bound_deg)
+{
+	std::mt19937                     gen(3);
+	std::normal_distribution<double> dist;
+
+	std::vector<ufo::Vec3d> normals;
+	for (int i{}; 20000 > i; ++i) {
+		normals.push_back(normalize(ufo::Vec3d(dist(gen), dist(gen), dist(gen))));
+	}
+	// Axes and octant borders
+	normals.emplace_back(0.0, 0.0, -1.0);
+	normals.emplace_back(1.0, 0.0, 0.0);
+	normals.emplace_back(0.0, -1.0, 0.0);
+	normals.push_back(normalize(ufo::Vec3d(1.0, -1.0, 0.0)));
+
+	std::vector<ufo::Oct<Bits>> fast(normals.size());
+	std::vector<ufo::Oct<Bits>> precise(normals.size());
+	std::vector<ufo::Vec3d>     decoded(normals.size());
+	ufo::octEncode<Bits>(normals.begin(), normals.end(), fast.begin());
+	ufo::octEncodePrecise<Bits>(ufo::execution::par, normals.begin(), normals.end(),
+	                            precise.begin());
+
+	double max_fast{};
+	double max_precise{};
+
+	ufo::octDecode<double>(fast.begin(), fast.end(), decoded.begin());
+	for (std::size_t i{}; normals.size() > i; ++i) {
+		REQUIRE(norm(decoded[i]) == Catch::Approx(1.0));
+		max_fast = std::max(max_fast, std::acos(std::min(1.0, dot(normals[i], decoded[i]))));
+	}
+
+	ufo::octDecode<double>(ufo::execution::par, precise.begin(), precise.end(),
+	                       decoded.begin());
+	for (std::size_t i{}; normals.size() > i; ++i) {
+		max_precise =
+		    std::max(max_precise, std::acos(std::min(1.0, dot(normals[i], decoded[i]))));
+	}
+
+	REQUIRE(ufo::degrees(max_fast) < fast_bound_deg);
+	REQUIRE(ufo::degrees(max_precise) < precise_bound_deg);
+	REQUIRE(max_precise <= max_fast);
+}
+
+TEST_CASE("[Oct] Size") { REQUIRE(3 == sizeof(ufo::Oct24)); }
+
+TEST_CASE("[Oct] Max angular error")
+{
+	SECTION("Oct16") { checkMaxAngularError<8>(0.95, 0.64); }
+	SECTION("Oct24") { checkMaxAngularError<12>(0.059, 0.040); }
+	SECTION("Oct32") { checkMaxAngularError<16>(0.0037, 0.0025); }
+}
+
+TEST_CASE("[Oct] Wrap and unwrap")
+{
+	ufo::Vec3f v = normalize(ufo::Vec3f(0.3f, -0.5f, -0.8f));
+	ufo::Vec2f p = ufo::octWrap(v);
+	REQUIRE(std::abs(p.x) <= 1.0f);
+	REQUIRE(std::abs(p.y) <= 1.0f);
+
+	ufo::Vec3f r = ufo::octUnwrap(p);
+	REQUIRE(r.x == Catch::Approx(v.x));
+	REQUIRE(r.y == Catch::Approx(v.y));
+	REQUIRE(r.z == Catch::Approx(v.z));
+}
@@ -0,0 +1,127 @@
+// UFO
+#include <ufo/math/pipeline.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+std::vector<Vec3f> scan(std::size_t size)
+{
+	std::vector<Vec3f> points;
+	for (std::size_t i{}; size > i; ++i) {
+		float const f = static_cast<float>(i);
+		points.emplace_back(f, 0.5f * f, -f);
+	}
+	return points;
+}
+
+template <class T>
+std::vector<T> collect(Chunks<T> chunks, std::vector<std::size_t>* sizes = nullptr)
+{
+	std::vector<T> v;
+	for (std::span<T> chunk : chunks) {
+		v.insert(v.end(), chunk.begin(), chunk.end());
+		if (sizes) {
+			sizes->push_back(chunk.size());
+		}
+	}
+	return v;
+}
+}  // namespace
+
+TEST_CASE("[Pipeline] Chunks")
+{
+	auto const points = scan(10);
+
+	std::vector<std::size_t> sizes;
+	REQUIRE(points == collect(chunks(points, 4), &sizes));
+	REQUIRE(std::vector<std::size_t>{4, 4, 2} == sizes);
+
+	sizes.clear();
+	REQUIRE(collect(chunks(std::vector<Vec3f>{}), &sizes).empty());
+	REQUIRE(sizes.empty());
+}
+
+TEST_CASE("[Pipeline] Stages")
+{
+	auto const points = scan(10'000);
+
+	Transform3f const t1(Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1), Vec3f(1, 2, 3));
+	Transform3f const t2(Mat3f(1, 0, 0, 0, 0, 1, 0, -1, 0), Vec3f(-4, 0, 2));
+
+	std::vector<Vec3f> expected = transform(t2, transform(t1, points));
+	std::erase_if(expected, [](Vec3f const& p) { return 0.0f > p.x; });
+
+	auto const keep = [](Vec3f const& p) { return 0.0f <= p.x; };
+
+	auto stages = transformChunks(t2, transformChunks(t1, chunks(points, 100)));
+	REQUIRE(expected == collect(filterChunks(std::move(stages), keep)));
+
+	// The same stages written with `mapChunks`
+	auto const compact = [keep](std::span<Vec3f> chunk) {
+		return chunk.first(static_cast<std::size_t>(
+		    std::remove_if(chunk.begin(), chunk.end(),
+		                   [keep](Vec3f const& p) { return !keep(p); }) -
+		    chunk.begin()));
+	};
+	auto const apply = [&t1, &t2](std::span<Vec3f> chunk) {
+		for (auto& p : chunk) {
+			p = t2(t1(p));
+		}
+	};
+	REQUIRE(expected == collect(mapChunks(mapChunks(chunks(points, 77), apply), compact)));
+}
+
+TEST_CASE("[Pipeline] Async")
+{
+	auto const points = scan(10'000);
+
+	Transform3f const t(Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1), Vec3f(1, 2, 3));
+
+	auto const expected = transform(t, points);
+	for (std::size_t depth : {1, 2, 8}) {
+		auto late  = asyncChunks(transformChunks(t, chunks(points, 64)), depth);
+		auto early = transformChunks(t, asyncChunks(chunks(points, 64), depth));
+		REQUIRE(expected == collect(std::move(late)));
+		REQUIRE(expected == collect(std::move(early)));
+	}
+
+	// Stopping early joins the producer
+	std::size_t count{};
+	for (std::span<Vec3f> chunk : asyncChunks(chunks(points, 16), 1)) {
+		count += chunk.size();
+		if (64 <= count) {
+			break;
+		}
+	}
+	REQUIRE(64 == count);
+
+	// Exceptions reach the consumer after the chunks produced before them
+	auto const fail = [](std::span<Vec3f> chunk) {
+		if (500.0f <= chunk.front().x) {
+			throw std::runtime_error("failed");
+		}
+	};
+	count = 0;
+	REQUIRE_THROWS_AS(
+	    [&] {
+		    for (std::span<Vec3f> chunk : asyncChunks(mapChunks(chunks(points, 100), fail))) {
+			    count += chunk.size();
+		    }
+	    }(),
+	    std::runtime_error);
+	REQUIRE(500 == count);
+}
@@ -0,0 +1,75 @@
+// UFO
+#include <ufo/math/numbers.hpp>
+#include <ufo/math/plane.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace ufo;
+
+TEST_CASE("[Plane] Signed distance")
+{
+	Planef p(Vec3f(0, 0, 1), Vec3f(0, 0, 2));
+	REQUIRE(-2.0f == p.distance);
+	REQUIRE(1.0f == signedDistance(p, Vec3f(5, 5, 3)));
+	REQUIRE(-2.0f == signedDistance(p, Vec3f(1, 1, 0)));
+	REQUIRE(Vec3f(5, 5, 2) == project(p, Vec3f(5, 5, 7)));
+
+	Planef q(Vec3f(0, 0, 0), Vec3f(1, 0, 0), Vec3f(0, 1, 0));
+	REQUIRE(Vec3f(0, 0, 1) == q.normal);
+
+	Planef r(Vec4f(0, 0, 2, -4));
+	REQUIRE(p == r);
+}
+
+TEST_CASE("[Plane] Transform")
+{
+	Planef      p(Vec3f(0, 0, 1), Vec3f(0, 0, 2));
+	Transform3f t(angleAxis(numbers::pi_v<float> / 2.0f, Vec3f(1, 0, 0)), Vec3f(1, 2, 3));
+	Planef      q = transform(t, p);
+	Vec3f       x = t * Vec3f(4, -7, 2);
+	REQUIRE(signedDistance(q, x) == Catch::Approx(0.0f).margin(1e-5));
+	REQUIRE(signedDistance(q, t * Vec3f(0, 0, 3)) == Catch::Approx(1.0f));
+}
+
+TEST_CASE("[Plane] Fit and inliers")
+{
+	Planed truth(normalize(Vec3d(1, 2, 3)), 0.5);
+
+	std::mt19937                           gen(7);
+	std::uniform_real_distribution<double> uni(-10.0, 10.0);
+	std::normal_distribution<double>       noise(0.0, 0.01);
+
+	std::vector<Vec3d> points;
+	for (std::size_t i{}; 10'000 > i; ++i) {
+		Vec3d p(uni(gen), uni(gen), uni(gen));
+		points.push_back(project(truth, p) + truth.normal * noise(gen));
+	}
+	for (std::size_t i{}; 1'000 > i; ++i) {
+		points.emplace_back(uni(gen), uni(gen), 20.0 + uni(gen));
+	}
+
+	Planed fit = fitPlane(points.begin(), points.begin() + 10'000);
+	if (0.0 > dot(fit.normal, truth.normal)) {
+		fit = Planed(-fit.normal, -fit.distance);
+	}
+	REQUIRE(dot(fit.normal, truth.normal) == Catch::Approx(1.0).margin(1e-6));
+	REQUIRE(fit.distance == Catch::Approx(truth.distance).margin(1e-3));
+
+	std::size_t inliers = countInliers(truth, points.begin(), points.end(), 0.05);
+	REQUIRE(10'000 <= inliers);
+	REQUIRE(inliers == countInliers(execution::par, truth, points.begin(), points.end(),
+	                                0.05));
+
+	std::vector<double> d(points.size());
+	signedDistance(execution::par, truth, points.begin(), points.end(), d.begin());
+	for (std::size_t i{}; points.size() > i; ++i) {
+		REQUIRE(d[i] == signedDistance(truth, points[i]));
+	}
+}
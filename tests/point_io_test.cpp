@@ -0,0 +1,244 @@
+// UFO
+#include <ufo/math/point_io.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ufo;
+
+TEST_CASE("[PointIO] XYZ")
+{
+	std::string const text =
+	    "# comment\n"
+	    "1 2 3\n"
+	    "\n"
+	    "4.5\t-5 6 255 0 0\r\n"
+	    "7,8,9";
+	REQUIRE(std::vector<Vec3f>{{1, 2, 3}, {4.5f, -5, 6}, {7, 8, 9}} == parseXYZ(text));
+	REQUIRE(parseXYZ("").empty());
+	REQUIRE_THROWS_AS(parseXYZ("1 2 3\n1 2\n"), std::runtime_error);
+
+	auto const path = std::filesystem::temp_directory_path() / "ufomath_point_io.xyz";
+	{
+		std::ofstream file(path);
+		file << text;
+	}
+	std::vector<Vec3d> const expected{{1, 2, 3}, {4.5, -5, 6}, {7, 8, 9}};
+	REQUIRE(expected == readXYZ<double>(path));
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("[PointIO] CSV")
+{
+	std::string const text =
+	    "time,x,y,z,intensity\n"
+	    "0.1,1,2,3,10\n"
+	    "0.2, 4 ,5,6,11\n";
+
+	CsvOptions options;
+	options.header_lines = 1;
+	options.columns      = {1, 2, 3};
+	REQUIRE(std::vector<Vec3f>{{1, 2, 3}, {4, 5, 6}} == parseCSV(text, options));
+
+	// Columns in another order, and a different delimiter
+	options.delimiter    = ';';
+	options.header_lines = 0;
+	options.columns      = {2, 0, 1};
+	REQUIRE(std::vector<Vec3f>{{3, 1, 2}} == parseCSV("1;2;3", options));
+
+	REQUIRE_THROWS_AS(parseCSV("1,2\n"), std::runtime_error);
+	REQUIRE_THROWS_AS(parseCSV("x,y,z\n"), std::runtime_error);
+}
+
+TEST_CASE("[PointIO] PLY ASCII")
+{
+	std::string const text =
+	    "ply\n"
+	    "format ascii 1.0\n"
+	    "comment made by hand\n"
+	    "element vertex 2\n"
+	    "property uchar red\n"
+	    "property float x\n"
+	    "property float y\n"
+	    "property float z\n"
+	    "element face 1\n"
+	    "property list uchar int vertex_indices\n"
+	    "end_header\n"
+	    "255 1 2 3\n"
+	    "0 4 5 6\n"
+	    "3 0 1 1\n";
+	REQUIRE(std::vector<Vec3f>{{1, 2, 3}, {4, 5, 6}} == parsePLY(text));
+
+	std::string const header =
+	    "ply\n"
+	    "format ascii 1.0\n"
+	    "element vertex 2\n"
+	    "property float x\n"
+	    "property float y\n";
+	// Truncated, and without z
+	REQUIRE_THROWS_AS(parsePLY(header + "property float z\nend_header\n1 2 3\n"),
+	                  std::runtime_error);
+	REQUIRE_THROWS_AS(parsePLY(header + "end_header\n1 2\n3 4\n"), std::runtime_error);
+	REQUIRE_THROWS_AS(parsePLY("xyz\n"), std::runtime_error);
+}
+
+namespace
+{
+template <class T>
+void append(std::string& s, T value, bool big_endian = false)
+{
+	char b[sizeof(T)];
+	std::memcpy(b, &value, sizeof(T));
+	if (big_endian) {
+		std::reverse(b, b + sizeof(T));
+	}
+	s.append(b, sizeof(T));
+}
+}  // namespace
+
+TEST_CASE("[PointIO] PLY binary")
+{
+	for (bool const big_endian : {false, true}) {
+		std::string text = "ply\nformat ";
+		text += big_endian ? "binary_big_endian" : "binary_little_endian";
+		text +=
+		    " 1.0\n"
+		    "element camera 1\n"
+		    "property float focal\n"
+		    "element vertex 2\n"
+		    "property double z\n"
+		    "property uchar red\n"
+		    "property float x\n"
+		    "property short y\n"
+		    "end_header\n";
+		append(text, 35.0f, big_endian);
+		for (int i{}; 2 > i; ++i) {
+			append(text, 3.0 + 3 * i, big_endian);
+			append(text, std::uint8_t(255), big_endian);
+			append(text, 1.5f + 3 * static_cast<float>(i), big_endian);
+			append(text, static_cast<std::int16_t>(-2 - 3 * i), big_endian);
+		}
+		REQUIRE(std::vector<Vec3f>{{1.5f, -2, 3}, {4.5f, -5, 6}} == parsePLY(text));
+		REQUIRE(std::vector<Vec3d>{{1.5, -2, 3}, {4.5, -5, 6}} == parsePLY<double>(text));
+
+		text.pop_back();
+		REQUIRE_THROWS_AS(parsePLY(text), std::runtime_error);
+	}
+}
+
+TEST_CASE("[PointIO] PCD")
+{
+	std::string const header =
+	    "# .PCD v0.7\n"
+	    "VERSION 0.7\n"
+	    "FIELDS rgb x y z\n"
+	    "SIZE 4 4 4 8\n"
+	    "TYPE U F I F\n"
+	    "COUNT 1 1 1 1\n"
+	    "WIDTH 2\n"
+	    "HEIGHT 1\n"
+	    "VIEWPOINT 0 0 0 1 0 0 0\n"
+	    "POINTS 2\n";
+
+	std::vector<Vec3f> const expected{{1.5f, -2, 3}, {4.5f, -5, 6}};
+
+	REQUIRE(expected == parsePCD(header + "DATA ascii\n0 1.5 -2 3\n0 4.5 -5 6\n"));
+
+	std::string text = header + "DATA binary\n";
+	for (int i{}; 2 > i; ++i) {
+		append(text, std::uint32_t(0));
+		append(text, 1.5f + 3 * static_cast<float>(i));
+		append(text, static_cast<std::int32_t>(-2 - 3 * i));
+		append(text, 3.0 + 3 * i);
+	}
+	REQUIRE(expected == parsePCD(text));
+
+	text.pop_back();
+	REQUIRE_THROWS_AS(parsePCD(text), std::runtime_error);
+	REQUIRE_THROWS_AS(parsePCD(header + "DATA binary_compressed\n"), std::runtime_error);
+
+	// Malformed numbers in the header
+	std::string const fields = "FIELDS x y z\nSIZE 4 4 4\nTYPE F F F\n";
+	REQUIRE_THROWS_AS(parsePCD(fields + "POINTS 2x\nDATA ascii\n1 2 3\n1 2 3\n"),
+	                  std::runtime_error);
+	REQUIRE_THROWS_AS(parsePCD(fields + "COUNT 1 one 1\nPOINTS 0\nDATA ascii\n"),
+	                  std::runtime_error);
+	REQUIRE_THROWS_AS(parsePCD(fields + "COUNT 1 0 1\nPOINTS 0\nDATA ascii\n"),
+	                  std::runtime_error);
+	REQUIRE_THROWS_AS(parsePCD(fields + "COUNT 0 0 0\nPOINTS 1\nDATA binary\n"),
+	                  std::runtime_error);
+	REQUIRE_THROWS_AS(parsePCD("FIELDS x y\nSIZE 4 4\nTYPE F F\nPOINTS 0\nDATA ascii\n"),
+	                  std::runtime_error);
+}
+
+TEST_CASE("[PointIO] Write and read PLY and PCD")
+{
+	std::vector<Vec3f> points;
+	for (int i{}; 10'000 > i; ++i) {
+		points.emplace_back(0.25f * static_cast<float>(i), -static_cast<float>(i), 0.5f);
+	}
+
+	auto const dir = std::filesystem::temp_directory_path();
+	for (auto format : {PointFileFormat::BINARY, PointFileFormat::ASCII}) {
+		auto const ply = dir / "ufomath_point_io.ply";
+		auto const pcd = dir / "ufomath_point_io.pcd";
+		writePLY(ply, points, format);
+		writePCD(pcd, points, format);
+
+		REQUIRE(points == readPLY(ply));
+		REQUIRE(points == readPCD(pcd));
+		REQUIRE(points == readPLY(execution::par, ply));
+		REQUIRE(points == readPCD(execution::par, pcd));
+
+		for (auto const& path : {ply, pcd}) {
+			PointCloudFile const file(path);
+			REQUIRE(points.size() == file.size());
+			REQUIRE((PointFileFormat::BINARY == format) == file.binary());
+			REQUIRE(points == file.read());
+			REQUIRE(points == file.read(execution::par));
+
+			std::vector<Vec3d> out(points.size());
+			file.read(execution::par, std::span(out));
+			REQUIRE(Vec3d(points[10]) == out[10]);
+
+			std::vector<float> x(points.size()), y(points.size()), z(points.size());
+			file.read(std::span(x), std::span(y), std::span(z));
+			REQUIRE(points[42] == Vec3f(x[42], y[42], z[42]));
+			REQUIRE(points.back() == Vec3f(x.back(), y.back(), z.back()));
+
+			z.pop_back();
+			REQUIRE_THROWS_AS(file.read(std::span(x), std::span(y), std::span(z)),
+			                  std::invalid_argument);
+		}
+
+		std::filesystem::remove(ply);
+		std::filesystem::remove(pcd);
+	}
+
+	// Mutable spans are written as well
+	auto const span_ply = dir / "ufomath_point_io_span.ply";
+	auto const span_pcd = dir / "ufomath_point_io_span.pcd";
+	writePLY(span_ply, std::span<Vec3f>(points));
+	writePCD(span_pcd, std::span<Vec3f>(points));
+	REQUIRE(points == readPLY(span_ply));
+	REQUIRE(points == readPCD(span_pcd));
+	std::filesystem::remove(span_ply);
+	std::filesystem::remove(span_pcd);
+
+	auto const empty = dir / "ufomath_point_io_empty.ply";
+	writePLY(empty, std::vector<Vec3d>{});
+	REQUIRE(readPLY<double>(empty).empty());
+	std::filesystem::remove(empty);
+}
@@ -0,0 +1,79 @@
+// UFO
+#include <ufo/math/quantizer.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("[Quantizer] Code type")
+{
+	STATIC_REQUIRE(std::is_same_v<std::uint32_t, ufo::Quantizer<10>::code_type>);
+	STATIC_REQUIRE(std::is_same_v<std::uint64_t, ufo::Quantizer<16>::code_type>);
+	STATIC_REQUIRE(std::is_same_v<std::uint64_t, ufo::Quantizer<21>::code_type>);
+}
+
+template <class Q>
+void checkErrorBound(Q const& q)
+{
+	std::mt19937                          gen(7);
+	std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+	auto bound = q.errorBound();
+	auto size  = q.max() - q.min();
+
+	std::vector<ufo::Vec3f> points;
+	for (int i{}; 10000 > i; ++i) {
+		points.push_back(q.min() + ufo::Vec3f(dist(gen), dist(gen), dist(gen)) * size);
+	}
+
+	std::vector<typename Q::code_type> codes(points.size());
+	std::vector<ufo::Vec3f>            decoded(points.size());
+	q.encode(points.begin(), points.end(), codes.begin());
+	q.decode(ufo::execution::par, codes.begin(), codes.end(), decoded.begin());
+
+	for (std::size_t i{}; points.size() > i; ++i) {
+		REQUIRE(codes[i] == q.encode(points[i]));
+		auto err = abs(decoded[i] - points[i]);
+		REQUIRE(all(lessThanEqual(err, bound)));
+	}
+}
+
+TEST_CASE("[Quantizer] Error bound")
+{
+	ufo::Vec3f min(-50.0f, -20.0f, -2.0f);
+	ufo::Vec3f max(50.0f, 20.0f, 8.0f);
+
+	SECTION("10 bits") { checkErrorBound(ufo::Quantizer<10>(min, max)); }
+	SECTION("16 bits") { checkErrorBound(ufo::Quantizer<16>(min, max)); }
+	SECTION("21 bits") { checkErrorBound(ufo::Quantizer<21>(min, max)); }
+	SECTION("21 bits Morton") { checkErrorBound(ufo::Quantizer<21, float, true>(min, max)); }
+
+	REQUIRE(ufo::Quantizer<10>(min, max).step().x == Catch::Approx(100.0f / 1023.0f));
+}
+
+TEST_CASE("[Quantizer] Clamping and corners")
+{
+	ufo::Quantizer<16> q(ufo::Vec3f(0.0f), ufo::Vec3f(1.0f));
+
+	REQUIRE(0u == q.encode(ufo::Vec3f(-5.0f)));
+	REQUIRE(q.decode(q.encode(ufo::Vec3f(5.0f))) == ufo::Vec3f(1.0f));
+	REQUIRE(q.decode(q.encode(ufo::Vec3f(0.0f))) == ufo::Vec3f(0.0f));
+}
+
+TEST_CASE("[Quantizer] Morton order")
+{
+	ufo::Quantizer<10, float, true> q(ufo::Vec3f(0.0f), ufo::Vec3f(1023.0f));
+
+	REQUIRE(0b001u == q.encode(ufo::Vec3f(1.0f, 0.0f, 0.0f)));
+	REQUIRE(0b010u == q.encode(ufo::Vec3f(0.0f, 1.0f, 0.0f)));
+	REQUIRE(0b100u == q.encode(ufo::Vec3f(0.0f, 0.0f, 1.0f)));
+	REQUIRE(0b111000u == q.encode(ufo::Vec3f(2.0f, 2.0f, 2.0f)));
+	REQUIRE(q.decode(q.encode(ufo::Vec3f(1023.0f, 5.0f, 700.0f))) ==
+	        ufo::Vec3f(1023.0f, 5.0f, 700.0f));
+}
@@ -0,0 +1,98 @@
+// UFO
+#include <ufo/math/quat_transform.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cmath>
+#include <vector>
+
+TEST_CASE("[QuatTransform] [sizeof] Compact storage")
+{
+	REQUIRE(7 * sizeof(float) == sizeof(ufo::QuatTransformf));
+	REQUIRE(7 * sizeof(double) == sizeof(ufo::QuatTransformd));
+}
+
+TEST_CASE("[QuatTransform] [operator()] Transform point")
+{
+	ufo::Quatf      q = ufo::angleAxis(1.2f, normalize(ufo::Vec3f(1.0f, 2.0f, 3.0f)));
+	ufo::Vec3f      t(1.0f, -2.0f, 0.5f);
+	ufo::QuatTransformf qt(q, t);
+	ufo::Transform3f    mt(q, t);
+
+	ufo::Vec3f v(0.3f, -4.0f, 2.5f);
+	ufo::Vec3f a = qt(v);
+	ufo::Vec3f b = mt(v);
+	REQUIRE(a.x == Catch::Approx(b.x));
+	REQUIRE(a.y == Catch::Approx(b.y));
+	REQUIRE(a.z == Catch::Approx(b.z));
+}
+
+TEST_CASE("[QuatTransform] [conversion] Round trip through Transform3")
+{
+	ufo::Quatf          q = ufo::angleAxis(-0.7f, normalize(ufo::Vec3f(0.0f, 1.0f, 1.0f)));
+	ufo::QuatTransformf qt(q, ufo::Vec3f(4.0f, 5.0f, 6.0f));
+
+	ufo::Transform3f    mt(qt);
+	ufo::QuatTransformf back(mt);
+
+	REQUIRE(std::abs(dot(back.rotation, qt.rotation)) == Catch::Approx(1.0f));
+	REQUIRE(back.translation == qt.translation);
+}
+
+TEST_CASE("[QuatTransform] [operator*] Composition and inverse")
+{
+	ufo::QuatTransformf a(ufo::angleAxis(0.4f, ufo::Vec3f(0.0f, 0.0f, 1.0f)),
+	                      ufo::Vec3f(1.0f, 0.0f, 0.0f));
+	ufo::QuatTransformf b(ufo::angleAxis(1.1f, ufo::Vec3f(1.0f, 0.0f, 0.0f)),
+	                      ufo::Vec3f(0.0f, 2.0f, -1.0f));
+
+	ufo::Vec3f v(1.0f, 2.0f, 3.0f);
+
+	SECTION("Composition matches Transform3")
+	{
+		ufo::Vec3f r1 = (a * b)(v);
+		ufo::Vec3f r2 = (ufo::Transform3f(a) * ufo::Transform3f(b))(v);
+		REQUIRE(r1.x == Catch::Approx(r2.x));
+		REQUIRE(r1.y == Catch::Approx(r2.y));
+		REQUIRE(r1.z == Catch::Approx(r2.z));
+	}
+
+	SECTION("Inverse undoes the transform")
+	{
+		ufo::Vec3f r = inverse(a * b)((a * b)(v));
+		REQUIRE(r.x == Catch::Approx(v.x));
+		REQUIRE(r.y == Catch::Approx(v.y));
+		REQUIRE(r.z == Catch::Approx(v.z));
+	}
+}
+
+TEST_CASE("[QuatTransform] [transform] Batch transform")
+{
+	ufo::QuatTransformf qt(ufo::angleAxis(2.0f, normalize(ufo::Vec3f(1.0f, 1.0f, 0.0f))),
+	                       ufo::Vec3f(-3.0f, 0.5f, 2.0f));
+
+	std::vector<ufo::Vec3f> points;
+	for (int i{}; 100 > i; ++i) {
+		points.emplace_back(0.1f * static_cast<float>(i), -0.2f * static_cast<float>(i),
+		                    1.0f);
+	}
+
+	auto seq = transform(qt, points);
+	auto par = transform(ufo::execution::par, qt, points);
+	REQUIRE(points.size() == seq.size());
+	REQUIRE(points.size() == par.size());
+
+	for (std::size_t i{}; points.size() > i; ++i) {
+		ufo::Vec3f expected = qt(points[i]);
+		REQUIRE(seq[i].x == Catch::Approx(expected.x).margin(1e-5));
+		REQUIRE(seq[i].y == Catch::Approx(expected.y).margin(1e-5));
+		REQUIRE(seq[i].z == Catch::Approx(expected.z).margin(1e-5));
+		REQUIRE(par[i] == seq[i]);
+	}
+
+	transformInPlace(qt, points);
+	REQUIRE(points == seq);
+}
@@ -0,0 +1,107 @@
+// UFO
+#include <ufo/math/ransac.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+// 30% of the points on `plane` (with noise), the rest uniform in a 20 m cube
+std::vector<Vec3f> planeWithOutliers(Planef const& plane, std::size_t n)
+{
+	std::mt19937                          gen(3);
+	std::uniform_real_distribution<float> uni(-10.0f, 10.0f);
+	std::normal_distribution<float>       noise(0.0f, 0.01f);
+
+	std::vector<Vec3f> points;
+	for (std::size_t i{}; n > i; ++i) {
+		Vec3f p(uni(gen), uni(gen), uni(gen));
+		if (3 > i % 10) {
+			p = project(plane, p) + plane.normal * noise(gen);
+		}
+		points.push_back(p);
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[RANSAC] Plane")
+{
+	Planef truth(normalize(Vec3f(0.1f, -0.2f, 1.0f)), 1.5f);
+	auto   points = planeWithOutliers(truth, 20'000);
+
+	RansacParams<float> params;
+	params.threshold = 0.05f;
+
+	auto res = ransacPlane(points.begin(), points.end(), params);
+	REQUIRE(6'000 <= res.inliers);
+	REQUIRE(params.max_iterations > res.iterations);
+	REQUIRE(std::abs(dot(res.model.normal, truth.normal)) == Catch::Approx(1.0f));
+	REQUIRE(std::abs(res.model.distance) == Catch::Approx(truth.distance).margin(1e-2));
+
+	SECTION("Deterministic across policies")
+	{
+		params.refine = false;
+		auto seq      = ransacPlane(points.begin(), points.end(), params);
+		auto par      = ransacPlane(execution::par, points.begin(), points.end(), params);
+		REQUIRE(seq.model == par.model);
+		REQUIRE(seq.inliers == par.inliers);
+		REQUIRE(seq.iterations == par.iterations);
+	}
+
+	SECTION("Without SPRT")
+	{
+		params.sprt = false;
+		auto plain  = ransacPlane(points.begin(), points.end(), params);
+		REQUIRE(6'000 <= plain.inliers);
+	}
+
+	SECTION("PROSAC")
+	{
+		// Put the inliers first, as a quality sorted input would
+		std::stable_partition(points.begin(), points.end(), [&truth](auto const& p) {
+			return 0.05f >= std::abs(signedDistance(truth, p));
+		});
+		params.prosac = true;
+		auto pro      = ransacPlane(points.begin(), points.end(), params);
+		REQUIRE(6'000 <= pro.inliers);
+		REQUIRE(res.iterations >= pro.iterations);
+	}
+}
+
+TEST_CASE("[RANSAC] Line")
+{
+	Linef truth(Vec3f(1, 2, 3), normalize(Vec3f(1, 1, 0)));
+
+	std::mt19937                          gen(5);
+	std::uniform_real_distribution<float> uni(-10.0f, 10.0f);
+
+	std::vector<Vec3f> points;
+	for (std::size_t i{}; 5'000 > i; ++i) {
+		points.push_back(0 == i % 2 ? truth.origin + truth.direction * uni(gen)
+		                            : Vec3f(uni(gen), uni(gen), uni(gen)));
+	}
+
+	RansacParams<float> params;
+	params.threshold = 0.01f;
+
+	auto res = ransacLine(execution::par, points.begin(), points.end(), params);
+	REQUIRE(2'500 <= res.inliers);
+	REQUIRE(std::abs(dot(res.model.direction, truth.direction)) == Catch::Approx(1.0f));
+	REQUIRE(distance(res.model, truth.origin) == Catch::Approx(0.0f).margin(1e-3));
+}
+
+TEST_CASE("[RANSAC] Too few points")
+{
+	std::vector<Vec3f> points{Vec3f(0, 0, 0), Vec3f(1, 0, 0)};
+	REQUIRE(0 == ransacPlane(points.begin(), points.end()).inliers);
+}
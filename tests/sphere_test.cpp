@@ -0,0 +1,54 @@
+// UFO
+#include <ufo/math/sphere.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <random>
+#include <vector>
+
+using namespace ufo;
+
+TEST_CASE("[Sphere] Signed distance")
+{
+	Spheref s(Vec3f(1, 0, 0), 2.0f);
+	REQUIRE(1.0f == signedDistance(s, Vec3f(4, 0, 0)));
+	REQUIRE(-2.0f == signedDistance(s, Vec3f(1, 0, 0)));
+	REQUIRE(contains(s, Vec3f(1, 1, 1)));
+	REQUIRE_FALSE(contains(s, Vec3f(4, 0, 0)));
+
+	Transform3f t(Mat3x3f(), Vec3f(0, 1, 0));
+	REQUIRE(Spheref(Vec3f(1, 1, 0), 2.0f) == transform(t, s));
+}
+
+TEST_CASE("[Sphere] Fit and inliers")
+{
+	Sphered truth(Vec3d(3, -2, 5), 4.0);
+
+	std::mt19937                     gen(11);
+	std::normal_distribution<double> dir(0.0, 1.0);
+	std::normal_distribution<double> noise(0.0, 0.01);
+
+	std::vector<Vec3d> points;
+	for (std::size_t i{}; 10'000 > i; ++i) {
+		Vec3d n = normalize(Vec3d(dir(gen), dir(gen), dir(gen)));
+		points.push_back(truth.center + n * (truth.radius + noise(gen)));
+	}
+
+	Sphered fit = fitSphere(points.begin(), points.end());
+	REQUIRE(distance(fit.center, truth.center) < 1e-3);
+	REQUIRE(fit.radius == Catch::Approx(truth.radius).margin(1e-3));
+
+	std::size_t inliers = countInliers(truth, points.begin(), points.end(), 0.02);
+	REQUIRE(9'000 < inliers);
+	REQUIRE(inliers == countInliers(execution::par, truth, points.begin(), points.end(),
+	                                0.02));
+
+	std::vector<double> d(points.size());
+	signedDistance(truth, points.begin(), points.end(), d.begin());
+	for (std::size_t i{}; points.size() > i; ++i) {
+		REQUIRE(std::abs(d[i]) < 0.1);
+	}
+}
@@ -0,0 +1,128 @@
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/strided_view.hpp>
+#include <ufo/math/thread_pool.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+struct Point {
+	Vec3f         xyz;
+	float         intensity;
+	std::uint16_t ring;
+	double        t;
+};
+
+std::vector<Point> records(std::size_t size)
+{
+	std::vector<Point> points;
+	for (std::size_t i{}; size > i; ++i) {
+		float const f = static_cast<float>(i);
+		points.push_back({Vec3f(f, 0.5f * f, -f), 2.0f * f, static_cast<std::uint16_t>(i),
+		                  static_cast<double>(i)});
+	}
+	return points;
+}
+
+void requireOtherFieldsUnchanged(std::vector<Point> const& points)
+{
+	for (std::size_t i{}; points.size() > i; ++i) {
+		REQUIRE(2.0f * static_cast<float>(i) == points[i].intensity);
+		REQUIRE(static_cast<std::uint16_t>(i) == points[i].ring);
+		REQUIRE(static_cast<double>(i) == points[i].t);
+	}
+}
+}  // namespace
+
+TEST_CASE("[StridedView] Iteration")
+{
+	auto points = records(10);
+
+	auto view = stridedView(points, &Point::xyz);
+	static_assert(std::is_same_v<StridedView<Vec3f>, decltype(view)>);
+	static_assert(std::random_access_iterator<StridedIterator<Vec3f>>);
+	REQUIRE(10 == view.size());
+	REQUIRE(static_cast<std::ptrdiff_t>(sizeof(Point)) == view.stride());
+	REQUIRE(10 == std::distance(view.begin(), view.end()));
+	REQUIRE(Vec3f(3.0f, 1.5f, -3.0f) == view[3]);
+	REQUIRE(Vec3f(9.0f, 4.5f, -9.0f) == view.back());
+	REQUIRE(view.begin() + 3 < view.end() - 2);
+	REQUIRE(view[7] == *(view.end() - 3));
+
+	auto const& cpoints = points;
+	auto const  cview   = stridedView(cpoints, &Point::intensity);
+	static_assert(std::is_same_v<StridedView<float const> const, decltype(cview)>);
+	REQUIRE(8.0f == cview[4]);
+
+	StridedView<float const> const raw(points.data(), points.size(), sizeof(Point),
+	                                   offsetof(Point, intensity));
+	REQUIRE(std::equal(cview.begin(), cview.end(), raw.begin(), raw.end()));
+
+	StridedView<Vec3f const> const converted = view;
+	REQUIRE(view[5] == converted[5]);
+
+	std::vector<Point> none;
+	REQUIRE(stridedView(none, &Point::xyz).empty());
+}
+
+TEST_CASE("[StridedView] Transform in place")
+{
+	Transform3f const t(Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1), Vec3f(1, 2, 3));
+
+	// Sizes around whole packets and blocks
+	for (std::size_t size : {0, 1, 7, 8, 17, 4096, 10'007}) {
+		auto points = records(size);
+
+		std::vector<Vec3f> expected;
+		for (auto const& p : points) {
+			expected.push_back(t * p.xyz);
+		}
+
+		auto seq = points;
+		transformInPlace(t, stridedView(seq, &Point::xyz));
+		requireOtherFieldsUnchanged(seq);
+
+		auto par = points;
+		transformInPlace(execution::par, t, stridedView(par, &Point::xyz));
+		requireOtherFieldsUnchanged(par);
+
+		ThreadPool pool(3);
+		auto       pooled = points;
+		transformInPlace(pool.policy(), QuatTransform<float>(t),
+		                 stridedView(pooled, &Point::xyz));
+		requireOtherFieldsUnchanged(pooled);
+
+		// Through the generic iterator overloads
+		auto generic = points;
+		auto view    = stridedView(generic, &Point::xyz);
+		transformInPlace(t, view.begin(), view.end());
+
+		for (std::size_t i{}; size > i; ++i) {
+			REQUIRE(expected[i] == seq[i].xyz);
+			REQUIRE(expected[i] == par[i].xyz);
+			REQUIRE(expected[i] == generic[i].xyz);
+			REQUIRE(std::abs(expected[i].x - pooled[i].xyz.x) < 1e-3f);
+			REQUIRE(std::abs(expected[i].y - pooled[i].xyz.y) < 1e-3f);
+			REQUIRE(std::abs(expected[i].z - pooled[i].xyz.z) < 1e-3f);
+		}
+
+		auto const out = transform(t, stridedView(std::as_const(points), &Point::xyz));
+		REQUIRE(expected == out);
+	}
+}
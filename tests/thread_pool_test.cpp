@@ -0,0 +1,77 @@
+// UFO
+#include <ufo/math/thread_pool.hpp>
+#include <ufo/math/transform3.hpp>
+#include <ufo/math/vec3.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace ufo;
+
+TEST_CASE("[ThreadPool] Every index exactly once")
+{
+	for (std::size_t threads : {1, 2, 4, 7}) {
+		ThreadPool pool(threads);
+		REQUIRE(threads == pool.size());
+
+		for (std::size_t size : {0, 1, 5, 100, 10'007}) {
+			for (std::size_t grain : {0, 1, 64}) {
+				std::vector<std::atomic<int>> count(size + 10);
+				pool.forEach(10, size + 10, [&count](std::size_t i) { ++count[i]; }, grain);
+				for (std::size_t i{}; count.size() > i; ++i) {
+					REQUIRE((10 > i ? 0 : 1) == count[i]);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("[ThreadPool] Nested loops and exceptions")
+{
+	ThreadPool pool(4);
+
+	std::atomic<std::size_t> sum{};
+	pool.forEach(0, 100, [&](std::size_t i) {
+		pool.forEach(0, 100, [&](std::size_t j) { sum += i * j; });
+	});
+	REQUIRE(4950u * 4950u == sum);
+
+	REQUIRE_THROWS_AS(pool.forEach(0, 10'000,
+	                               [](std::size_t i) {
+		                               if (5'000 == i) {
+			                               throw std::runtime_error("failed");
+		                               }
+	                               }),
+	                  std::runtime_error);
+
+	// Still usable afterwards
+	std::atomic<std::size_t> count{};
+	pool.forEach(0, 1'000, [&count](std::size_t) { ++count; });
+	REQUIRE(1'000u == count);
+}
+
+TEST_CASE("[ThreadPool] Execution policy")
+{
+	ThreadPool pool(3);
+
+	std::vector<Vec3f> points;
+	for (std::size_t i{}; 10'000 > i; ++i) {
+		float const f = static_cast<float>(i);
+		points.emplace_back(f, 0.5f * f, -f);
+	}
+
+	Transform3f const t(Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1), Vec3f(1, 2, 3));
+
+	auto const expected = transform(t, points);
+	REQUIRE(expected == transform(pool.policy(), t, points));
+	REQUIRE(expected == transform(ThreadPool::global().policy(16), t, points));
+
+	transformInPlace(pool.policy(), t, points);
+	REQUIRE(expected == points);
+}
@@ -0,0 +1,207 @@
+// UFO
+#include <ufo/math/quat.hpp>
+#include <ufo/math/trajectory.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+// A helix, turning about z while climbing
+Trajectory<double> helix(std::size_t n)
+{
+	Trajectory<double> t;
+	for (std::size_t i{}; n > i; ++i) {
+		double const a = 0.01 * static_cast<double>(i);
+		t.stamps.push_back(0.1 * static_cast<double>(i));
+		t.poses.emplace_back(angleAxis(a, normalize(Vec3d(0.1, 0.0, 1.0))),
+		                     Vec3d(10.0 * std::cos(a), 10.0 * std::sin(a), 0.5 * a));
+	}
+	return t;
+}
+
+void requireEqual(Transform3d const& a, Transform3d const& b, double margin = 1e-9)
+{
+	for (std::size_t c{}; 3 > c; ++c) {
+		for (std::size_t r{}; 3 > r; ++r) {
+			REQUIRE(a.rotation[c][r] == Catch::Approx(b.rotation[c][r]).margin(margin));
+		}
+		REQUIRE(a.translation[c] == Catch::Approx(b.translation[c]).margin(margin));
+	}
+}
+}  // namespace
+
+TEST_CASE("[Trajectory] TUM")
+{
+	std::string const text =
+	    "# timestamp tx ty tz qx qy qz qw\n"
+	    "1305031102.175304 1.0 2.0 3.0 0 0 0 1\n"
+	    "\n"
+	    "1305031102.211214 1.5 2.0 3.0 0 0 0.7071068 0.7071068\r\n";
+
+	auto const t = parseTUM(text);
+	REQUIRE(2 == t.size());
+	REQUIRE(1305031102.175304 == t.stamps[0]);
+	requireEqual(Transform3d(Mat3d(), Vec3d(1, 2, 3)), t.poses[0]);
+	Mat3d const quarter_turn(0, 1, 0, -1, 0, 0, 0, 0, 1);
+	requireEqual(Transform3d(quarter_turn, Vec3d(1.5, 2, 3)), t.poses[1], 1e-6);
+
+	REQUIRE_THROWS_AS(parseTUM("1 2 3 4 5 6 7\n"), std::runtime_error);
+	try {
+		(void)parseTUM("1 0 0 0 0 0 0 1\n\n1 0 0 0 0 0 1\n");
+		FAIL();
+	} catch (std::runtime_error const& e) {
+		REQUIRE(std::string(e.what()).starts_with("TUM line 3"));
+	}
+
+	auto const truth = helix(20'000);
+	auto const path  = std::filesystem::temp_directory_path() / "ufomath_trajectory.txt";
+	writeTUM(path, truth);
+	auto const read = readTUM(path);
+	REQUIRE(truth.stamps == read.stamps);
+	for (std::size_t i{}; truth.size() > i; i += 997) {
+		requireEqual(truth.poses[i], read.poses[i]);
+	}
+
+	// Parsed in blocks, the same result for every policy
+	auto const par = readTUM(execution::par, path);
+	REQUIRE(read.stamps == par.stamps);
+	REQUIRE(read.poses == par.poses);
+	std::filesystem::remove(path);
+
+	REQUIRE_THROWS_AS(writeTUM(path, Trajectory<double>{{}, truth.poses}),
+	                  std::invalid_argument);
+}
+
+TEST_CASE("[Trajectory] KITTI")
+{
+	auto const t = parseKITTI<float>(
+	    "1 0 0 1 0 1 0 2 0 0 1 3\n"
+	    "0 -1 0 4 1 0 0 5 0 0 1 6\n");
+	REQUIRE(2 == t.size());
+	REQUIRE(t.stamps.empty());
+	REQUIRE(Transform3f(Mat3f(), Vec3f(1, 2, 3)) == t.poses[0]);
+	REQUIRE(Transform3f(Mat3f(0, 1, 0, -1, 0, 0, 0, 0, 1), Vec3f(4, 5, 6)) == t.poses[1]);
+	REQUIRE_THROWS_AS(parseKITTI("1 0 0 1 0 1 0 2 0 0 1\n"), std::runtime_error);
+
+	auto const truth = helix(20'000);
+	auto const path  = std::filesystem::temp_directory_path() / "ufomath_trajectory.txt";
+	writeKITTI(path, truth);
+	REQUIRE(truth.poses == readKITTI(path).poses);
+	REQUIRE(truth.poses == readKITTI(execution::par, path).poses);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("[Trajectory] Associate")
+{
+	std::vector<double> const a{0.0, 1.0, 2.0, 2.01, 5.0};
+	std::vector<double> const b{0.005, 1.1, 2.008, 4.0, 5.01};
+
+	auto const matches = associate(a, b, 0.02);
+	REQUIRE(3 == matches.size());
+	REQUIRE(std::pair<std::size_t, std::size_t>(0, 0) == matches[0]);
+	REQUIRE(std::pair<std::size_t, std::size_t>(3, 2) == matches[1]);
+	REQUIRE(std::pair<std::size_t, std::size_t>(4, 4) == matches[2]);
+	REQUIRE(associate({}, b, 1.0).empty());
+}
+
+TEST_CASE("[Trajectory] Umeyama")
+{
+	Transform3d const expected(angleAxis(1.2, normalize(Vec3d(0.3, -0.2, 1.0))),
+	                           Vec3d(4, -5, 6));
+
+	std::vector<Vec3d> source;
+	for (std::size_t i{}; 5000 > i; ++i) {
+		double const a = static_cast<double>(i);
+		source.emplace_back(std::sin(a), std::cos(0.7 * a), std::sin(1.3 * a + 1));
+	}
+
+	for (double const scale : {1.0, 2.5}) {
+		std::vector<Vec3d> target;
+		for (auto const& p : source) {
+			target.push_back(scale * (expected.rotation * p) + expected.translation);
+		}
+
+		auto const r = umeyama(source.begin(), source.end(), target.begin(), 1.0 != scale);
+		requireEqual(expected, r.transform);
+		REQUIRE(scale == Catch::Approx(r.scale));
+
+		auto const p = umeyama(execution::par, source.begin(), source.end(), target.begin(),
+		                       1.0 != scale);
+		REQUIRE(r.transform == p.transform);
+		REQUIRE(r.scale == p.scale);
+	}
+
+	// Planar, the smallest singular value is zero
+	std::vector<Vec3d> plane, moved;
+	for (std::size_t i{}; 100 > i; ++i) {
+		double const a = static_cast<double>(i);
+		plane.emplace_back(std::sin(a), std::cos(0.7 * a), 0.0);
+		moved.push_back(expected * plane.back());
+	}
+	requireEqual(expected, umeyama(plane.begin(), plane.end(), moved.begin()).transform);
+
+	REQUIRE_THROWS_AS(umeyama(plane.begin(), plane.begin(), moved.begin()),
+	                  std::invalid_argument);
+}
+
+TEST_CASE("[Trajectory] ATE and RPE")
+{
+	auto const truth = helix(10'000);
+
+	// The same trajectory in another frame
+	Transform3d const frame(angleAxis(0.4, normalize(Vec3d(0.1, 0.2, -1.0))),
+	                        Vec3d(1, 2, 3));
+	std::vector<Transform3d> estimate;
+	for (auto const& pose : truth.poses) {
+		estimate.push_back(frame * pose);
+	}
+
+	auto const a = ate(estimate.begin(), estimate.end(), truth.poses.begin());
+	REQUIRE(truth.size() == a.error.count);
+	REQUIRE(0.0 == Catch::Approx(a.error.max).margin(1e-9));
+	requireEqual(inverse(frame), a.alignment.transform);
+
+	auto const r = rpe(estimate.begin(), estimate.end(), truth.poses.begin(), 10);
+	REQUIRE(truth.size() - 10 == r.translation.count);
+	REQUIRE(0.0 == Catch::Approx(r.translation.max).margin(1e-9));
+	REQUIRE(0.0 == Catch::Approx(r.rotation.max).margin(1e-6));
+
+	// Translations 10 % too long along a line, no rotation
+	std::vector<Transform3d> line, stretched;
+	for (std::size_t i{}; 1000 > i; ++i) {
+		double const x = static_cast<double>(i);
+		line.emplace_back(Mat3d(), Vec3d(x, 0, 0));
+		stretched.emplace_back(Mat3d(), Vec3d(1.1 * x, 0, 0));
+	}
+	auto const s = rpe(execution::par, stretched.begin(), stretched.end(), line.begin());
+	REQUIRE(999 == s.translation.count);
+	REQUIRE(0.1 == Catch::Approx(s.translation.rmse));
+	REQUIRE(0.1 == Catch::Approx(s.translation.mean));
+	REQUIRE(0.0 == Catch::Approx(s.translation.std).margin(1e-6));
+	REQUIRE(0.0 == s.rotation.max);
+
+	// A similarity transform removes the scale error entirely
+	auto const scaled = ate(stretched.begin(), stretched.end(), line.begin(), true);
+	REQUIRE(1.0 / 1.1 == Catch::Approx(scaled.alignment.scale));
+	REQUIRE(0.0 == Catch::Approx(scaled.error.rmse).margin(1e-9));
+
+	auto const p =
+	    ate(execution::par, estimate.begin(), estimate.end(), truth.poses.begin());
+	REQUIRE(a.error.rmse == p.error.rmse);
+
+	REQUIRE_THROWS_AS(rpe(line.begin(), line.end(), line.begin(), 0),
+	                  std::invalid_argument);
+	REQUIRE(0 == rpe(line.begin(), line.begin() + 1, line.begin()).translation.count);
+}
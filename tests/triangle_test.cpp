@@ -0,0 +1,108 @@
+// UFO
+#include <ufo/math/triangle.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace ufo;
+
+TEST_CASE("[Triangle] Properties")
+{
+	Trianglef t(Vec3f(0, 0, 0), Vec3f(2, 0, 0), Vec3f(0, 2, 0));
+	REQUIRE(Vec3f(0, 0, 1) == normal(t));
+	REQUIRE(2.0f == area(t));
+	REQUIRE(AABB3f(Vec3f(0, 0, 0), Vec3f(2, 2, 0)) == bounds(t));
+}
+
+TEST_CASE("[Triangle] Ray intersection")
+{
+	Trianglef t(Vec3f(0, 0, 0), Vec3f(2, 0, 0), Vec3f(0, 2, 0));
+
+	RayHit<float> hit = intersect(Rayf(Vec3f(0.5f, 0.25f, 3), Vec3f(0, 0, -1)), t);
+	REQUIRE(hit);
+	REQUIRE(3.0f == hit.distance);
+	REQUIRE(0.25f == hit.u);
+	REQUIRE(0.125f == hit.v);
+
+	// Back face, miss, behind the origin, and parallel
+	REQUIRE(intersect(Rayf(Vec3f(0.5f, 0.5f, -1), Vec3f(0, 0, 1)), t));
+	REQUIRE_FALSE(intersect(Rayf(Vec3f(1.5f, 1.5f, 1), Vec3f(0, 0, -1)), t));
+	REQUIRE_FALSE(intersect(Rayf(Vec3f(0.5f, 0.5f, 1), Vec3f(0, 0, 1)), t));
+	REQUIRE_FALSE(intersect(Rayf(Vec3f(-1, 0.5f, 0), Vec3f(1, 0, 0)), t));
+	REQUIRE_FALSE(intersect(Rayf(Vec3f(0.5f, 0.25f, 3), Vec3f(0, 0, -1)), t, 0.0f, 2.0f));
+}
+
+TEST_CASE("[Triangle] Packets match scalar")
+{
+	std::mt19937                          gen(9);
+	std::uniform_real_distribution<float> uni(-1.0f, 1.0f);
+
+	auto rand3 = [&]() { return Vec3f(uni(gen), uni(gen), uni(gen)); };
+
+	std::vector<Trianglef> tris;
+	for (std::size_t i{}; 200 > i; ++i) {
+		Vec3f c = rand3() * 5.0f;
+		tris.emplace_back(c + rand3(), c + rand3(), c + rand3());
+	}
+
+	std::vector<Rayf> rays;
+	for (std::size_t i{}; 1'003 > i; ++i) {
+		rays.emplace_back(rand3() * 8.0f, rand3());
+	}
+
+	std::vector<RayHit<float>> expected(rays.size());
+	for (std::size_t r{}; rays.size() > r; ++r) {
+		for (std::size_t i{}; tris.size() > i; ++i) {
+			RayHit<float> h = intersect(rays[r], tris[i]);
+			if (h.distance < expected[r].distance) {
+				expected[r]       = h;
+				expected[r].index = i;
+			}
+		}
+	}
+
+	std::size_t hits{};
+	for (auto const& h : expected) {
+		hits += static_cast<bool>(h);
+	}
+	REQUIRE(0 < hits);
+
+	auto check = [&](std::vector<RayHit<float>> const& res) {
+		for (std::size_t r{}; rays.size() > r; ++r) {
+			REQUIRE(expected[r].index == res[r].index);
+			if (expected[r]) {
+				REQUIRE(expected[r].distance == Catch::Approx(res[r].distance));
+				REQUIRE(expected[r].u == Catch::Approx(res[r].u).margin(1e-5));
+				REQUIRE(expected[r].v == Catch::Approx(res[r].v).margin(1e-5));
+			}
+		}
+	};
+
+	std::vector<RayHit<float>> res(rays.size());
+	intersect(rays.begin(), rays.end(), tris.begin(), tris.end(), res.begin());
+	check(res);
+
+	std::vector<RayHit<float>> pres(rays.size());
+	intersect(execution::par, rays.begin(), rays.end(), tris.begin(), tris.end(),
+	          pres.begin());
+	check(pres);
+
+	// One ray against packets of triangles
+	std::vector<RayHit<float>> tres(rays.size());
+	for (std::size_t r{}; rays.size() > r; ++r) {
+		for (std::size_t i{}; tris.size() > i; i += 16) {
+			TrianglePacket<float, 16> packet;
+			for (std::size_t j{}; 16 > j && tris.size() > i + j; ++j) {
+				packet.set(j, tris[i + j], i + j);
+			}
+			intersect(rays[r], packet, tres[r]);
+		}
+	}
+	check(tres);
+}
@@ -0,0 +1,83 @@
+// UFO
+#include <ufo/execution/execution.hpp>
+#include <ufo/math/vec3.hpp>
+#include <ufo/math/vec_expr.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+std::vector<Vec3f> ramp(std::size_t n, float scale)
+{
+	std::vector<Vec3f> v;
+	for (std::size_t i{}; n > i; ++i) {
+		float const f = scale * static_cast<float>(i);
+		v.emplace_back(f, -f, 2.0f * f);
+	}
+	return v;
+}
+}  // namespace
+
+TEST_CASE("[VecExpr] Element-wise arithmetic")
+{
+	auto const  a = ramp(100, 1.0f);
+	auto const  b = ramp(100, 3.0f);
+	float const t = 0.25f;
+
+	auto const e = lazy(a) + (lazy(b) - lazy(a)) * t;
+	REQUIRE(a.size() == e.size());
+
+	auto const res = evaluate(e);
+	REQUIRE(a.size() == res.size());
+	for (std::size_t i{}; a.size() > i; ++i) {
+		REQUIRE(lerp(a[i], b[i], t) == res[i]);
+	}
+
+	auto const c = evaluate(-(lazy(a) * lazy(b)) / 2.0f + Vec3f(1, 2, 3) - 1.0f);
+	for (std::size_t i{}; a.size() > i; ++i) {
+		REQUIRE(-(a[i] * b[i]) / 2.0f + Vec3f(1, 2, 3) - 1.0f == c[i]);
+	}
+
+	auto const n = evaluate(map(lazy(b), [](Vec3f const& v) { return dot(v, v); }));
+	for (std::size_t i{}; b.size() > i; ++i) {
+		REQUIRE(dot(b[i], b[i]) == n[i]);
+	}
+}
+
+TEST_CASE("[VecExpr] Evaluation in place and with execution policy")
+{
+	auto       a = ramp(1000, 1.0f);
+	auto const b = ramp(1000, 2.0f);
+
+	std::vector<Vec3f> expected(a.size());
+	for (std::size_t i{}; a.size() > i; ++i) {
+		expected[i] = 2.0f * a[i] - b[i];
+	}
+
+	REQUIRE(expected == evaluate(execution::par, 2.0f * lazy(a) - lazy(b)));
+
+	auto const end = evaluate(2.0f * lazy(a) - lazy(b), a.begin());
+	REQUIRE(a.end() == end);
+	REQUIRE(expected == a);
+
+	auto const empty = std::vector<Vec3f>{};
+	REQUIRE(evaluate(execution::par, lazy(empty) + 1.0f).empty());
+
+	// Fewer and more elements than there are blocks of the parallel loop
+	for (std::size_t size : {1, 3, 1001}) {
+		auto const         c = ramp(size, 1.0f);
+		std::vector<Vec3f> d(c.size());
+		for (std::size_t i{}; c.size() > i; ++i) {
+			d[i] = c[i] + 1.0f;
+		}
+		REQUIRE(d == evaluate(execution::par, lazy(c) + 1.0f));
+	}
+}
@@ -0,0 +1,116 @@
+// UFO
+#include <ufo/math/voxel_hash.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace ufo;
+
+namespace
+{
+std::vector<Vec3f> randomPoints(std::size_t n, float extent, unsigned seed)
+{
+	std::mt19937                          gen(seed);
+	std::uniform_real_distribution<float> uni(-extent, extent);
+
+	std::vector<Vec3f> points;
+	for (std::size_t i{}; n > i; ++i) {
+		points.emplace_back(uni(gen), uni(gen), uni(gen));
+	}
+	return points;
+}
+}  // namespace
+
+TEST_CASE("[VoxelHash] Insert and erase")
+{
+	VoxelHash<float> map(0.5f, 4);
+	REQUIRE(map.empty());
+
+	REQUIRE(Vec3i(-1, 0, 2) == map.key(Vec3f(-0.1f, 0.2f, 1.2f)));
+	REQUIRE(Vec3f(-0.25f, 0.25f, 1.25f) == map.center(Vec3i(-1, 0, 2)));
+
+	for (std::size_t i{}; 4 > i; ++i) {
+		REQUIRE(map.insert(Vec3f(0.1f * static_cast<float>(i))));
+	}
+	REQUIRE_FALSE(map.insert(Vec3f(0.05f)));
+	REQUIRE(4 == map.size());
+	REQUIRE(1 == map.numVoxels());
+	REQUIRE(4 == map.count(Vec3i(0)));
+
+	auto              points = randomPoints(20'000, 2.0f, 41);
+	std::size_t const added  = map.insert(points.begin(), points.end());
+	REQUIRE(4 + added == map.size());
+	REQUIRE(points.size() > added);
+
+	std::size_t const voxels = map.numVoxels();
+	REQUIRE(map.erase(Vec3i(0)));
+	REQUIRE_FALSE(map.erase(Vec3i(0)));
+	REQUIRE(0 == map.count(Vec3i(0)));
+	REQUIRE(voxels - 1 == map.numVoxels());
+
+	// Every remaining voxel must still be reachable after the backward shifts
+	std::size_t const removed = map.eraseFar(Vec3f(2, 0, 0), 2.0f);
+	REQUIRE(0 < removed);
+	REQUIRE(voxels - 1 - removed == map.numVoxels());
+	for (auto const& p : points) {
+		Vec3i const k    = map.key(p);
+		bool const  kept = Vec3i(0) != k && 2.0f >= distance(map.center(k), Vec3f(2, 0, 0));
+		REQUIRE(kept == (0 < map.count(k)));
+	}
+	std::size_t total{};
+	for (int x = -4; 4 >= x; ++x) {
+		for (int y = -4; 4 >= y; ++y) {
+			for (int z = -4; 4 >= z; ++z) {
+				total += map.count(Vec3i(x, y, z));
+			}
+		}
+	}
+	REQUIRE(map.size() == total);
+
+	map.clear();
+	REQUIRE(map.empty());
+	REQUIRE(0 == map.numVoxels());
+	REQUIRE(map.insert(Vec3f(1.0f)));
+}
+
+TEST_CASE("[VoxelHash] Nearest")
+{
+	auto points  = randomPoints(50'000, 10.0f, 42);
+	auto queries = randomPoints(1'000, 10.0f, 43);
+
+	VoxelHash<float> map(1.0f, 1'000);
+	REQUIRE(points.size() == map.insert(points.begin(), points.end()));
+
+	std::vector<std::pair<Vec3f, float>> batch(queries.size());
+	nearest(map, queries.begin(), queries.end(), batch.begin());
+	std::vector<std::pair<Vec3f, float>> par(queries.size());
+	nearest(execution::par, map, queries.begin(), queries.end(), par.begin());
+
+	for (std::size_t q{}; queries.size() > q; ++q) {
+		float best = std::numeric_limits<float>::infinity();
+		for (auto const& p : points) {
+			best = std::min(best, distanceSquared(p, queries[q]));
+		}
+
+		// Exact whenever the closest point is within one voxel
+		auto [point, d] = map.nearest(queries[q]);
+		REQUIRE(best == d);
+		REQUIRE(d == distanceSquared(point, queries[q]));
+		REQUIRE(d == batch[q].second);
+		REQUIRE(d == par[q].second);
+
+		REQUIRE(d <= map.nearest(queries[q], VoxelStencil::FACES).second);
+		REQUIRE(map.nearest(queries[q], VoxelStencil::FACES).second <=
+		        map.nearest(queries[q], VoxelStencil::VOXEL).second);
+	}
+
+	REQUIRE(std::numeric_limits<float>::infinity() ==
+	        map.nearest(Vec3f(100.0f), VoxelStencil::CUBE).second);
+}